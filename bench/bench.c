@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/jit.h>
+#include <cpu/opcodes.h>
+#include <cpu/profile.h>
+#include <cpu/io.h>
+#include <cpu/flags.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define bench_cycles() __rdtsc()
+#define BENCH_HAVE_CYCLES 1
+#else
+#define bench_cycles() 0
+#define BENCH_HAVE_CYCLES 0
+#endif
+
+#include "bench.h"
+
+#define BENCH_DEFAULT_STEPS 5000000
+#define BENCH_MEMORY (640 * 1024)
+
+// With chaining working a JIT build re-enters translated code only a handful of times per run,
+// without it once per loop pass, a few tens of instructions
+#define BENCH_JIT_PASSES 1000
+
+// Stands in for a status port the guest keeps polling
+static uint8_t bench_port_read(void *ctx, uint16_t port) {
+    return 0x20;
+}
+
+static const struct io_device bench_port = {.read = bench_port_read};
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static size_t bench_assemble(const struct bench_workload *workload, uint8_t *out) {
+    size_t length = workload->length;
+    memcpy(out, workload->code, length);
+
+    // dec cx; jnz body; cmp ax, ax; jz body
+    out[length] = 0x49;
+    out[length + 1] = 0x75;
+    out[length + 2] = (uint8_t) -(int) (length + 3);
+    out[length + 3] = 0x39;
+    out[length + 4] = 0xc0;
+    out[length + 5] = 0x74;
+    out[length + 6] = (uint8_t) -(int) (length + BENCH_LOOP_LENGTH);
+    return length + BENCH_LOOP_LENGTH;
+}
+
+static void bench_setup(struct cpu *cpu, const uint8_t *code, size_t length) {
+    memset(&cpu->reg, 0, sizeof(cpu->reg));
+    memset(&cpu->lazy, 0, sizeof(cpu->lazy));
+    cpu->state = 0;
+    block_cache_flush(cpu);
+
+    memory_load(cpu, 0, code, length);
+
+    cpu->reg.ax = 0x1234;
+    cpu->reg.bx = 0x2000;
+    cpu->reg.dx = 0x0001;
+    cpu->reg.si = 0x2010;
+    cpu->reg.di = 0x2020;
+    cpu->reg.bp = 0x2100;
+    cpu->reg.ds = 0x4000;
+    cpu->reg.es = 0x4000;
+    cpu->reg.ss = 0x3000;
+    cpu->reg.sp = 0xfffe;
+}
+
+// Runs steps budget units of the workload after a warm-up, returns the seconds taken or a negative value on a fault
+static double bench_time(struct cpu *cpu, const uint8_t *code, size_t length, uint64_t steps, uint64_t *host_cycles) {
+    bench_setup(cpu, code, length);
+    if (cpu_run(cpu, steps / 10)) return -1;
+    cpu->reg.ip = 0;
+    cpu->reg.ip32 = 0;
+
+    uint64_t cycles = bench_cycles();
+    double start = bench_now();
+    int halted = cpu_run(cpu, steps);
+    double seconds = bench_now() - start;
+    *host_cycles = bench_cycles() - cycles;
+
+    return halted ? -1 : seconds;
+}
+
+#ifdef CPU_JIT
+/*
+    Translated code has to leave the guest exactly where the interpreter does, and since every
+    workload loop always takes a back edge it has to stay inside chained translations rather
+    than coming back out to the run loop once per pass. Returns what went wrong, or NULL.
+ */
+static const char *bench_check_jit(struct cpu *cpu, struct cpu *reference, const uint8_t *code, size_t length, uint64_t steps) {
+    // Earlier runs leave their stores behind, both sides start from the same blank memory
+    memset(cpu->memory.backing, 0, BENCH_MEMORY);
+    memset(reference->memory.backing, 0, BENCH_MEMORY);
+    bench_setup(cpu, code, length);
+    bench_setup(reference, code, length);
+    cpu->jit->entries = 0;
+    cpu->cycles = reference->cycles = 0;
+    cpu_run(cpu, steps);
+    cpu_run(reference, steps);
+
+    if (memcmp(cpu->reg.gpr, reference->reg.gpr, sizeof(cpu->reg.gpr)) || memcmp(cpu->reg.sreg, reference->reg.sreg, sizeof(cpu->reg.sreg)) ||
+        cpu->reg.ip32 != reference->reg.ip32 || flags_get(cpu) != flags_get(reference) || cpu->cycles != reference->cycles ||
+        memcmp(cpu->memory.backing, reference->memory.backing, BENCH_MEMORY))
+        return "jit_mismatch";
+    if (cpu->jit->entries > steps / BENCH_JIT_PASSES) return "jit_unchained";
+    return NULL;
+}
+#endif
+
+// One JSON object per line so results can be appended to a log and diffed across runs.
+// The fast-forward pass gives exact instruction counts, the timed pass how many 8086 clocks
+// we get through per second of host time.
+static void bench_run(struct cpu *cpu, struct cpu *reference, const struct bench_workload *workload, uint64_t steps) {
+    uint8_t code[BENCH_MAX_BODY + BENCH_LOOP_LENGTH];
+    uint64_t cycles, guest_cycles;
+
+    if (workload->length > BENCH_MAX_BODY) {
+        printf("{\"name\":\"%s\",\"family\":\"%s\",\"status\":\"too_long\",\"length\":%zu}\n",
+               workload->name, workload->family, workload->length);
+        return;
+    }
+    size_t length = bench_assemble(workload, code);
+
+    cpu_set_timing(cpu, CPU_TIMING_FAST);
+    double seconds = bench_time(cpu, code, length, steps, &cycles);
+
+    // Anything that stops before the budget hit an unimplemented opcode
+    if (seconds < 0) {
+        printf("{\"name\":\"%s\",\"family\":\"%s\",\"status\":\"fault\",\"ip\":%u}\n",
+               workload->name, workload->family, cpu->reg.ip);
+        return;
+    }
+
+#ifdef CPU_JIT
+    const char *failed = bench_check_jit(cpu, reference, code, length, steps);
+    if (failed) {
+        printf("{\"name\":\"%s\",\"family\":\"%s\",\"status\":\"%s\",\"ip\":%u}\n",
+               workload->name, workload->family, failed, cpu->reg.ip);
+        return;
+    }
+#endif
+
+    cpu_set_timing(cpu, CPU_TIMING_ACCURATE);
+    double timed = bench_time(cpu, code, length, steps, &guest_cycles);
+
+    printf("{\"name\":\"%s\",\"family\":\"%s\",\"status\":\"ok\",\"instructions\":%llu,\"seconds\":%.6f,"
+           "\"ips\":%.0f,\"ns_per_insn\":%.3f,\"cycles_per_insn\":",
+           workload->name, workload->family, (unsigned long long) steps, seconds, steps / seconds, seconds * 1e9 / steps);
+    if (BENCH_HAVE_CYCLES) printf("%.2f", (double) cycles / steps);
+    else printf("null");
+    printf(",\"guest_mhz\":%.2f}\n", steps / timed / 1e6);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    uint64_t steps = argc > 1 ? strtoull(argv[1], NULL, 0) : BENCH_DEFAULT_STEPS;
+    const char *only = argc > 2 ? argv[2] : NULL;
+
+    // The reference CPU never translates anything, a JIT build checks its results against it
+    static struct cpu cpu, reference;
+    struct cpu *cpus[] = {&cpu, &reference};
+    for (size_t i = 0; i < 2; i++) {
+        if (memory_create(cpus[i]) < 0 || block_cache_create(cpus[i]) < 0 || io_create(cpus[i]) < 0) {
+            fprintf(stderr, "[!] Can't set up the bench CPU\n");
+            return 1;
+        }
+        memory_map_ram(cpus[i], 0, BENCH_MEMORY);
+        io_attach(cpus[i], 0x60, 1, &bench_port);
+        cpu_set_timing(cpus[i], CPU_TIMING_FAST);
+    }
+#ifdef CPU_JIT
+    if (jit_create(&cpu) < 0) {
+        fprintf(stderr, "[!] Can't set up the JIT\n");
+        return 1;
+    }
+#endif
+#ifdef CPU_PROFILE
+    // Counting stays on so make PROFILE=1 bench shows what it costs
+    profile_create(&cpu);
+#endif
+
+    for (size_t i = 0; i < bench_workload_count; i++) {
+        if (only && strcmp(only, bench_workloads[i].name) && strcmp(only, bench_workloads[i].family)) continue;
+        bench_run(&cpu, &reference, &bench_workloads[i], steps);
+    }
+
+#ifdef CPU_PROFILE
+    profile_destroy(&cpu);
+#endif
+#ifdef CPU_JIT
+    jit_destroy(&cpu);
+#endif
+    for (size_t i = 0; i < 2; i++) {
+        io_destroy(cpus[i]);
+        block_cache_destroy(cpus[i]);
+        memory_destroy(cpus[i]);
+    }
+    return 0;
+}
\ No newline at end of file
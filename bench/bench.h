@@ -0,0 +1,34 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+    A workload is a loop body. The harness wraps it as
+
+        body:   <code>
+                dec cx
+                jnz body
+                cmp ax, ax
+                jz body
+
+    so it runs forever and every run executes exactly the requested number of
+    instructions. Bodies must leave CX alone and fit in BENCH_MAX_BODY bytes, the
+    closing JZ reaches back at most 128.
+ */
+#define BENCH_MAX_BODY 121
+// What bench_assemble puts after the body
+#define BENCH_LOOP_LENGTH 7
+
+struct bench_workload {
+    const char *name;
+    const char *family;
+    const char *code;
+    size_t length;
+};
+
+extern const struct bench_workload bench_workloads[];
+extern const size_t bench_workload_count;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#define BENCH_CODE(s) s, sizeof(s) - 1
+
+/*
+    Registers on entry: AX=1234 BX=2000 DX=0001 SI=2010 DI=2020 BP=2100, SS:SP=3000:FFFE, DS=ES=4000.
+    Memory operands land on their own page above the code.
+ */
+const struct bench_workload bench_workloads[] = {
+        /*
+            add ax, bx
+            sub dx, ax
+            xor si, dx
+            and di, si
+            or bp, ax
+            adc ax, dx
+            sbb bx, si
+            cmp ax, bx
+        */
+        {"alu_loop", "workload", BENCH_CODE("\x01\xd8\x29\xc2\x31\xd6\x21\xf7\x09\xc5\x11\xd0\x19\xf3\x39\xd8")},
+        /*
+            push ax
+            push bx
+            push dx
+            push si
+            pop si
+            pop dx
+            pop bx
+            pop ax
+        */
+        {"stack_loop", "workload", BENCH_CODE("\x50\x53\x52\x56\x5e\x5a\x5b\x58")},
+        /*
+            add [bx+si], ax
+            add ax, [bx+di]
+            xor [bx+si], dx
+            sub dx, [bx+di]
+            and [si], bp
+            or ax, [di]
+            cmp [bx], ax
+            adc [bp+si], ax
+        */
+        {"modrm_mix", "workload", BENCH_CODE("\x01\x00\x03\x01\x31\x10\x2b\x11\x21\x2c\x0b\x05\x39\x07\x11\x02")},
+        /*
+            movsb
+            movsw
+            stosb
+            stosw
+            lodsb
+            lodsw
+        */
+        {"string_moves", "workload", BENCH_CODE("\xa4\xa5\xaa\xab\xac\xad")},
+        /*
+            cmp ax, bx
+            jz $+4
+            inc ax
+            inc bx
+            jb $+3
+            inc dx
+            jg $+3
+            inc si
+            jnz $+2
+            js $+3
+            inc di
+        */
+        {"branchy", "workload", BENCH_CODE("\x39\xd8\x74\x02\x40\x43\x72\x01\x42\x7f\x01\x46\x75\x00\x78\x01\x47")},
+
+        // add ax, bx x8
+        {"alu_reg", "micro", BENCH_CODE("\x01\xd8\x01\xd8\x01\xd8\x01\xd8\x01\xd8\x01\xd8\x01\xd8\x01\xd8")},
+        // add [bx+si], ax x8
+        {"alu_mem", "micro", BENCH_CODE("\x01\x00\x01\x00\x01\x00\x01\x00\x01\x00\x01\x00\x01\x00\x01\x00")},
+        // inc ax / dec dx x4
+        {"incdec", "micro", BENCH_CODE("\x40\x4a\x40\x4a\x40\x4a\x40\x4a")},
+        // push ax / pop dx x4
+        {"pushpop", "micro", BENCH_CODE("\x50\x5a\x50\x5a\x50\x5a\x50\x5a")},
+        // jo $+2 x8, never taken
+        {"jcc", "micro", BENCH_CODE("\x70\x00\x70\x00\x70\x00\x70\x00\x70\x00\x70\x00\x70\x00\x70\x00")},
+        // pushf / popf / lahf / sahf x2
+        {"flags", "micro", BENCH_CODE("\x9c\x9d\x9f\x9e\x9c\x9d\x9f\x9e")},
+        // lodsb x8
+        {"lods", "micro", BENCH_CODE("\xac\xac\xac\xac\xac\xac\xac\xac")},
+        // in al, 0x60 / out 0x80, al x4, one mapped port and one that nothing answers
+        {"port_io", "micro", BENCH_CODE("\xe4\x60\xe6\x80\xe4\x60\xe6\x80\xe4\x60\xe6\x80\xe4\x60\xe6\x80")},
+};
+
+const size_t bench_workload_count = sizeof(bench_workloads) / sizeof(bench_workloads[0]);
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include <cpu/cpu.h>
+#include <cpu/block.h>
+#include <cpu/memory.h>
+#include <cpu/opcodes.h>
+#include <cpu/jit.h>
+#include <cpu/trace.h>
+#include <cpu/profile.h>
+#include <cpu/debug.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int block_cache_create(struct cpu *cpu) {
+    cpu->blocks = calloc(1, sizeof(struct block_cache));
+    return cpu->blocks ? 0 : -1;
+}
+
+void block_cache_destroy(struct cpu *cpu) {
+    free(cpu->blocks);
+    cpu->blocks = NULL;
+}
+
+// Pages holding cached code lose their RAM write fast path so stores into them reach block_notify_write
+static inline void block_account_pages(struct cpu *cpu, struct block *block, int delta) {
+    struct block_cache *cache = cpu->blocks;
+    for (uint32_t page = block->addr >> MEMORY_PAGE_SHIFT; page <= (block->end - 1) >> MEMORY_PAGE_SHIFT; page++) {
+        uint32_t index = page % MEMORY_PAGES;
+        if (delta > 0 && cache->code_pages[index]++ == 0) memory_set_trap(cpu, index, MEMORY_TRAP_CODE);
+        if (delta < 0 && --cache->code_pages[index] == 0) {
+            memset(cache->code_bytes + (index << MEMORY_PAGE_SHIFT) / 8, 0, MEMORY_PAGE_SIZE / 8);
+            memory_clear_trap(cpu, index, MEMORY_TRAP_CODE);
+        }
+    }
+}
+
+static inline void block_mark_bytes(struct block_cache *cache, struct block *block) {
+    for (uint32_t addr = block->addr; addr != block->end; addr++) {
+        uint32_t byte = addr & MEMORY_MASK;
+        cache->code_bytes[byte / 8] |= 1 << (byte % 8);
+    }
+    if (block->end - block->addr > cache->longest) cache->longest = block->end - block->addr;
+}
+
+static inline size_t block_slot(uint32_t addr) {
+    return (addr ^ (addr >> 10)) % BLOCK_CACHE_SIZE;
+}
+
+static inline int block_overlaps(const struct block *block, uint32_t addr, uint32_t size) {
+    return ((addr - block->addr) & MEMORY_MASK) < block->end - block->addr ||
+           ((block->addr - addr) & MEMORY_MASK) < size;
+}
+
+static void block_drop(struct cpu *cpu, struct block *block) {
+    block_account_pages(cpu, block, -1);
+    block->valid = 0;
+#ifdef CPU_JIT
+    jit_drop(cpu, block);
+#endif
+}
+
+/*
+    Throws out the cached blocks that overlap [addr, addr + size). Stores that miss every byte
+    a block was decoded from, such as a variable kept next to the loop using it, cost a bitmap
+    lookup. A block reaching a written byte has to start at most the longest block before it,
+    and the cache is indexed by start address, so only those slots get looked at.
+ */
+void block_invalidate(struct cpu *cpu, uint32_t addr, uint32_t size) {
+    struct block_cache *cache = cpu->blocks;
+    uint32_t i;
+
+    for (i = 0; i < size; i++) {
+        uint32_t byte = (addr + i) & MEMORY_MASK;
+        if (cache->code_bytes[byte / 8] & (1 << (byte % 8))) break;
+    }
+    if (i == size) return;
+
+    uint32_t first = addr - cache->longest + 1, span = size + cache->longest - 1;
+    if (span > BLOCK_CACHE_SIZE) {
+        for (i = 0; i < BLOCK_CACHE_SIZE; i++) {
+            struct block *block = &cache->blocks[i];
+            if (block->valid && block_overlaps(block, addr, size)) block_drop(cpu, block);
+        }
+        return;
+    }
+
+    for (i = 0; i < span; i++) {
+        uint32_t start = (first + i) & MEMORY_MASK;
+        struct block *block = &cache->blocks[block_slot(start)];
+        if (block->valid && block_overlaps(block, addr, size)) block_drop(cpu, block);
+    }
+}
+
+// Forgets every cached block, for when guest memory is replaced behind the CPU's back
+void block_cache_flush(struct cpu *cpu) {
+    struct block_cache *cache = cpu->blocks;
+    if (!cache) return;
+
+#ifdef CPU_JIT
+    jit_flush(cpu);
+#endif
+    for (size_t i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        if (cache->blocks[i].valid) block_account_pages(cpu, &cache->blocks[i], -1);
+        cache->blocks[i].valid = 0;
+    }
+    cache->longest = 0;
+}
+
+// Instructions a polling loop may be made of: they read and set flags, and nothing else.
+// A segment prefix counts as the instruction it runs, so CMP ES:[46Ch], AX still qualifies.
+static inline int block_idle_opcode(const struct block_uop *uop) {
+    switch (opcode_is_segment_prefix(uop->opcode) ? uop->op[0] : uop->opcode) {
+        case 0x38: case 0x39: case 0x3a: case 0x3b: case 0x3c: case 0x3d:
+        case 0x84: case 0x85: case 0xa8: case 0xa9:
+        case 0x90:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int block_is_idle(struct block *block) {
+    const struct block_uop *last = &block->uops[block->count - 1];
+    if (!last->function || !((last->opcode >= 0x70 && last->opcode <= 0x7f) || last->opcode == 0xeb)) return 0;
+    if (block->end + (int8_t) last->op[0] != block->addr) return 0;
+
+    for (uint8_t i = 0; i + 1 < block->count; i++) {
+        if (!block->uops[i].function || !block_idle_opcode(&block->uops[i])) return 0;
+    }
+    return 1;
+}
+
+static void block_decode(struct cpu *cpu, struct block *block, uint32_t addr) {
+    if (block->valid) block_account_pages(cpu, block, -1);
+#ifdef CPU_JIT
+    jit_drop(cpu, block);
+    block->hits = 0;
+#endif
+
+    block->addr = addr;
+    block->count = 0;
+    block->cost = 0;
+    block->breakpoint = debug_has_breakpoint(cpu, addr);
+
+    while (block->count < BLOCK_MAX_UOPS) {
+        // A breakpoint further on starts a block of its own, where the run loop checks it
+        if (block->count && debug_has_breakpoint(cpu, addr)) break;
+
+        uint8_t opcode_byte = memory_fetch_byte(cpu, addr);
+        const struct opcode *opcode = &opcodes[opcode_byte];
+        struct block_uop *uop = &block->uops[block->count++];
+
+        uop->function = opcode->function;
+        uop->opcode = opcode_byte;
+        uop->length = opcode_length(cpu, addr);
+        uop->op[0] = opcode->operand_length > 0 ? memory_fetch_byte(cpu, addr + 1) : 0;
+        uop->op[1] = opcode->operand_length > 1 ? memory_fetch_byte(cpu, addr + 2) : 0;
+
+        // Costs are summed up front so a block that runs to the end is charged with a single add
+        if (cpu->timing == CPU_TIMING_FAST) {
+            uop->cost = 1;
+            uop->taken = 0;
+        } else {
+            uop->cost = opcode_cycles(opcode_byte, uop->op[0]);
+            uop->taken = opcode_taken_cycles(opcode_byte);
+            if (!uop->cost) uop->cost = 1;
+        }
+        block->cost += uop->cost;
+        uop->total = block->cost;
+
+        // Anything that looks at or moves IP (branches, ModR/M displacements, immediates past op1) needs it written back first
+        // A segment prefix is a branch when the instruction it runs is one
+        size_t plain_length = opcode->operand_length ? opcode->operand_length : 1;
+        uint8_t flags = opcode_flags(cpu, addr);
+        if (!opcode->function || (flags & (OPCODE_BRANCH | OPCODE_IP)) || uop->length != plain_length)
+            uop->kind = BLOCK_UOP_SYNC;
+        else
+            uop->kind = BLOCK_UOP_PLAIN;
+
+        addr += uop->length;
+        if (!opcode->function || (flags & OPCODE_BRANCH)) break;
+    }
+
+    block->uops[block->count].kind = BLOCK_UOP_END;
+    block->end = addr;
+    block->idle = block_is_idle(block);
+    block->valid = 1;
+    block_account_pages(cpu, block, 1);
+    block_mark_bytes(cpu->blocks, block);
+}
+
+static inline struct block *block_lookup(struct cpu *cpu, uint32_t addr) {
+    struct block *block = &cpu->blocks->blocks[block_slot(addr)];
+    if (!block->valid || block->addr != addr) block_decode(cpu, block, addr);
+    return block;
+}
+
+// Memory the loop compares against has to be RAM, an MMIO register could change on its own
+static int block_idle_inputs(struct cpu *cpu, struct block *block) {
+    uint16_t ip = cpu->reg.ip;
+    uint8_t override = cpu->segment_override;
+    int ram = 1;
+
+    for (uint16_t at = ip, i = 0; i + 1 < block->count && ram; at += block->uops[i++].length) {
+        const struct block_uop *uop = &block->uops[i];
+        uint8_t opcode_byte = uop->opcode, modrm = uop->op[0];
+
+        // The prefixed instruction's operand is decoded from one byte further on, with the override in place
+        cpu->reg.ip = at;
+        if (opcode_is_segment_prefix(opcode_byte)) {
+            cpu->segment_override = ((opcode_byte >> 3) & 3) + 1;
+            cpu->reg.ip++;
+            opcode_byte = uop->op[0];
+            modrm = uop->op[1];
+        }
+        if ((opcodes[opcode_byte].flags & OPCODE_MODRM) && modrm_table[modrm].memory) {
+            struct modrm_operand operand = modrm_decode(cpu, modrm);
+            ram = cpu->memory.type[operand.addr >> MEMORY_PAGE_SHIFT] == MEMORY_RAM &&
+                  cpu->memory.type[((operand.addr + 1) & MEMORY_MASK) >> MEMORY_PAGE_SHIFT] == MEMORY_RAM;
+        }
+        cpu->segment_override = override;
+    }
+
+    cpu->reg.ip = ip;
+    return ram;
+}
+
+// An idle block that just went around once more will keep doing so until the next event fires
+static inline void block_idle(struct cpu *cpu, struct block *block, uint64_t end) {
+    if (!(cpu->idle & CPU_IDLE_SKIP) || cpu->reg.ip32 != block->addr || cpu->cycles >= end) return;
+    if (block_idle_inputs(cpu, block)) cpu_idle(cpu, end);
+}
+
+// Runs blocks out of the cache until cpu->cycles moves on by cycles, returns how far it got
+uint64_t block_run(struct cpu *cpu, uint64_t cycles) {
+    uint64_t start = cpu->cycles, end = start + cycles;
+
+    while (cpu->cycles < end && !(cpu->state & CPU_STOP)) {
+        if (debug_break(cpu)) break;
+        struct block *block = block_lookup(cpu, cpu->reg.ip32);
+        uint32_t next = block->addr;
+        profile_block(cpu);
+
+#ifdef CPU_JIT
+        // Translated code doesn't feed the profiler, so profiling runs everything through the uops.
+        // Chained translations never come back through here, so one on a breakpoint isn't made.
+        if (cpu->jit && !cpu->profile && !block->idle && !block->breakpoint && jit_run_block(cpu, block, end - cpu->cycles)) continue;
+#endif
+
+        for (uint8_t i = 0; i < block->count && cpu->cycles < end; i++) {
+            const struct block_uop *uop = &block->uops[i];
+
+            // A taken branch or a write into this block leaves us somewhere else
+            if (cpu->reg.ip32 != next || !block->valid) break;
+            next += uop->length;
+
+            opcode_call(cpu, uop->opcode, uop->op[0], uop->op[1]);
+            cpu->cycles += uop->cost;
+            if (cpu->reg.ip32 != next) cpu->cycles += uop->taken;
+
+            if (cpu->state & CPU_STOP) break;
+        }
+
+        if (block->idle) block_idle(cpu, block, end);
+    }
+    return cpu->cycles - start;
+}
+
+#ifdef CPU_THREADED
+// Same contract as block_run, but threads through the uops with computed gotos, keeps IP
+// and the CS base in locals until something needs to see them and charges cycles per block
+uint64_t block_run_threaded(struct cpu *cpu, uint64_t cycles) {
+    static void *const dispatch[] = {
+        [BLOCK_UOP_PLAIN] = &&uop_plain,
+        [BLOCK_UOP_SYNC] = &&uop_sync,
+        [BLOCK_UOP_END] = &&uop_end,
+    };
+    uint64_t start = cpu->cycles, end = start + cycles;
+
+    while (cpu->cycles < end && !(cpu->state & CPU_STOP)) {
+        struct block *block = block_lookup(cpu, cpu->reg.ip32);
+
+        // Not enough budget left for a whole block, let the checked loop finish it
+        if (block->cost > end - cpu->cycles) {
+            block_run(cpu, end - cpu->cycles);
+            break;
+        }
+        if (debug_break(cpu)) break;
+
+        profile_block(cpu);
+        const struct block_uop *uop = block->uops;
+        uint16_t ip = cpu->reg.ip;
+        uint32_t base = cpu->reg.cs * 16;
+
+        goto *dispatch[uop->kind];
+
+    uop_plain:
+        trace_instruction(cpu, ip, uop->opcode);
+        profile_instruction(cpu, uop->opcode, uop->op[0]);
+        uop->function(cpu, uop->op[0], uop->op[1]);
+        ip += uop->length;
+        uop++;
+        // A watchpoint stops the CPU right after the instruction that hit it, as does POP SS
+        if (!block->valid || (cpu->state & (CPU_BREAK | CPU_SHADOW))) goto uop_end;
+        goto *dispatch[uop->kind];
+
+    uop_sync:
+        cpu->reg.ip = ip;
+        cpu->reg.ip32 = (base + ip) & MEMORY_MASK;
+        opcode_call(cpu, uop->opcode, uop->op[0], uop->op[1]);
+        ip += uop->length;
+        uop++;
+        if (cpu->reg.ip32 != ((base + ip) & MEMORY_MASK)) {
+            cpu->cycles += uop[-1].total + uop[-1].taken;
+            if (block->idle) block_idle(cpu, block, end);
+            continue;
+        }
+        if (!block->valid || (cpu->state & CPU_STOP)) {
+            cpu->cycles += uop[-1].total;
+            continue;
+        }
+        goto *dispatch[uop->kind];
+
+    uop_end:
+        cpu->reg.ip = ip;
+        cpu->reg.ip32 = (base + ip) & MEMORY_MASK;
+        cpu->cycles += uop[-1].total;
+    }
+    return cpu->cycles - start;
+}
+#endif
\ No newline at end of file
@@ -1,10 +1,112 @@
 #include <cpu/cpu.h>
+#include <cpu/block.h>
 #include <cpu/opcodes.h>
+#include <cpu/trace.h>
+#include <cpu/io.h>
+#include <cpu/memory.h>
+#include <cpu/flags.h>
+#include <cpu/sched.h>
+#include <cpu/debug.h>
 
-int cpu_run(struct cpu *cpu, size_t steps) {
-    for (size_t step = 0; step < steps; step++) {
-        if (cpu->state & CPU_HALTED) return 1;
+#include <sched.h>
+
+// 8086 clocks from INTR being sampled to the first instruction of the handler
+#define CPU_INTR_CYCLES 61
+
+// Straight-line stretch with no event due, stops early when something sets CPU_YIELD
+static void cpu_execute(struct cpu *cpu, uint64_t cycles) {
+    cpu->deadline = cpu->cycles + cycles;
+    if (cpu->blocks) {
+#if defined(CPU_THREADED) && !defined(CPU_JIT)
+        block_run_threaded(cpu, cycles);
+#else
+        block_run(cpu, cycles);
+#endif
+    } else {
+        uint64_t end = cpu->cycles + cycles;
+        while (cpu->cycles < end && !(cpu->state & CPU_STOP) && !debug_break(cpu))
+            opcode_execute(cpu);
+    }
+
+    // Every runner stops on the instruction that casts a shadow, the one it covers runs here
+    while ((cpu->state & CPU_SHADOW) && !(cpu->state & (CPU_HALTED | CPU_BREAK)) && !debug_break(cpu))
         opcode_execute(cpu);
+}
+
+/*
+    Runs until cpu->cycles has advanced by at least cycles (instructions when fast-forwarding),
+    the CPU halts or a breakpoint or watchpoint stops it with CPU_BREAK. Code runs unchecked up
+    to the next scheduler deadline, so devices cost nothing between their events and pending
+    interrupts are only looked at once one fired or an instruction raised CPU_YIELD. A CPU
+    waiting in HLT skips straight to the next event.
+ */
+int cpu_run(struct cpu *cpu, uint64_t cycles) {
+    uint64_t end = cpu->cycles + cycles;
+    cpu->state &= ~CPU_BREAK;
+
+    while (cpu->cycles < end && !(cpu->state & CPU_HALTED)) {
+        uint64_t stop = sched_next(cpu);
+        if (stop > end) stop = end;
+
+        cpu->state &= ~CPU_YIELD;
+        if (cpu->state & CPU_WAITING) cpu_idle(cpu, stop);
+        else if (stop > cpu->cycles) cpu_execute(cpu, stop - cpu->cycles);
+        if (cpu->state & CPU_BREAK) break;
+
+        if (cpu->sched) sched_dispatch(cpu);
+        if (cpu->intr && (cpu->reg.flags & CPU_FLAGS_INTERRUPTS) && cpu->intc.acknowledge) {
+            cpu->state &= ~CPU_WAITING;
+            uint8_t vector = cpu->intc.acknowledge(cpu->intc.ctx);
+            if (!cpu_hle(cpu, vector)) cpu_interrupt(cpu, vector);
+            if (cpu->timing == CPU_TIMING_ACCURATE) cpu->cycles += CPU_INTR_CYCLES;
+        }
+    }
+    cpu->state &= ~CPU_YIELD;
+
+    // Whoever called us gets to see every write the guest made
+    if (cpu->io) io_flush(cpu);
+
+    if (cpu->state & CPU_HALTED) {
+        trace_halt(cpu);
+        return 1;
     }
     return 0;
+}
+
+// Cached blocks and translations carry costs for one mode, so they have to go
+void cpu_set_timing(struct cpu *cpu, uint8_t timing) {
+    if (cpu->timing == timing) return;
+    cpu->timing = timing;
+    block_cache_flush(cpu);
+}
+
+// Pushes FLAGS, CS and IP and enters the handler from the vector table with IF and TF clear
+void cpu_interrupt(struct cpu *cpu, uint8_t vector) {
+    uint16_t flags = flags_get(cpu);
+
+    cpu->reg.sp -= 2;
+    memory_write_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp, flags);
+    cpu->reg.sp -= 2;
+    memory_write_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp, cpu->reg.cs);
+    cpu->reg.sp -= 2;
+    memory_write_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp, cpu->reg.ip);
+
+    flags_set(cpu, flags & ~(CPU_FLAGS_INTERRUPTS | CPU_FLAGS_DEBUG_BREAK));
+    cpu->reg.ip = memory_read_word(cpu, vector * 4);
+    cpu->reg.cs = memory_read_word(cpu, vector * 4 + 2);
+    cpu->reg.ip32 = (cpu->reg.cs * 16 + cpu->reg.ip) & MEMORY_MASK;
+}
+
+// Called by the interrupt controller, kicks the run loop out of its current stretch if it can take it now
+void cpu_set_intr(struct cpu *cpu, uint8_t level) {
+    cpu->intr = level;
+    if (level && (cpu->reg.flags & CPU_FLAGS_INTERRUPTS)) cpu->state |= CPU_YIELD;
+}
+
+// Nothing the guest does can matter before until, so the clock jumps there instead of spinning
+void cpu_idle(struct cpu *cpu, uint64_t until) {
+    if (until <= cpu->cycles) return;
+    cpu->idle_cycles += until - cpu->cycles;
+    cpu->cycles = until;
+    if (cpu->idle & CPU_IDLE_YIELD) sched_yield();
 }
\ No newline at end of file
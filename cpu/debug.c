@@ -0,0 +1,177 @@
+#include <cpu/debug.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+
+#include <stdlib.h>
+
+int debug_create(struct cpu *cpu) {
+    cpu->debug = calloc(1, sizeof(struct debug));
+    if (!cpu->debug) return -1;
+    cpu->debug->resume = DEBUG_NO_RESUME;
+    return 0;
+}
+
+void debug_destroy(struct cpu *cpu) {
+    if (!cpu->debug) return;
+    cpu->debug->breakpoint_count = 0;
+    cpu->debug->watchpoint_count = 0;
+    for (uint32_t page = 0; page < MEMORY_PAGES; page++)
+        memory_clear_trap(cpu, page, MEMORY_TRAP_BREAK | MEMORY_TRAP_WATCH_READ | MEMORY_TRAP_WATCH_WRITE);
+    free(cpu->debug);
+    cpu->debug = NULL;
+}
+
+// Works out a page's bits again from whatever is still set, several points can share one page
+static void debug_rearm_page(struct cpu *cpu, uint32_t page) {
+    struct debug *debug = cpu->debug;
+    uint8_t traps = 0;
+
+    for (size_t i = 0; i < debug->breakpoint_count; i++)
+        if (debug->breakpoints[i].addr >> MEMORY_PAGE_SHIFT == page) traps |= MEMORY_TRAP_BREAK;
+
+    for (size_t i = 0; i < debug->watchpoint_count; i++) {
+        const struct debug_watchpoint *watchpoint = &debug->watchpoints[i];
+        uint32_t first = watchpoint->addr >> MEMORY_PAGE_SHIFT;
+        uint32_t last = (watchpoint->addr + watchpoint->size - 1) >> MEMORY_PAGE_SHIFT;
+        if (page < first || page > last) continue;
+        if (watchpoint->access & DEBUG_WATCH_READ) traps |= MEMORY_TRAP_WATCH_READ;
+        if (watchpoint->access & DEBUG_WATCH_WRITE) traps |= MEMORY_TRAP_WATCH_WRITE;
+    }
+
+    uint8_t all = MEMORY_TRAP_BREAK | MEMORY_TRAP_WATCH_READ | MEMORY_TRAP_WATCH_WRITE;
+    if ((cpu->memory.traps[page] & all) == traps) return;
+    memory_clear_trap(cpu, page, all & ~traps);
+    if (traps) memory_set_trap(cpu, page, traps);
+}
+
+static int debug_insert_breakpoint(struct cpu *cpu, const struct debug_breakpoint *breakpoint) {
+    struct debug *debug = cpu->debug;
+    if (!debug || debug->breakpoint_count == DEBUG_MAX_BREAKPOINTS) return -1;
+
+    debug->breakpoints[debug->breakpoint_count++] = *breakpoint;
+    debug_rearm_page(cpu, breakpoint->addr >> MEMORY_PAGE_SHIFT);
+    // Whatever block runs across it has to be cut in front of it
+    if (cpu->blocks) block_invalidate(cpu, breakpoint->addr, 1);
+    return 0;
+}
+
+// Stops at whatever CS:IP pair lands on the physical address
+int debug_add_breakpoint(struct cpu *cpu, uint32_t addr) {
+    struct debug_breakpoint breakpoint = {.addr = addr & MEMORY_MASK};
+    return debug_insert_breakpoint(cpu, &breakpoint);
+}
+
+// Stops only when CS and IP are exactly these, not at other aliases of the same address
+int debug_add_breakpoint_at(struct cpu *cpu, uint16_t cs, uint16_t ip) {
+    struct debug_breakpoint breakpoint = {
+            .addr = (cs * 16 + ip) & MEMORY_MASK,
+            .cs = cs,
+            .ip = ip,
+            .segmented = 1,
+    };
+    return debug_insert_breakpoint(cpu, &breakpoint);
+}
+
+// Drops every breakpoint on the physical address, segmented ones included
+int debug_remove_breakpoint(struct cpu *cpu, uint32_t addr) {
+    struct debug *debug = cpu->debug;
+    if (!debug) return -1;
+    addr &= MEMORY_MASK;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < debug->breakpoint_count; i++)
+        if (debug->breakpoints[i].addr != addr) debug->breakpoints[kept++] = debug->breakpoints[i];
+    if (kept == debug->breakpoint_count) return -1;
+
+    debug->breakpoint_count = kept;
+    debug_rearm_page(cpu, addr >> MEMORY_PAGE_SHIFT);
+    if (cpu->blocks) block_invalidate(cpu, addr, 1);
+    return 0;
+}
+
+int debug_add_watchpoint(struct cpu *cpu, uint32_t addr, uint32_t size, uint8_t access) {
+    struct debug *debug = cpu->debug;
+    if (!debug || debug->watchpoint_count == DEBUG_MAX_WATCHPOINTS) return -1;
+    if (!size || !access || addr >= MEMORY_SIZE || size > MEMORY_SIZE - addr) return -1;
+
+    debug->watchpoints[debug->watchpoint_count++] = (struct debug_watchpoint) {addr, size, access};
+    for (uint32_t page = addr >> MEMORY_PAGE_SHIFT; page <= (addr + size - 1) >> MEMORY_PAGE_SHIFT; page++)
+        debug_rearm_page(cpu, page);
+    return 0;
+}
+
+int debug_remove_watchpoint(struct cpu *cpu, uint32_t addr, uint32_t size, uint8_t access) {
+    struct debug *debug = cpu->debug;
+    if (!debug) return -1;
+
+    for (size_t i = 0; i < debug->watchpoint_count; i++) {
+        const struct debug_watchpoint *watchpoint = &debug->watchpoints[i];
+        if (watchpoint->addr != addr || watchpoint->size != size || watchpoint->access != access) continue;
+
+        debug->watchpoints[i] = debug->watchpoints[--debug->watchpoint_count];
+        for (uint32_t page = addr >> MEMORY_PAGE_SHIFT; page <= (addr + size - 1) >> MEMORY_PAGE_SHIFT; page++)
+            debug_rearm_page(cpu, page);
+        return 0;
+    }
+    return -1;
+}
+
+static void debug_stop(struct cpu *cpu, uint8_t reason, uint32_t addr, uint8_t access) {
+    struct debug *debug = cpu->debug;
+    debug->reason = reason;
+    debug->addr = addr;
+    debug->access = access;
+    cpu->state |= CPU_BREAK;
+}
+
+static int debug_breakpoint_at(struct cpu *cpu, uint32_t addr) {
+    struct debug *debug = cpu->debug;
+    for (size_t i = 0; i < debug->breakpoint_count; i++) {
+        const struct debug_breakpoint *breakpoint = &debug->breakpoints[i];
+        if (breakpoint->addr != addr) continue;
+        if (!breakpoint->segmented || (breakpoint->cs == cpu->reg.cs && breakpoint->ip == cpu->reg.ip)) return 1;
+    }
+    return 0;
+}
+
+// Any breakpoint on the physical address, for block decoding, which can't know CS:IP yet
+int debug_has_breakpoint(struct cpu *cpu, uint32_t addr) {
+    struct debug *debug = cpu->debug;
+    if (!debug || !(cpu->memory.traps[addr >> MEMORY_PAGE_SHIFT] & MEMORY_TRAP_BREAK)) return 0;
+    for (size_t i = 0; i < debug->breakpoint_count; i++)
+        if (debug->breakpoints[i].addr == addr) return 1;
+    return 0;
+}
+
+/*
+    A breakpoint stops before its instruction runs, a watchpoint after the instruction that
+    touched it, so IP already points past the access when the run returns. The run that
+    starts on the breakpoint it stopped at goes ahead, anywhere else forgets about it.
+ */
+int debug_check_breakpoint(struct cpu *cpu) {
+    struct debug *debug = cpu->debug;
+    uint32_t ip32 = cpu->reg.ip32, resume = debug->resume;
+
+    debug->resume = DEBUG_NO_RESUME;
+    if (ip32 == resume || !(cpu->memory.traps[ip32 >> MEMORY_PAGE_SHIFT] & MEMORY_TRAP_BREAK) || !debug_breakpoint_at(cpu, ip32))
+        return 0;
+
+    debug->resume = ip32;
+    debug_stop(cpu, DEBUG_STOP_BREAKPOINT, ip32, 0);
+    return 1;
+}
+
+// Called from the memory slow paths for accesses to a page with a watch bit
+void debug_watch_hit(struct cpu *cpu, uint32_t addr, uint8_t write) {
+    struct debug *debug = cpu->debug;
+    if (!debug || (!write && cpu->memory.fetching)) return;
+
+    uint8_t access = write ? DEBUG_WATCH_WRITE : DEBUG_WATCH_READ;
+    for (size_t i = 0; i < debug->watchpoint_count; i++) {
+        const struct debug_watchpoint *watchpoint = &debug->watchpoints[i];
+        if ((watchpoint->access & access) && addr - watchpoint->addr < watchpoint->size) {
+            if (!(cpu->state & CPU_BREAK)) debug_stop(cpu, DEBUG_STOP_WATCHPOINT, addr, watchpoint->access);
+            return;
+        }
+    }
+}
\ No newline at end of file
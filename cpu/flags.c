@@ -0,0 +1,60 @@
+#include <cpu/cpu.h>
+#include <cpu/flags.h>
+
+static const uint8_t parity_table[0x100] = {
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
+        0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
+        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1};
+
+uint8_t flags_get_carry(struct cpu *cpu) {
+    switch (cpu->lazy.op) {
+        case FLAGS_OP_NONE: return cpu->reg.flags & CPU_FLAGS_CARRY;
+        case FLAGS_OP_ADD:
+        case FLAGS_OP_SUB: return (cpu->lazy.res >> cpu->lazy.width) & 1;
+        case FLAGS_OP_INC:
+        case FLAGS_OP_DEC: return cpu->lazy.carry;
+        default: return 0;
+    }
+}
+
+uint16_t flags_get(struct cpu *cpu) {
+    struct cpu_lazy_flags *lazy = &cpu->lazy;
+    if (lazy->op == FLAGS_OP_NONE) return cpu->reg.flags;
+
+    uint32_t sign = 1 << (lazy->width - 1);
+    uint32_t mask = (sign << 1) - 1;
+    uint32_t res = lazy->res;
+    uint16_t flags = cpu->reg.flags & ~(CPU_FLAGS_ARITH);
+
+    if (!(res & mask)) flags |= CPU_FLAGS_ZERO;
+    if (res & sign) flags |= CPU_FLAGS_SIGN;
+    if (parity_table[res & 0xff]) flags |= CPU_FLAGS_PARITY;
+    if (flags_get_carry(cpu)) flags |= CPU_FLAGS_CARRY;
+
+    switch (lazy->op) {
+        case FLAGS_OP_ADD:
+        case FLAGS_OP_INC:
+            if ((res ^ lazy->a) & (res ^ lazy->b) & sign) flags |= CPU_FLAGS_OVERFLOW;
+            if ((lazy->a ^ lazy->b ^ res) & 0x10) flags |= CPU_FLAGS_ACARRY;
+            break;
+        case FLAGS_OP_SUB:
+        case FLAGS_OP_DEC:
+            if ((lazy->a ^ lazy->b) & (lazy->a ^ res) & sign) flags |= CPU_FLAGS_OVERFLOW;
+            if ((lazy->a ^ lazy->b ^ res) & 0x10) flags |= CPU_FLAGS_ACARRY;
+            break;
+        default:
+            break;
+    }
+
+    // Cache the result so repeated readers don't recompute it
+    flags_set(cpu, flags);
+    return flags;
+}
\ No newline at end of file
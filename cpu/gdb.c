@@ -0,0 +1,513 @@
+#define _GNU_SOURCE
+
+#include <cpu/gdb.h>
+#include <cpu/debug.h>
+#include <cpu/memory.h>
+#include <cpu/opcodes.h>
+#include <cpu/flags.h>
+#include <cpu/io.h>
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define GDB_SIGINT 2
+#define GDB_SIGTRAP 5
+
+static const char gdb_hex[] = "0123456789abcdef";
+
+static inline int gdb_hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static uint32_t gdb_parse_hex(const char **p) {
+    uint32_t value = 0;
+    int digit;
+    while ((digit = gdb_hex_value(**p)) >= 0) {
+        value = value << 4 | digit;
+        (*p)++;
+    }
+    return value;
+}
+
+// "unix:/path" or "tcp:port", a bare port number means TCP, TCP only ever binds 127.0.0.1
+static int gdb_listen(struct gdb *gdb, const char *address) {
+    int fd;
+
+    if (!strncmp(address, "unix:", 5)) {
+        struct sockaddr_un addr = {.sun_family = AF_UNIX};
+        if (strlen(address + 5) >= sizeof(addr.sun_path)) return -1;
+        strcpy(addr.sun_path, address + 5);
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        // A stale socket from an earlier run can go, anything else at the path is left alone
+        struct stat st;
+        if (!lstat(addr.sun_path, &st)) {
+            if (!S_ISSOCK(st.st_mode)) goto fail;
+            unlink(addr.sun_path);
+        }
+        if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) goto fail;
+        gdb->path = strdup(addr.sun_path);
+    } else {
+        const char *port = strncmp(address, "tcp:", 4) ? address : address + 4;
+        char *end;
+        unsigned long number = strtoul(port, &end, 10);
+        if (*end || !number || number > 65535) return -1;
+
+        struct sockaddr_in addr = {
+                .sin_family = AF_INET,
+                .sin_port = htons(number),
+                .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+        };
+        int on = 1;
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) goto fail;
+    }
+
+    if (listen(fd, 1) < 0) goto fail;
+    gdb->listener = fd;
+    return 0;
+
+fail:
+    close(fd);
+    return -1;
+}
+
+struct gdb *gdb_create(struct cpu *cpu, const char *address) {
+    struct gdb *gdb = calloc(1, sizeof(struct gdb));
+    if (!gdb) return NULL;
+
+    gdb->cpu = cpu;
+    gdb->client = -1;
+    gdb->running = 1;
+    if (gdb_listen(gdb, address) < 0) {
+        free(gdb);
+        return NULL;
+    }
+    return gdb;
+}
+
+// Sends what fits now, the rest goes out on later polls
+static void gdb_flush(struct gdb *gdb) {
+    while (gdb->output_length && gdb->client >= 0) {
+        ssize_t sent = send(gdb->client, gdb->output, gdb->output_length, MSG_NOSIGNAL);
+        if (sent <= 0) return;
+        memmove(gdb->output, gdb->output + sent, gdb->output_length - sent);
+        gdb->output_length -= sent;
+    }
+}
+
+static void gdb_disconnect(struct gdb *gdb);
+
+/*
+    A reply is never cut short, a half-sent packet would leave GDB waiting on a checksum that
+    never comes. Waits until the output has room for length more bytes, and drops a client that
+    won't take anything for GDB_SEND_TIMEOUT milliseconds.
+ */
+static int gdb_drain(struct gdb *gdb, size_t length) {
+    while (gdb->client >= 0 && gdb->output_length + length > sizeof(gdb->output)) {
+        size_t before = gdb->output_length;
+        gdb_flush(gdb);
+        if (gdb->output_length < before) continue;
+
+        struct pollfd fd = {.fd = gdb->client, .events = POLLOUT};
+        int ready = poll(&fd, 1, GDB_SEND_TIMEOUT);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0 || (fd.revents & (POLLERR | POLLHUP | POLLNVAL))) gdb_disconnect(gdb);
+    }
+    return gdb->client >= 0 ? 0 : -1;
+}
+
+static void gdb_send_raw(struct gdb *gdb, const char *data, size_t length) {
+    if (gdb_drain(gdb, length) < 0) return;
+    memcpy(gdb->output + gdb->output_length, data, length);
+    gdb->output_length += length;
+}
+
+static void gdb_send(struct gdb *gdb, const char *payload) {
+    uint8_t checksum = 0;
+    size_t length = strlen(payload);
+    for (size_t i = 0; i < length; i++) checksum += (uint8_t) payload[i];
+
+    char trailer[3] = {'#', gdb_hex[checksum >> 4], gdb_hex[checksum & 15]};
+    gdb_send_raw(gdb, "$", 1);
+    gdb_send_raw(gdb, payload, length);
+    gdb_send_raw(gdb, trailer, sizeof(trailer));
+    gdb_flush(gdb);
+}
+
+// The client's breakpoints and watchpoints die with its connection, and the guest carries on
+static void gdb_disconnect(struct gdb *gdb) {
+    if (gdb->client >= 0) close(gdb->client);
+    gdb->client = -1;
+    gdb->input_length = 0;
+    gdb->output_length = 0;
+    gdb->no_ack = 0;
+    gdb->running = 1;
+    gdb->cpu->state &= ~CPU_BREAK;
+    if (gdb->owns_debug) debug_destroy(gdb->cpu);
+    gdb->owns_debug = 0;
+}
+
+// The guest is gone for good, a debugger still connected hears how it ended
+void gdb_exit(struct gdb *gdb, int status) {
+    char reply[8];
+    if (gdb->client < 0) return;
+    snprintf(reply, sizeof(reply), "W%02x", status & 0xff);
+    gdb_send(gdb, reply);
+    gdb_drain(gdb, sizeof(gdb->output));
+    gdb_disconnect(gdb);
+}
+
+void gdb_destroy(struct gdb *gdb) {
+    if (!gdb) return;
+    gdb_disconnect(gdb);
+    close(gdb->listener);
+    if (gdb->path) unlink(gdb->path);
+    free(gdb->path);
+    free(gdb);
+}
+
+// Debugger reads see memory as it is, without tripping watchpoints or poking MMIO registers
+static uint8_t gdb_peek(struct cpu *cpu, uint32_t addr) {
+    addr &= MEMORY_MASK;
+    if (cpu->memory.type[addr >> MEMORY_PAGE_SHIFT] == MEMORY_MMIO) return 0xff;
+    return cpu->memory.backing[addr];
+}
+
+static uint32_t gdb_get_reg(struct cpu *cpu, int reg) {
+    if (reg < 8) return cpu->reg.gpr[reg];
+    switch (reg) {
+        case GDB_REG_EIP: return cpu->reg.ip32;
+        case GDB_REG_EFLAGS: return flags_get(cpu);
+        case 10: return cpu->reg.cs;
+        case 11: return cpu->reg.ss;
+        case 12: return cpu->reg.ds;
+        case 13: return cpu->reg.es;
+        default: return 0;
+    }
+}
+
+static void gdb_set_reg(struct cpu *cpu, int reg, uint32_t value) {
+    if (reg < 8) cpu->reg.gpr[reg] = value;
+    switch (reg) {
+        case GDB_REG_EIP: cpu->reg.ip = value - cpu->reg.cs * 16; break;
+        case GDB_REG_EFLAGS: flags_set(cpu, value); break;
+        case 10: cpu->reg.cs = value; break;
+        case 11: cpu->reg.ss = value; break;
+        case 12: cpu->reg.ds = value; break;
+        case 13: cpu->reg.es = value; break;
+    }
+    cpu->reg.ip32 = (cpu->reg.cs * 16 + cpu->reg.ip) & MEMORY_MASK;
+}
+
+static char *gdb_put_reg(char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++, value >>= 8) {
+        *out++ = gdb_hex[(value >> 4) & 15];
+        *out++ = gdb_hex[value & 15];
+    }
+    return out;
+}
+
+static uint32_t gdb_take_reg(const char **p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        int high = gdb_hex_value((*p)[0]), low = high < 0 ? -1 : gdb_hex_value((*p)[1]);
+        if (low < 0) break;
+        value |= (uint32_t) (high << 4 | low) << (i * 8);
+        *p += 2;
+    }
+    return value;
+}
+
+// A watchpoint stop names the kind gdb set, watch for Z2, rwatch for Z3 and awatch for Z4
+static void gdb_stop_reply(struct gdb *gdb, int signal) {
+    struct debug *debug = gdb->cpu->debug;
+    char reply[64];
+
+    if (signal == GDB_SIGTRAP && (gdb->cpu->state & CPU_BREAK) && debug->reason == DEBUG_STOP_WATCHPOINT) {
+        const char *kind = "awatch";
+        if (debug->access == DEBUG_WATCH_WRITE) kind = "watch";
+        else if (debug->access == DEBUG_WATCH_READ) kind = "rwatch";
+        snprintf(reply, sizeof(reply), "T%02x%s:%x;", signal, kind, debug->addr);
+    } else
+        snprintf(reply, sizeof(reply), "S%02x", signal);
+    gdb_send(gdb, reply);
+}
+
+// Z2 write, Z3 read, Z4 either, with the length in the kind field
+static int gdb_point(struct gdb *gdb, const char *args, int insert) {
+    struct cpu *cpu = gdb->cpu;
+    int type = args[0] - '0';
+    const char *p = args + 2;
+    uint32_t addr = gdb_parse_hex(&p) & MEMORY_MASK;
+    uint32_t length = *p == ',' ? (p++, gdb_parse_hex(&p)) : 1;
+
+    if (type == 0 || type == 1) return insert ? debug_add_breakpoint(cpu, addr) : debug_remove_breakpoint(cpu, addr);
+
+    static const uint8_t access[] = {[2] = DEBUG_WATCH_WRITE, [3] = DEBUG_WATCH_READ, [4] = DEBUG_WATCH_READ | DEBUG_WATCH_WRITE};
+    if (type < 2 || type > 4 || !length) return -2;
+    return insert ? debug_add_watchpoint(cpu, addr, length, access[type]) : debug_remove_watchpoint(cpu, addr, length, access[type]);
+}
+
+// One instruction, breakpoints don't stop a step
+static void gdb_step(struct gdb *gdb) {
+    struct cpu *cpu = gdb->cpu;
+    cpu->state &= ~CPU_BREAK;
+    if (!(cpu->state & (CPU_HALTED | CPU_WAITING))) {
+        opcode_execute(cpu);
+        // GDB continues from where it was told the step stopped, even onto a breakpoint
+        cpu->debug->resume = cpu->reg.ip32;
+        if (cpu->io) io_flush(cpu);
+    }
+}
+
+static void gdb_packet(struct gdb *gdb, char *packet) {
+    struct cpu *cpu = gdb->cpu;
+    char reply[GDB_PACKET_SIZE + 1];
+    const char *p = packet + 1;
+
+    switch (packet[0]) {
+        case '?':
+            gdb_stop_reply(gdb, GDB_SIGTRAP);
+            return;
+        case 'g': {
+            char *out = reply;
+            for (int i = 0; i < GDB_REGISTERS; i++) out = gdb_put_reg(out, gdb_get_reg(cpu, i));
+            *out = 0;
+            gdb_send(gdb, reply);
+            return;
+        }
+        case 'G': {
+            // EIP is relative to CS, so the segment registers have to land before it does
+            uint32_t values[GDB_REGISTERS];
+            int count = 0;
+            while (count < GDB_REGISTERS && *p) values[count++] = gdb_take_reg(&p);
+            for (int i = GDB_REG_EFLAGS + 1; i < count; i++) gdb_set_reg(cpu, i, values[i]);
+            for (int i = 0; i <= GDB_REG_EFLAGS && i < count; i++) gdb_set_reg(cpu, i, values[i]);
+            gdb_send(gdb, "OK");
+            return;
+        }
+        case 'p': {
+            uint32_t reg = gdb_parse_hex(&p);
+            *gdb_put_reg(reply, reg < GDB_REGISTERS ? gdb_get_reg(cpu, reg) : 0) = 0;
+            gdb_send(gdb, reply);
+            return;
+        }
+        case 'P': {
+            uint32_t reg = gdb_parse_hex(&p);
+            if (*p++ != '=' || reg >= GDB_REGISTERS) {
+                gdb_send(gdb, "E01");
+                return;
+            }
+            gdb_set_reg(cpu, reg, gdb_take_reg(&p));
+            gdb_send(gdb, "OK");
+            return;
+        }
+        case 'm': {
+            uint32_t addr = gdb_parse_hex(&p);
+            uint32_t length = *p == ',' ? (p++, gdb_parse_hex(&p)) : 0;
+            if (length > GDB_PACKET_SIZE / 2) length = GDB_PACKET_SIZE / 2;
+            for (uint32_t i = 0; i < length; i++) {
+                uint8_t byte = gdb_peek(cpu, addr + i);
+                reply[i * 2] = gdb_hex[byte >> 4];
+                reply[i * 2 + 1] = gdb_hex[byte & 15];
+            }
+            reply[length * 2] = 0;
+            gdb_send(gdb, reply);
+            return;
+        }
+        case 'M': {
+            // Through memory_load, so cached blocks and watching devices see the change
+            uint32_t addr = gdb_parse_hex(&p);
+            uint32_t length = *p == ',' ? (p++, gdb_parse_hex(&p)) : 0;
+            if (*p++ != ':') {
+                gdb_send(gdb, "E01");
+                return;
+            }
+            for (uint32_t i = 0; i < length && p[0] && p[1]; i++, p += 2) {
+                uint8_t byte = gdb_hex_value(p[0]) << 4 | gdb_hex_value(p[1]);
+                memory_load(cpu, (addr + i) & MEMORY_MASK, &byte, 1);
+            }
+            gdb_send(gdb, "OK");
+            return;
+        }
+        case 'c':
+            if (*p) gdb_set_reg(cpu, GDB_REG_EIP, gdb_parse_hex(&p));
+            cpu->state &= ~CPU_BREAK;
+            gdb->running = 1;
+            return;
+        case 's':
+            if (*p) gdb_set_reg(cpu, GDB_REG_EIP, gdb_parse_hex(&p));
+            gdb_step(gdb);
+            gdb_stop_reply(gdb, GDB_SIGTRAP);
+            return;
+        case 'Z':
+        case 'z': {
+            int result = gdb_point(gdb, p, packet[0] == 'Z');
+            gdb_send(gdb, result == -2 ? "" : result < 0 ? "E01" : "OK");
+            return;
+        }
+        case 'H':
+            gdb_send(gdb, "OK");
+            return;
+        case 'D':
+            gdb_send(gdb, "OK");
+            gdb_drain(gdb, sizeof(gdb->output));
+            gdb_disconnect(gdb);
+            return;
+        case 'k':
+            cpu->state |= CPU_HALTED;
+            gdb_disconnect(gdb);
+            return;
+        case 'q':
+            if (!strncmp(p, "Supported", 9)) {
+                snprintf(reply, sizeof(reply), "PacketSize=%x;QStartNoAckMode+", GDB_PACKET_SIZE);
+                gdb_send(gdb, reply);
+            } else if (!strcmp(p, "Attached")) {
+                gdb_send(gdb, "1");
+            } else if (!strcmp(p, "C")) {
+                gdb_send(gdb, "QC1");
+            } else if (!strcmp(p, "fThreadInfo")) {
+                gdb_send(gdb, "m1");
+            } else if (!strcmp(p, "sThreadInfo")) {
+                gdb_send(gdb, "l");
+            } else {
+                gdb_send(gdb, "");
+            }
+            return;
+        case 'Q':
+            if (!strcmp(p, "StartNoAckMode")) {
+                gdb_send(gdb, "OK");
+                gdb->no_ack = 1;
+            } else {
+                gdb_send(gdb, "");
+            }
+            return;
+        default:
+            gdb_send(gdb, "");
+            return;
+    }
+}
+
+// Pulls complete $packet#ck frames out of the input, a lone 0x03 is GDB asking to stop
+static void gdb_parse(struct gdb *gdb) {
+    size_t start = 0;
+
+    while (start < gdb->input_length && gdb->client >= 0) {
+        char c = gdb->input[start];
+        if (c == 0x03) {
+            start++;
+            if (gdb->running) {
+                gdb->running = 0;
+                gdb_stop_reply(gdb, GDB_SIGINT);
+            }
+            continue;
+        }
+        if (c != '$') {
+            start++;
+            continue;
+        }
+
+        char *end = memchr(gdb->input + start, '#', gdb->input_length - start);
+        if (!end || end + 2 >= gdb->input + gdb->input_length) break;
+
+        uint8_t checksum = 0;
+        for (char *q = gdb->input + start + 1; q < end; q++) checksum += (uint8_t) *q;
+        int expected = gdb_hex_value(end[1]) << 4 | gdb_hex_value(end[2]);
+        size_t next = end + 3 - gdb->input;
+
+        if (checksum != expected && !gdb->no_ack) {
+            gdb_send_raw(gdb, "-", 1);
+        } else {
+            if (!gdb->no_ack) gdb_send_raw(gdb, "+", 1);
+            *end = 0;
+            gdb_packet(gdb, gdb->input + start + 1);
+        }
+        start = next;
+    }
+
+    if (gdb->client < 0) return;
+    memmove(gdb->input, gdb->input + start, gdb->input_length - start);
+    gdb->input_length -= start;
+    // A packet that can't fit is junk, drop it rather than wedge
+    if (gdb->input_length == sizeof(gdb->input)) gdb->input_length = 0;
+}
+
+static void gdb_accept(struct gdb *gdb) {
+    int fd = accept4(gdb->listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) return;
+
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    if (!gdb->cpu->debug) {
+        if (debug_create(gdb->cpu) < 0) {
+            close(fd);
+            return;
+        }
+        gdb->owns_debug = 1;
+    }
+
+    // The guest holds still for the debugger from the moment it connects
+    gdb->client = fd;
+    gdb->running = 0;
+}
+
+/*
+    Services the socket without blocking. Returns 1 while the guest may keep running and 0
+    while a debugger holds it stopped, in which case the host has to keep polling (gdb_wait
+    sleeps until there is something to poll for) rather than call cpu_run.
+ */
+int gdb_poll(struct gdb *gdb) {
+    struct cpu *cpu = gdb->cpu;
+
+    if (gdb->client < 0) {
+        gdb_accept(gdb);
+        if (gdb->client < 0) return 1;
+    }
+
+    // Whatever stopped the last run slice is news to the debugger
+    if (gdb->running && (cpu->state & (CPU_BREAK | CPU_HALTED))) {
+        gdb->running = 0;
+        gdb_stop_reply(gdb, GDB_SIGTRAP);
+        if (gdb->client < 0) return 1;
+    }
+
+    for (;;) {
+        ssize_t got = recv(gdb->client, gdb->input + gdb->input_length, sizeof(gdb->input) - gdb->input_length, 0);
+        if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            gdb_disconnect(gdb);
+            return 1;
+        }
+        if (got < 0) break;
+        gdb->input_length += got;
+        gdb_parse(gdb);
+        if (gdb->client < 0) return 1;
+    }
+
+    gdb_flush(gdb);
+    return gdb->running;
+}
+
+// For hosts with nothing else to do while the guest is held, sleeps until the socket has news
+void gdb_wait(struct gdb *gdb, int timeout) {
+    struct pollfd fd = {
+            .fd = gdb->client >= 0 ? gdb->client : gdb->listener,
+            .events = POLLIN | (gdb->output_length ? POLLOUT : 0),
+    };
+    poll(&fd, 1, timeout);
+}
\ No newline at end of file
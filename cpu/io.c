@@ -0,0 +1,120 @@
+#include <cpu/io.h>
+
+#include <stdlib.h>
+
+int io_create(struct cpu *cpu) {
+    cpu->io = calloc(1, sizeof(struct io));
+    return cpu->io ? 0 : -1;
+}
+
+void io_destroy(struct cpu *cpu) {
+    if (cpu->io) io_flush(cpu);
+    free(cpu->io);
+    cpu->io = NULL;
+}
+
+// Returns the device slot, or -1 once all of them are taken
+int io_attach(struct cpu *cpu, uint16_t base, uint32_t count, const struct io_device *device) {
+    struct io *io = cpu->io;
+    if (io->device_count == IO_MAX_DEVICES) return -1;
+
+    uint8_t slot = ++io->device_count;
+    io->devices[slot] = *device;
+    // Nothing to hand queued writes to, so they have to go straight through
+    if (!device->flush) io->devices[slot].flags &= ~(IO_DEFERRED | IO_COALESCE);
+
+    for (uint32_t i = 0; i < count && base + i < IO_PORTS; i++)
+        io->port_device[base + i] = slot;
+    return slot;
+}
+
+void io_detach(struct cpu *cpu, uint16_t base, uint32_t count) {
+    struct io *io = cpu->io;
+    for (uint32_t i = 0; i < count && base + i < IO_PORTS; i++) {
+        if (io->port_device[base + i] == io->queued_device) io_flush(cpu);
+        io->port_device[base + i] = 0;
+    }
+}
+
+void io_flush(struct cpu *cpu) {
+    struct io *io = cpu->io;
+    if (!io->queue_count) return;
+
+    struct io_device *device = &io->devices[io->queued_device];
+    device->flush(device->ctx, io->queue, io->queue_count);
+    io->queue_count = 0;
+    io->queued_device = 0;
+}
+
+static void io_queue(struct cpu *cpu, uint8_t slot, uint16_t port, uint16_t value, uint8_t width) {
+    struct io *io = cpu->io;
+    if (io->queue_count && (io->queued_device != slot || io->queue_count == IO_QUEUE_SIZE)) io_flush(cpu);
+
+    if (io->queue_count && (io->devices[slot].flags & IO_COALESCE)) {
+        struct io_write *last = &io->queue[io->queue_count - 1];
+        if (last->port == port && last->width == width) {
+            last->value = value;
+            return;
+        }
+    }
+
+    io->queued_device = slot;
+    io->queue[io->queue_count++] = (struct io_write) {port, value, width};
+}
+
+// Devices see accesses in program order: a read observes every write queued ahead of it, whichever
+// device it went to, and a write to another device goes out after them
+static inline void io_order(struct cpu *cpu, uint8_t slot, int read) {
+    struct io *io = cpu->io;
+    if (io->queue_count && (read || io->queued_device != slot)) io_flush(cpu);
+}
+
+uint8_t io_read_byte_slow(struct cpu *cpu, uint8_t slot, uint16_t port) {
+    struct io_device *device = &cpu->io->devices[slot];
+    io_order(cpu, slot, 1);
+    return device->read ? device->read(device->ctx, port) : 0xff;
+}
+
+void io_write_byte_slow(struct cpu *cpu, uint8_t slot, uint16_t port, uint8_t byte) {
+    struct io_device *device = &cpu->io->devices[slot];
+    if (device->flags & IO_DEFERRED) {
+        io_queue(cpu, slot, port, byte, 1);
+        return;
+    }
+    io_order(cpu, slot, 0);
+    if (device->write) device->write(device->ctx, port, byte);
+}
+
+// One device call when both halves belong to the same device and it takes words, otherwise the bus splits it
+uint16_t io_read_word_slow(struct cpu *cpu, uint16_t port) {
+    struct io *io = cpu->io;
+    uint8_t slot = io->port_device[port];
+    uint16_t next = port + 1;
+
+    if (slot && io->devices[slot].read_word && io->port_device[next] == slot) {
+        io_order(cpu, slot, 1);
+        return io->devices[slot].read_word(io->devices[slot].ctx, port);
+    }
+    return io_read_byte(cpu, port) | (io_read_byte(cpu, next) << 8);
+}
+
+void io_write_word_slow(struct cpu *cpu, uint16_t port, uint16_t word) {
+    struct io *io = cpu->io;
+    uint8_t slot = io->port_device[port];
+    uint16_t next = port + 1;
+
+    if (slot && io->port_device[next] == slot) {
+        struct io_device *device = &io->devices[slot];
+        if (device->flags & IO_DEFERRED) {
+            io_queue(cpu, slot, port, word, 2);
+            return;
+        }
+        if (device->write_word) {
+            io_order(cpu, slot, 0);
+            device->write_word(device->ctx, port, word);
+            return;
+        }
+    }
+    io_write_byte(cpu, port, word & 0xff);
+    io_write_byte(cpu, next, word >> 8);
+}
\ No newline at end of file
@@ -0,0 +1,582 @@
+#ifdef CPU_JIT
+
+#define _GNU_SOURCE
+
+#ifndef __x86_64__
+#error "The JIT backend only emits x86-64 code"
+#endif
+
+#include <cpu/cpu.h>
+#include <cpu/jit.h>
+#include <cpu/block.h>
+#include <cpu/flags.h>
+#include <cpu/opcodes.h>
+#include <cpu/memory.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+    Register use inside translated code:
+    rbx = struct cpu *
+    r12 = struct jit_exec *
+    rax, rcx, rdx, rsi, rdi = scratch / call arguments
+ */
+
+#define JIT_OFF(field) ((uint32_t) offsetof(struct cpu, field))
+
+static inline void jit_emit8(uint8_t **p, uint8_t v) {
+    *(*p)++ = v;
+}
+
+static inline void jit_emit32(uint8_t **p, uint32_t v) {
+    memcpy(*p, &v, 4);
+    *p += 4;
+}
+
+static inline void jit_emit64(uint8_t **p, uint64_t v) {
+    memcpy(*p, &v, 8);
+    *p += 8;
+}
+
+static inline void jit_emit_bytes(uint8_t **p, const char *bytes, size_t n) {
+    memcpy(*p, bytes, n);
+    *p += n;
+}
+
+static inline void jit_patch_rel32(uint8_t *at, uint8_t *target) {
+    int32_t rel = (int32_t) (target - (at + 4));
+    memcpy(at, &rel, 4);
+}
+
+// mov rax, fn; call rax
+static inline void jit_emit_call(uint8_t **p, void *fn) {
+    jit_emit_bytes(p, "\x48\xb8", 2);
+    jit_emit64(p, (uint64_t) (uintptr_t) fn);
+    jit_emit_bytes(p, "\xff\xd0", 2);
+}
+
+static inline void jit_emit_epilogue(uint8_t **p) {
+    // add rsp, 8; pop r12; pop rbx; ret
+    jit_emit_bytes(p, "\x48\x83\xc4\x08\x41\x5c\x5b\xc3", 8);
+}
+
+// Leaves the block after a fallback uop if it branched, stopped the CPU or dropped a translation,
+// handing back the budget of the uops that did not run. The block's last uop skips the branch
+// check, wherever it went is up to the chain compares that follow it.
+static void jit_emit_exit_checks(uint8_t **p, uint32_t expected_ip32, uint8_t check_ip, uint32_t remaining, uint8_t *epilogue) {
+    uint8_t *to_stub[3];
+    size_t stubs = 0;
+
+    if (check_ip) {
+        // cmp dword [rbx + ip32], expected_ip32; jne stub
+        jit_emit_bytes(p, "\x81\xbb", 2);
+        jit_emit32(p, JIT_OFF(reg.ip32));
+        jit_emit32(p, expected_ip32);
+        jit_emit_bytes(p, "\x0f\x85", 2);
+        to_stub[stubs++] = *p;
+        jit_emit32(p, 0);
+    }
+
+    // test byte [rbx + state], CPU_STOP; jnz stub
+    jit_emit_bytes(p, "\xf6\x83", 2);
+    jit_emit32(p, JIT_OFF(state));
+    jit_emit8(p, CPU_STOP);
+    jit_emit_bytes(p, "\x0f\x85", 2);
+    to_stub[stubs++] = *p;
+    jit_emit32(p, 0);
+
+    // cmp byte [r12 + dropped], 0; jne stub
+    jit_emit_bytes(p, "\x41\x80\x7c\x24", 4);
+    jit_emit8(p, offsetof(struct jit_exec, dropped));
+    jit_emit8(p, 0);
+    jit_emit_bytes(p, "\x0f\x85", 2);
+    to_stub[stubs++] = *p;
+    jit_emit32(p, 0);
+
+    // jmp over the stub
+    jit_emit8(p, 0xeb);
+    jit_emit8(p, remaining ? 13 : 5);
+
+    for (size_t i = 0; i < stubs; i++) jit_patch_rel32(to_stub[i], *p);
+    if (remaining) {
+        // add qword [r12], remaining
+        jit_emit_bytes(p, "\x49\x81\x04\x24", 4);
+        jit_emit32(p, remaining);
+    }
+    jit_emit8(p, 0xe9);
+    jit_patch_rel32(*p, epilogue);
+    *p += 4;
+}
+
+// Charges a conditional branch's penalty when it didn't fall through to end
+static void jit_emit_taken(uint8_t **p, uint32_t end, uint32_t taken) {
+    jit_emit_bytes(p, "\x81\xbb", 2);       // cmp dword [rbx + ip32], end
+    jit_emit32(p, JIT_OFF(reg.ip32));
+    jit_emit32(p, end);
+    jit_emit_bytes(p, "\x74\x08", 2);       // je +8
+    jit_emit_bytes(p, "\x49\x81\x2c\x24", 4); // sub qword [r12], taken
+    jit_emit32(p, taken);
+}
+
+// Anything without a native translator goes back through the interpreter
+static void jit_emit_fallback(uint8_t **p, const struct block_uop *uop) {
+    jit_emit_bytes(p, "\x48\x89\xdf", 3);   // mov rdi, rbx
+    jit_emit8(p, 0xbe);                     // mov esi, opcode
+    jit_emit32(p, uop->opcode);
+    jit_emit8(p, 0xba);                     // mov edx, op0
+    jit_emit32(p, uop->op[0]);
+    jit_emit8(p, 0xb9);                     // mov ecx, op1
+    jit_emit32(p, uop->op[1]);
+    jit_emit_call(p, opcode_call);
+}
+
+// INC/DEC r16, recorded into the lazy flags exactly like opcode_inc/opcode_dec
+static void jit_emit_incdec16(uint8_t **p, const struct block_uop *uop) {
+    uint32_t reg = JIT_OFF(reg.gpr) + (uop->opcode & 7) * sizeof(uint16_t);
+    uint8_t dec = uop->opcode & 8;
+
+    jit_emit_bytes(p, "\x48\x89\xdf", 3);   // mov rdi, rbx
+    jit_emit_call(p, flags_get_carry);
+    jit_emit_bytes(p, "\x88\x83", 2);       // mov [rbx + lazy.carry], al
+    jit_emit32(p, JIT_OFF(lazy.carry));
+
+    jit_emit_bytes(p, "\x0f\xb7\x83", 3);   // movzx eax, word [rbx + reg]
+    jit_emit32(p, reg);
+    jit_emit_bytes(p, "\x66\x89\x83", 3);   // mov [rbx + lazy.a], ax
+    jit_emit32(p, JIT_OFF(lazy.a));
+    jit_emit_bytes(p, "\x8d\x48", 2);       // lea ecx, [rax +/- 1]
+    jit_emit8(p, dec ? 0xff : 0x01);
+    jit_emit_bytes(p, "\x89\x8b", 2);       // mov [rbx + lazy.res], ecx
+    jit_emit32(p, JIT_OFF(lazy.res));
+    jit_emit_bytes(p, "\x66\x89\x8b", 3);   // mov [rbx + reg], cx
+    jit_emit32(p, reg);
+
+    jit_emit_bytes(p, "\x66\xc7\x83", 3);   // mov word [rbx + lazy.b], 1
+    jit_emit32(p, JIT_OFF(lazy.b));
+    jit_emit_bytes(p, "\x01\x00", 2);
+    jit_emit_bytes(p, "\xc6\x83", 2);       // mov byte [rbx + lazy.op], op
+    jit_emit32(p, JIT_OFF(lazy.op));
+    jit_emit8(p, dec ? FLAGS_OP_DEC : FLAGS_OP_INC);
+    jit_emit_bytes(p, "\xc6\x83", 2);       // mov byte [rbx + lazy.width], 16
+    jit_emit32(p, JIT_OFF(lazy.width));
+    jit_emit8(p, 16);
+
+    jit_emit_bytes(p, "\x66\x83\x83", 3);   // add word [rbx + ip], 1
+    jit_emit32(p, JIT_OFF(reg.ip));
+    jit_emit8(p, 1);
+}
+
+// add word [rbx + ip], length
+static void jit_emit_advance(uint8_t **p, uint16_t length) {
+    jit_emit_bytes(p, "\x66\x81\x83", 3);
+    jit_emit32(p, JIT_OFF(reg.ip));
+    jit_emit8(p, length & 0xff);
+    jit_emit8(p, length >> 8);
+}
+
+// Where an 8086 register lives in struct cpu, width picks gpr8 or gpr the same way the opcodes do
+static inline uint32_t jit_reg_offset(uint8_t reg, uint8_t wide) {
+    return wide ? JIT_OFF(reg.gpr) + reg * sizeof(uint16_t) : JIT_OFF(reg.gpr8) + CPU_REG8(reg);
+}
+
+// movzx eax/ecx, byte or word [rbx + offset], modrm picks the destination
+static void jit_emit_load(uint8_t **p, uint8_t modrm, uint32_t offset, uint8_t wide) {
+    jit_emit_bytes(p, wide ? "\x0f\xb7" : "\x0f\xb6", 2);
+    jit_emit8(p, modrm);
+    jit_emit32(p, offset);
+}
+
+// mov [rbx + offset], al/ax or dl/dx, modrm picks the source
+static void jit_emit_store(uint8_t **p, uint8_t modrm, uint32_t offset, uint8_t wide) {
+    if (wide) jit_emit8(p, 0x66);
+    jit_emit8(p, wide ? 0x89 : 0x88);
+    jit_emit8(p, modrm);
+    jit_emit32(p, offset);
+}
+
+/*
+    dst = dst op src for ADD, OR, AND, SUB, XOR and CMP, recorded into the lazy flags exactly like
+    opcode_add8/opcode_sub and the logic handlers do: a and b are the zero-extended operands, or 0
+    for logic, and res is their 32-bit sum or difference. src is a register offset, or an
+    immediate when src_is_imm is set.
+ */
+static void jit_emit_alu(uint8_t **p, uint8_t operation, uint8_t wide, uint32_t dst, uint32_t src, uint8_t src_is_imm) {
+    static const char ops[8] = {0x01, 0x09, 0, 0, 0x21, 0x29, 0x31, 0x29};
+    uint8_t logic = operation == 1 || operation == 4 || operation == 6;
+
+    jit_emit_load(p, 0x83, dst, wide);          // movzx eax, [rbx + dst]
+    if (src_is_imm) {
+        jit_emit8(p, 0xb9);                     // mov ecx, imm
+        jit_emit32(p, src);
+    } else {
+        jit_emit_load(p, 0x8b, src, wide);      // movzx ecx, [rbx + src]
+    }
+    jit_emit_bytes(p, "\x89\xc2", 2);           // mov edx, eax
+    jit_emit8(p, ops[operation]);               // op edx, ecx
+    jit_emit8(p, 0xca);
+
+    jit_emit_bytes(p, "\xc6\x83", 2);           // mov byte [rbx + lazy.op], op
+    jit_emit32(p, JIT_OFF(lazy.op));
+    jit_emit8(p, logic ? FLAGS_OP_LOGIC : operation == 0 ? FLAGS_OP_ADD : FLAGS_OP_SUB);
+    jit_emit_bytes(p, "\xc6\x83", 2);           // mov byte [rbx + lazy.width], width
+    jit_emit32(p, JIT_OFF(lazy.width));
+    jit_emit8(p, wide ? 16 : 8);
+    if (logic) jit_emit_bytes(p, "\x31\xc0\x31\xc9", 4); // xor eax, eax; xor ecx, ecx
+    jit_emit_store(p, 0x83, JIT_OFF(lazy.a), 1);  // mov [rbx + lazy.a], ax
+    jit_emit_store(p, 0x8b, JIT_OFF(lazy.b), 1);  // mov [rbx + lazy.b], cx
+    jit_emit_bytes(p, "\x89\x93", 2);           // mov [rbx + lazy.res], edx
+    jit_emit32(p, JIT_OFF(lazy.res));
+
+    if (operation != 7) jit_emit_store(p, 0x93, dst, wide); // mov [rbx + dst], dl/dx
+}
+
+// op r/m, reg and op reg, r/m with a register operand
+static void jit_emit_alu_modrm(uint8_t **p, const struct block_uop *uop) {
+    uint8_t wide = uop->opcode & 1, to_reg = uop->opcode & 2;
+    uint32_t reg = jit_reg_offset((uop->op[0] >> 3) & 7, wide), rm = jit_reg_offset(uop->op[0] & 7, wide);
+
+    jit_emit_alu(p, (uop->opcode >> 3) & 7, wide, to_reg ? reg : rm, to_reg ? rm : reg, 0);
+    jit_emit_advance(p, uop->length);
+}
+
+// op al, imm8 and op ax, imm16
+static void jit_emit_alu_acc(uint8_t **p, const struct block_uop *uop) {
+    uint8_t wide = uop->opcode & 1;
+    uint16_t imm = wide ? uop->op[0] | uop->op[1] << 8 : uop->op[0];
+
+    jit_emit_alu(p, (uop->opcode >> 3) & 7, wide, jit_reg_offset(0, wide), imm, 1);
+    jit_emit_advance(p, uop->length);
+}
+
+// Group 1 on a register with an imm8, sign-extended to a word for 83
+static void jit_emit_alu_imm(uint8_t **p, const struct block_uop *uop) {
+    uint8_t wide = uop->opcode & 1;
+    uint16_t imm = wide ? (uint16_t) (int8_t) uop->op[1] : uop->op[1];
+
+    jit_emit_alu(p, (uop->op[0] >> 3) & 7, wide, jit_reg_offset(uop->op[0] & 7, wide), imm, 1);
+    jit_emit_advance(p, uop->length);
+}
+
+static void jit_emit_mov(uint8_t **p, const struct block_uop *uop) {
+    uint8_t wide = uop->opcode & 1, to_reg = uop->opcode & 2;
+    uint32_t reg = jit_reg_offset((uop->op[0] >> 3) & 7, wide), rm = jit_reg_offset(uop->op[0] & 7, wide);
+
+    jit_emit_load(p, 0x83, to_reg ? rm : reg, wide);
+    jit_emit_store(p, 0x83, to_reg ? reg : rm, wide);
+    jit_emit_advance(p, uop->length);
+}
+
+static void jit_emit_mov_imm(uint8_t **p, const struct block_uop *uop) {
+    uint8_t wide = uop->opcode & 8;
+
+    if (wide) jit_emit8(p, 0x66);
+    jit_emit_bytes(p, wide ? "\xc7\x83" : "\xc6\x83", 2); // mov [rbx + reg], imm
+    jit_emit32(p, jit_reg_offset(uop->opcode & 7, wide));
+    jit_emit8(p, uop->op[0]);
+    if (wide) jit_emit8(p, uop->op[1]);
+    jit_emit_advance(p, uop->length);
+}
+
+/*
+    Jcc rel8 tests the 8086 flags with the host's own condition codes: the arithmetic flags sit
+    at the same bit positions in both, so flags_get's result goes straight into RFLAGS. A taken
+    branch adds its displacement to IP and is charged its penalty here.
+ */
+static void jit_emit_jcc(uint8_t **p, const struct block_uop *uop) {
+    jit_emit_bytes(p, "\x48\x89\xdf", 3);       // mov rdi, rbx
+    jit_emit_call(p, flags_get);
+    jit_emit_bytes(p, "\x0f\xb7\xc0", 3);       // movzx eax, ax
+    jit_emit8(p, 0x25);                         // and eax, CPU_FLAGS_ARITH
+    jit_emit32(p, CPU_FLAGS_ARITH);
+    jit_emit_bytes(p, "\x50\x9d", 2);           // push rax; popfq
+
+    jit_emit8(p, 0x0f);                         // jcc taken
+    jit_emit8(p, 0x80 | (uop->opcode & 0x0f));
+    uint8_t *to_taken = *p;
+    jit_emit32(p, 0);
+
+    jit_emit_advance(p, uop->length);
+    jit_emit8(p, 0xe9);                         // jmp done
+    uint8_t *to_done = *p;
+    jit_emit32(p, 0);
+
+    jit_patch_rel32(to_taken, *p);
+    jit_emit_advance(p, uop->length + (int8_t) uop->op[0]);
+    jit_emit_bytes(p, "\x49\x81\x2c\x24", 4);   // sub qword [r12], taken
+    jit_emit32(p, uop->taken);
+    jit_patch_rel32(to_done, *p);
+}
+
+typedef void (*jit_translator)(uint8_t **p, const struct block_uop *uop);
+
+/*
+    Picks a native translator from the opcode table's native class. Only register operands are
+    translated, memory operands need the effective address and its cycles and go through the
+    interpreter, and so do ADC and SBB and 81's imm16, which doesn't fit in a uop.
+ */
+static jit_translator jit_translator_for(const struct block_uop *uop) {
+    const struct opcode *opcode = &opcodes[uop->opcode];
+    uint8_t operation = (uop->opcode >> 3) & 7;
+
+    switch (opcode->native) {
+        case OPCODE_NATIVE_ALU:
+            if ((uop->op[0] & 0xc0) != 0xc0 || operation == 2 || operation == 3) return NULL;
+            return jit_emit_alu_modrm;
+        case OPCODE_NATIVE_ALU_ACC:
+            if (operation == 2 || operation == 3) return NULL;
+            return jit_emit_alu_acc;
+        case OPCODE_NATIVE_ALU_IMM:
+            operation = (uop->op[0] >> 3) & 7;
+            if ((uop->op[0] & 0xc0) != 0xc0 || operation == 2 || operation == 3 || uop->length > 3) return NULL;
+            return jit_emit_alu_imm;
+        case OPCODE_NATIVE_MOV:
+            return (uop->op[0] & 0xc0) == 0xc0 ? jit_emit_mov : NULL;
+        case OPCODE_NATIVE_MOV_IMM: return jit_emit_mov_imm;
+        case OPCODE_NATIVE_INCDEC: return jit_emit_incdec16;
+        case OPCODE_NATIVE_JCC: return jit_emit_jcc;
+        default: return NULL;
+    }
+}
+
+// ip32 = cs * 16 + ip, needed when the block ends on a native uop
+static void jit_emit_sync_ip32(uint8_t **p) {
+    jit_emit_bytes(p, "\x0f\xb7\x83", 3);   // movzx eax, word [rbx + cs]
+    jit_emit32(p, JIT_OFF(reg.cs));
+    jit_emit_bytes(p, "\xc1\xe0\x04", 3);   // shl eax, 4
+    jit_emit_bytes(p, "\x0f\xb7\x8b", 3);   // movzx ecx, word [rbx + ip]
+    jit_emit32(p, JIT_OFF(reg.ip));
+    jit_emit_bytes(p, "\x01\xc8", 2);       // add eax, ecx
+    jit_emit8(p, 0x25);                     // and eax, MEMORY_MASK
+    jit_emit32(p, MEMORY_MASK);
+    jit_emit_bytes(p, "\x89\x83", 2);       // mov [rbx + ip32], eax
+    jit_emit32(p, JIT_OFF(reg.ip32));
+}
+
+// Patches chain to enter to's body and records it there, so dropping to can find it again
+static void jit_chain_link(struct block_chain *chain, struct block *to) {
+    jit_patch_rel32(chain->site, to->code_body);
+    chain->to = to;
+    chain->next = to->incoming;
+    to->incoming = chain;
+}
+
+// An unlinked jump lands on the instruction right after it and carries on to the next compare
+static void jit_chain_unlink(struct block_chain *chain) {
+    jit_patch_rel32(chain->site, chain->site + 4);
+    chain->to = NULL;
+    chain->next = NULL;
+}
+
+// Links the new translation's exits and every waiting exit that targets its address
+static void jit_link(struct cpu *cpu, struct block *block) {
+    for (size_t i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        struct block *other = &cpu->blocks->blocks[i];
+        if (!other->code) continue;
+
+        for (size_t c = 0; c < 2; c++) {
+            if (other->chain[c].site && !other->chain[c].to && other->chain[c].target == block->addr)
+                jit_chain_link(&other->chain[c], block);
+            if (block->chain[c].site && !block->chain[c].to && block->chain[c].target == other->addr)
+                jit_chain_link(&block->chain[c], other);
+        }
+    }
+}
+
+static void jit_translate(struct cpu *cpu, struct block *block) {
+    struct jit *jit = cpu->jit;
+
+    for (uint8_t i = 0; i < block->count; i++)
+        if (!opcodes[block->uops[i].opcode].function) return;
+
+    if (jit->used + JIT_MAX_BLOCK_CODE > JIT_CODE_SIZE) jit_flush(cpu);
+
+    uint8_t *start = jit->write + jit->used;
+    uint8_t *p = start;
+
+    // push rbx; push r12; sub rsp, 8; mov rbx, rdi; mov r12, rsi
+    jit_emit_bytes(&p, "\x53\x41\x54\x48\x83\xec\x08\x48\x89\xfb\x49\x89\xf4", 13);
+
+    uint8_t *body = p;
+    uint8_t *to_epilogue;
+
+    // cmp qword [r12], cost; jl epilogue; sub qword [r12], cost
+    jit_emit_bytes(&p, "\x49\x81\x3c\x24", 4);
+    jit_emit32(&p, block->cost);
+    jit_emit_bytes(&p, "\x0f\x8c", 2);
+    to_epilogue = p;
+    jit_emit32(&p, 0);
+    jit_emit_bytes(&p, "\x49\x81\x2c\x24", 4);
+    jit_emit32(&p, block->cost);
+
+    // Exit checks jump backwards to a shared epilogue placed ahead of the body's code
+    uint8_t *skip = p;
+    jit_emit8(&p, 0xeb);
+    jit_emit8(&p, 8);
+    uint8_t *epilogue = p;
+    jit_emit_epilogue(&p);
+    skip[1] = (uint8_t) (p - (skip + 2));
+    jit_patch_rel32(to_epilogue, epilogue);
+
+    uint32_t ip32 = block->addr;
+    uint8_t native_tail = 0;
+
+    for (uint8_t i = 0; i < block->count; i++) {
+        const struct block_uop *uop = &block->uops[i];
+        jit_translator translate = jit_translator_for(uop);
+        ip32 += uop->length;
+
+        if (translate) {
+            translate(&p, uop);
+            native_tail = 1;
+        } else {
+            jit_emit_fallback(&p, uop);
+            if (uop->taken) jit_emit_taken(&p, block->end, uop->taken);
+            jit_emit_exit_checks(&p, ip32, i + 1 < block->count, block->cost - uop->total, epilogue);
+            native_tail = 0;
+        }
+    }
+
+    if (native_tail) jit_emit_sync_ip32(&p);
+
+    // Chain to the fall-through successor and the branch target, a conditional branch or LOOP
+    // can go either way while JMP and CALL only ever leave through their target
+    const struct block_uop *last = &block->uops[block->count - 1];
+    uint8_t chains = 1;
+    block->chain[0].target = block->end;
+    block->chain[1].target = block->end + (int8_t) last->op[0];
+    if ((last->opcode >= 0x70 && last->opcode <= 0x7f) || (last->opcode >= 0xe0 && last->opcode <= 0xe3)) chains = 2;
+    else if (last->opcode == 0xeb) block->chain[0].target = block->chain[1].target;
+    else if (last->opcode == 0xe8 || last->opcode == 0xe9) block->chain[0].target = block->end + (int16_t) (last->op[0] | last->op[1] << 8);
+
+    jit_emit_bytes(&p, "\x8b\x83", 2);      // mov eax, [rbx + ip32]
+    jit_emit32(&p, JIT_OFF(reg.ip32));
+    for (uint8_t c = 0; c < 2; c++) {
+        block->chain[c].site = NULL;
+        block->chain[c].to = NULL;
+        block->chain[c].next = NULL;
+        if (c >= chains) continue;
+
+        jit_emit8(&p, 0x3d);                // cmp eax, target; jne +5; jmp rel32
+        jit_emit32(&p, block->chain[c].target);
+        jit_emit_bytes(&p, "\x75\x05\xe9", 3);
+        block->chain[c].site = p;
+        jit_patch_rel32(p, p + 4);
+        p += 4;
+    }
+    jit_emit8(&p, 0xe9);
+    jit_patch_rel32(p, epilogue);
+    p += 4;
+
+    // Everything but the entry point stays in the write view, chains are patched through it
+    block->code = jit->code + (start - jit->write);
+    block->code_body = body;
+    block->incoming = NULL;
+    jit->used += p - start;
+
+    jit_link(cpu, block);
+}
+
+int jit_create(struct cpu *cpu) {
+    struct jit *jit = calloc(1, sizeof(struct jit));
+    if (!jit) return -1;
+
+    int fd = memfd_create("8086win-jit", MFD_CLOEXEC);
+    if (fd < 0 || ftruncate(fd, JIT_CODE_SIZE) < 0) goto fail;
+
+    jit->write = mmap(NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (jit->write == MAP_FAILED) goto fail;
+    jit->code = mmap(NULL, JIT_CODE_SIZE, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    if (jit->code == MAP_FAILED) {
+        munmap(jit->write, JIT_CODE_SIZE);
+        goto fail;
+    }
+
+    close(fd);
+    cpu->jit = jit;
+    return 0;
+
+fail:
+    if (fd >= 0) close(fd);
+    free(jit);
+    return -1;
+}
+
+void jit_destroy(struct cpu *cpu) {
+    if (!cpu->jit) return;
+    munmap(cpu->jit->code, JIT_CODE_SIZE);
+    munmap(cpu->jit->write, JIT_CODE_SIZE);
+    free(cpu->jit);
+    cpu->jit = NULL;
+}
+
+// Drops every translation, used when the code cache fills up or the costs baked into it change
+void jit_flush(struct cpu *cpu) {
+    if (!cpu->jit) return;
+
+    for (size_t i = 0; i < BLOCK_CACHE_SIZE; i++) {
+        struct block *block = &cpu->blocks->blocks[i];
+        block->code = NULL;
+        block->hits = 0;
+        block->incoming = NULL;
+        block->chain[0].to = block->chain[1].to = NULL;
+    }
+    cpu->jit->used = 0;
+    cpu->jit->exec.dropped = 1;
+}
+
+/*
+    Drops one translation when its block is invalidated or evicted. Jumps chained into it are
+    pointed back at their compare-and-exit path and its own links come off their targets' lists,
+    everything else stays translated. The code itself is only reclaimed by the next flush, so
+    native code still running in it can return through its exit checks.
+ */
+void jit_drop(struct cpu *cpu, struct block *block) {
+    if (!block->code) return;
+
+    for (struct block_chain *chain = block->incoming, *next; chain; chain = next) {
+        next = chain->next;
+        jit_chain_unlink(chain);
+    }
+    block->incoming = NULL;
+
+    for (size_t c = 0; c < 2; c++) {
+        struct block_chain *chain = &block->chain[c];
+        if (!chain->to) continue;
+        for (struct block_chain **link = &chain->to->incoming; *link; link = &(*link)->next) {
+            if (*link != chain) continue;
+            *link = chain->next;
+            break;
+        }
+        chain->to = NULL;
+    }
+
+    block->code = NULL;
+    block->hits = 0;
+    cpu->jit->exec.dropped = 1;
+}
+
+// Runs block (and whatever it chains into) natively, returns how many cycles it charged
+uint64_t jit_run_block(struct cpu *cpu, struct block *block, uint64_t cycles) {
+    struct jit *jit = cpu->jit;
+
+    if (!block->code) {
+        if (++block->hits < JIT_HOT_THRESHOLD) return 0;
+        jit_translate(cpu, block);
+        if (!block->code) return 0;
+    }
+
+    jit->exec.budget = cycles;
+    jit->exec.dropped = 0;
+    jit->entries++;
+    ((void (*)(struct cpu *, struct jit_exec *)) block->code)(cpu, &jit->exec);
+
+    // A taken branch can overdraw the budget by its penalty
+    uint64_t spent = cycles - jit->exec.budget;
+    cpu->cycles += spent;
+    return spent;
+}
+
+#endif
\ No newline at end of file
@@ -1,18 +1,282 @@
+#define _GNU_SOURCE
+
 #include <cpu/cpu.h>
 #include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/debug.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Unmapped pages read as 0xFF, kept in the backing so word reads straddling into them stay correct
+static inline uint8_t memory_backed_read(struct memory *memory, uint32_t page) {
+    return memory->read_map[page] || memory->type[page] == MEMORY_UNMAPPED;
+}
+
+static void memory_update_word_maps(struct memory *memory, uint32_t page) {
+    uint32_t next = (page + 1) % MEMORY_PAGES;
+    uint8_t contiguous = next != 0 || memory->mirrored;
+
+    memory->read_word_map[page] = contiguous && memory_backed_read(memory, next) ? memory->read_map[page] : NULL;
+    memory->write_word_map[page] = contiguous && memory->write_map[next] ? memory->write_map[page] : NULL;
+}
+
+// Recomputes the fast path pointers of a page from its type and traps
+static void memory_update_page(struct cpu *cpu, uint32_t page) {
+    struct memory *memory = &cpu->memory;
+    uint8_t *host = memory->backing + (page << MEMORY_PAGE_SHIFT);
+
+    switch (memory->type[page]) {
+        case MEMORY_RAM:
+            memory->read_map[page] = memory->traps[page] & MEMORY_TRAP_WATCH_READ ? NULL : host;
+            memory->write_map[page] = memory->traps[page] & MEMORY_TRAPS_WRITE ? NULL : host;
+            break;
+        case MEMORY_ROM:
+            memory->read_map[page] = memory->traps[page] & MEMORY_TRAP_WATCH_READ ? NULL : host;
+            memory->write_map[page] = NULL;
+            break;
+        default:
+            memory->read_map[page] = NULL;
+            memory->write_map[page] = NULL;
+            break;
+    }
+
+    if (memory->type[page] == MEMORY_UNMAPPED) memset(host, 0xff, MEMORY_PAGE_SIZE);
+
+    memory_update_word_maps(memory, page);
+    memory_update_word_maps(memory, (page + MEMORY_PAGES - 1) % MEMORY_PAGES);
+}
+
+static void memory_map(struct cpu *cpu, uint32_t base, uint32_t size, uint8_t type, const struct memory_mmio *mmio) {
+    for (uint32_t page = base >> MEMORY_PAGE_SHIFT; page < MEMORY_PAGES && page < (base + size + MEMORY_PAGE_SIZE - 1) >> MEMORY_PAGE_SHIFT; page++) {
+        // Leaving unmapped drops the 0xFF filler
+        if (cpu->memory.type[page] == MEMORY_UNMAPPED)
+            memset(cpu->memory.backing + (page << MEMORY_PAGE_SHIFT), 0, MEMORY_PAGE_SIZE);
+
+        cpu->memory.type[page] = type;
+        if (mmio) cpu->memory.mmio[page] = *mmio;
+        memory_update_page(cpu, page);
+    }
+}
+
+#ifdef __linux__
+/*
+    The 1MB is a memfd mapped twice back to back with a guard page after it, so a word
+    at FFFFFh reads its high byte from 00000h straight out of the host mapping and
+    nothing running off the end can land in another allocation.
+ */
+static int memory_create_mirror(struct memory *memory) {
+    size_t reserved = 2 * MEMORY_SIZE + MEMORY_PAGE_SIZE;
+    uint8_t *base = mmap(NULL, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return -1;
+
+    int fd = memfd_create("8086win-memory", MFD_CLOEXEC);
+    if (fd < 0 || ftruncate(fd, MEMORY_SIZE) < 0) goto fail;
+
+    for (size_t i = 0; i < 2; i++) {
+        void *view = mmap(base + i * MEMORY_SIZE, MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        if (view == MAP_FAILED) goto fail;
+    }
+
+    close(fd);
+    memory->backing = base;
+    memory->reserved = reserved;
+    memory->mirrored = 1;
+    return 0;
+
+fail:
+    if (fd >= 0) close(fd);
+    munmap(base, reserved);
+    return -1;
+}
+#endif
+
+int memory_create(struct cpu *cpu) {
+    struct memory *memory = &cpu->memory;
+
+#ifdef __linux__
+    if (memory_create_mirror(memory) < 0)
+#endif
+    {
+        // Without the mirror the word maps fall back to the slow path at the 1MB wrap
+        memory->backing = calloc(1, MEMORY_SIZE + 1);
+        if (!memory->backing) return -1;
+        memory->reserved = 0;
+        memory->mirrored = 0;
+    }
+
+    for (uint32_t page = 0; page < MEMORY_PAGES; page++) {
+        memory->type[page] = MEMORY_UNMAPPED;
+        memory_update_page(cpu, page);
+    }
+    return 0;
+}
+
+void memory_destroy(struct cpu *cpu) {
+    struct memory *memory = &cpu->memory;
+
+#ifdef __linux__
+    if (memory->mirrored) munmap(memory->backing, memory->reserved);
+    else
+#endif
+    free(memory->backing);
+    memory->backing = NULL;
+}
+
+void memory_map_ram(struct cpu *cpu, uint32_t base, uint32_t size) {
+    memory_map(cpu, base, size, MEMORY_RAM, NULL);
+}
+
+void memory_map_rom(struct cpu *cpu, uint32_t base, uint32_t size) {
+    memory_map(cpu, base, size, MEMORY_ROM, NULL);
+}
+
+void memory_map_mmio(struct cpu *cpu, uint32_t base, uint32_t size, const struct memory_mmio *mmio) {
+    memory_map(cpu, base, size, MEMORY_MMIO, mmio);
+}
+
+// First write to a page since the snapshot, later writes to it take the fast path again
+static void memory_mark_dirty(struct cpu *cpu, uint32_t page) {
+    cpu->memory.dirty_pages[cpu->memory.dirty_count++] = page;
+    memory_clear_trap(cpu, page, MEMORY_TRAP_DIRTY);
+}
+
+// Arms a dirty trap on every RAM page so writes relative to base can be found later
+void memory_track_dirty(struct cpu *cpu, const struct snapshot *base) {
+    cpu->memory.dirty_base = base;
+    cpu->memory.dirty_count = 0;
+
+    for (uint32_t page = 0; page < MEMORY_PAGES; page++)
+        if (cpu->memory.type[page] == MEMORY_RAM) memory_set_trap(cpu, page, MEMORY_TRAP_DIRTY);
+}
+
+// Watches writes to RAM in [base, base + size) at page granularity, a NULL notify stops watching
+void memory_set_notify(struct cpu *cpu, uint32_t base, uint32_t size, const struct memory_notify *notify) {
+    for (uint32_t page = base >> MEMORY_PAGE_SHIFT; page < MEMORY_PAGES && page < (base + size + MEMORY_PAGE_SIZE - 1) >> MEMORY_PAGE_SHIFT; page++) {
+        if (notify) {
+            cpu->memory.notify[page] = *notify;
+            memory_set_trap(cpu, page, MEMORY_TRAP_NOTIFY);
+        } else {
+            cpu->memory.notify[page] = (struct memory_notify) {0};
+            memory_clear_trap(cpu, page, MEMORY_TRAP_NOTIFY);
+        }
+    }
+}
 
-uint8_t memory_read_byte(struct cpu *cpu, uintptr_t addr) {
-    return (*(uint8_t*)(cpu->memory + addr));
+// Hands [addr, addr + size) to the watchers of the pages it covers, one call per page
+void memory_notify_write(struct cpu *cpu, uint32_t addr, uint32_t size) {
+    uint32_t end = addr + size;
+    while (addr < end) {
+        uint32_t page = (addr >> MEMORY_PAGE_SHIFT) % MEMORY_PAGES;
+        uint32_t chunk = MEMORY_PAGE_SIZE - (addr & (MEMORY_PAGE_SIZE - 1));
+        if (chunk > end - addr) chunk = end - addr;
+        if ((cpu->memory.traps[page] & MEMORY_TRAP_NOTIFY) && cpu->memory.notify[page].write)
+            cpu->memory.notify[page].write(cpu->memory.notify[page].ctx, addr & MEMORY_MASK, chunk);
+        addr += chunk;
+    }
 }
 
-uint16_t memory_read_word(struct cpu *cpu, uintptr_t addr) {
-    return (*(uint16_t *)(cpu->memory + addr));
+// Host side copy into RAM or ROM, e.g. to place a program or a ROM image
+void memory_load(struct cpu *cpu, uint32_t addr, const void *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        uint32_t target = (addr + i) & MEMORY_MASK;
+        uint8_t type = cpu->memory.type[target >> MEMORY_PAGE_SHIFT];
+        if (type != MEMORY_RAM && type != MEMORY_ROM) continue;
+        if (cpu->memory.traps[target >> MEMORY_PAGE_SHIFT] & MEMORY_TRAP_DIRTY) memory_mark_dirty(cpu, target >> MEMORY_PAGE_SHIFT);
+        cpu->memory.backing[target] = ((const uint8_t *) data)[i];
+        block_notify_write(cpu, target, 1);
+        if (cpu->memory.traps[target >> MEMORY_PAGE_SHIFT] & MEMORY_TRAP_NOTIFY) memory_notify_write(cpu, target, 1);
+    }
 }
 
-void memory_write_byte(struct cpu *cpu, uintptr_t addr, uint8_t byte) {
-    (*(uint8_t*)(cpu->memory + addr)) = byte;
+// Host pointer covering [addr, addr + size) when all of it is plain memory, NULL otherwise. For writes
+// every page has to be RAM, and dirty and code traps are serviced up front so the caller can write
+// through the pointer without going page by page. Watchers hear about the write before it happens.
+uint8_t *memory_span(struct cpu *cpu, uint32_t addr, uint32_t size, int write) {
+    if (!size || addr + size > MEMORY_SIZE) return NULL;
+
+    for (uint32_t page = addr >> MEMORY_PAGE_SHIFT; page <= (addr + size - 1) >> MEMORY_PAGE_SHIFT; page++) {
+        if (!write) {
+            if (!cpu->memory.read_map[page]) return NULL;
+            continue;
+        }
+
+        // A watched page has to see each byte, the caller's fallback goes through memory_write_byte
+        if (cpu->memory.type[page] != MEMORY_RAM || (cpu->memory.traps[page] & MEMORY_TRAP_WATCH_WRITE)) return NULL;
+        if (cpu->memory.traps[page] & MEMORY_TRAP_DIRTY) memory_mark_dirty(cpu, page);
+        if (cpu->memory.traps[page] & MEMORY_TRAP_CODE) {
+            uint32_t first = addr > page << MEMORY_PAGE_SHIFT ? addr : page << MEMORY_PAGE_SHIFT;
+            uint32_t last = addr + size < (page + 1) << MEMORY_PAGE_SHIFT ? addr + size : (page + 1) << MEMORY_PAGE_SHIFT;
+            block_notify_write(cpu, first, last - first);
+        }
+        if (cpu->memory.traps[page] & MEMORY_TRAP_NOTIFY) continue;
+        if (!cpu->memory.write_map[page]) return NULL;
+    }
+
+    if (write) memory_notify_write(cpu, addr, size);
+    return cpu->memory.backing + addr;
+}
+
+void memory_set_trap(struct cpu *cpu, uint32_t page, uint8_t trap) {
+    cpu->memory.traps[page] |= trap;
+    memory_update_page(cpu, page);
+}
+
+void memory_clear_trap(struct cpu *cpu, uint32_t page, uint8_t trap) {
+    cpu->memory.traps[page] &= ~trap;
+    memory_update_page(cpu, page);
 }
 
-void memory_write_word(struct cpu *cpu, uintptr_t addr, uint16_t word) {
-    (*(uint16_t *)(cpu->memory + addr)) = word;
+uint8_t memory_read_byte_slow(struct cpu *cpu, uint32_t addr) {
+    uint32_t page = addr >> MEMORY_PAGE_SHIFT;
+
+    switch (cpu->memory.type[page]) {
+        case MEMORY_RAM:
+        case MEMORY_ROM:
+            if (cpu->memory.traps[page] & MEMORY_TRAP_WATCH_READ) debug_watch_hit(cpu, addr, 0);
+            return cpu->memory.backing[addr];
+        case MEMORY_UNMAPPED:
+            return cpu->memory.backing[addr];
+        case MEMORY_MMIO:
+            if (cpu->memory.mmio[page].read) return cpu->memory.mmio[page].read(cpu->memory.mmio[page].ctx, addr);
+            return 0xff;
+        default:
+            return 0xff;
+    }
+}
+
+uint16_t memory_read_word_slow(struct cpu *cpu, uint32_t addr) {
+    uint8_t lo = memory_read_byte(cpu, addr);
+    uint8_t hi = memory_read_byte(cpu, (addr + 1) & MEMORY_MASK);
+    return hi << 8 | lo;
 }
+
+void memory_write_byte_slow(struct cpu *cpu, uint32_t addr, uint8_t byte) {
+    uint32_t page = addr >> MEMORY_PAGE_SHIFT;
+
+    switch (cpu->memory.type[page]) {
+        case MEMORY_RAM:
+            if (cpu->memory.traps[page] & MEMORY_TRAP_DIRTY) memory_mark_dirty(cpu, page);
+            if (cpu->memory.traps[page] & MEMORY_TRAP_CODE) block_notify_write(cpu, addr, 1);
+            cpu->memory.backing[addr] = byte;
+            if (cpu->memory.traps[page] & MEMORY_TRAP_NOTIFY) memory_notify_write(cpu, addr, 1);
+            if (cpu->memory.traps[page] & MEMORY_TRAP_WATCH_WRITE) debug_watch_hit(cpu, addr, 1);
+            return;
+        case MEMORY_MMIO:
+            if (cpu->memory.mmio[page].write) cpu->memory.mmio[page].write(cpu->memory.mmio[page].ctx, addr, byte);
+            return;
+        default:
+            // ROM and unmapped writes go nowhere
+            return;
+    }
+}
+
+void memory_write_word_slow(struct cpu *cpu, uint32_t addr, uint16_t word) {
+    memory_write_byte(cpu, addr, word & 0xff);
+    memory_write_byte(cpu, (addr + 1) & MEMORY_MASK, word >> 8);
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include <cpu/modrm.h>
+
+#define MODRM_MOD(m) ((m) >> 6)
+#define MODRM_RM(m) ((m) & 7)
+// mod 00 with r/m 110 is a bare disp16 rather than [bp]
+#define MODRM_DIRECT(m) (MODRM_MOD(m) == 0 && MODRM_RM(m) == 6)
+
+#define MODRM_BASE(m) (MODRM_MOD(m) == 3 || MODRM_DIRECT(m) || MODRM_RM(m) == 4 || MODRM_RM(m) == 5 ? MODRM_NONE : \
+        MODRM_RM(m) == 2 || MODRM_RM(m) == 3 || MODRM_RM(m) == 6 ? CPU_REG_BP : CPU_REG_BX)
+#define MODRM_INDEX(m) (MODRM_MOD(m) == 3 || MODRM_RM(m) > 5 ? MODRM_NONE : MODRM_RM(m) & 1 ? CPU_REG_DI : CPU_REG_SI)
+#define MODRM_DISP(m) (MODRM_MOD(m) == 1 ? 1 : MODRM_MOD(m) == 2 || MODRM_DIRECT(m) ? 2 : 0)
+#define MODRM_SEGMENT(m) (MODRM_BASE(m) == CPU_REG_BP ? CPU_SREG_SS : CPU_SREG_DS)
+
+// 8086 effective address clocks: base or index 5, direct 6, base+index 7 or 8, plus 4 for a displacement
+#define MODRM_CYCLES(m) (MODRM_MOD(m) == 3 ? 0 : MODRM_DIRECT(m) ? 6 : \
+        (MODRM_RM(m) > 3 ? 5 : MODRM_RM(m) == 0 || MODRM_RM(m) == 3 ? 7 : 8) + (MODRM_MOD(m) ? 4 : 0))
+
+#define MODRM(m) {MODRM_MOD(m) != 3, MODRM_BASE(m), MODRM_INDEX(m), MODRM_DISP(m), MODRM_SEGMENT(m), MODRM_CYCLES(m)}
+#define MODRM_ROW(m) MODRM(m), MODRM(m + 1), MODRM(m + 2), MODRM(m + 3), \
+        MODRM(m + 4), MODRM(m + 5), MODRM(m + 6), MODRM(m + 7)
+#define MODRM_ROWS(m) MODRM_ROW(m), MODRM_ROW(m + 8), MODRM_ROW(m + 16), MODRM_ROW(m + 24), \
+        MODRM_ROW(m + 32), MODRM_ROW(m + 40), MODRM_ROW(m + 48), MODRM_ROW(m + 56)
+
+const struct modrm_desc modrm_table[256] = {
+        MODRM_ROWS(0x00), MODRM_ROWS(0x40), MODRM_ROWS(0x80), MODRM_ROWS(0xc0)
+};
\ No newline at end of file
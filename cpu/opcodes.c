@@ -1,1402 +1,2235 @@
 #include <cpu/opcodes.h>
 #include <cpu/memory.h>
+#include <cpu/modrm.h>
+#include <cpu/flags.h>
+#include <cpu/trace.h>
+#include <cpu/profile.h>
+#include <cpu/string.h>
+#include <cpu/io.h>
 
-#include <stdio.h>
+#include <string.h>
 
-#define debug_print printf
-
-static const uint8_t parity_table[0x100] = {
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
-        1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
-        0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 1,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 0,
-        1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 1};
+#define debug_print(...) trace_print(cpu, __VA_ARGS__)
 
+// Only two bits select a segment register, the 8086 ignores the third
 static inline uint16_t opcode_get_segment_register(struct cpu *cpu, uint8_t reg_id) {
-    switch (reg_id) {
-        case 0: return cpu->reg.es;
-        case 1: return cpu->reg.cs;
-        case 2: return cpu->reg.ss;
-        case 3: return cpu->reg.ds;
-        case 4:
-        case 5:
-        case 6:
-        case 7: return cpu->reg.es;
-        default: return -1;
-    }
+    return cpu->reg.sreg[reg_id & 3];
 }
 
 static inline uint8_t opcode_get_byte_register(struct cpu *cpu, uint8_t reg_id)  {
-    switch (reg_id) {
-        case 0: return cpu->reg.ax[0];
-        case 1: return cpu->reg.cx[0];
-        case 2: return cpu->reg.dx[0];
-        case 3: return cpu->reg.bx[0];
-        case 4: return cpu->reg.ax[1];
-        case 5: return cpu->reg.cx[1];
-        case 6: return cpu->reg.dx[1];
-        case 7: return cpu->reg.bx[1];
-        default: return -1;
-    }
+    return cpu->reg.gpr8[CPU_REG8(reg_id)];
 }
 
 static inline uint16_t opcode_get_word_register(struct cpu *cpu, uint8_t reg_id)  {
-    switch (reg_id) {
-        case 0: return opcode_reg8_to_reg16(cpu->reg.ax);
-        case 1: return opcode_reg8_to_reg16(cpu->reg.cx);
-        case 2: return opcode_reg8_to_reg16(cpu->reg.dx);
-        case 3: return opcode_reg8_to_reg16(cpu->reg.bx);
-        case 4: return cpu->reg.sp;
-        case 5: return cpu->reg.bp;
-        case 6: return cpu->reg.si;
-        case 7: return cpu->reg.di;
-        default: return -1;
-    }
+    return cpu->reg.gpr[reg_id];
 }
 
+// A new CS moves the linear fetch address along with it, a new SS holds interrupts off so SP can follow
 static inline void opcode_set_segment_register(struct cpu *cpu, uint8_t reg_id, uint16_t val) {
-    switch (reg_id) {
-        case 0: cpu->reg.es = val; return;
-        case 1: cpu->reg.cs = val; return;
-        case 2: cpu->reg.ss = val; return;
-        case 3: cpu->reg.ds = val; return;
-        case 4:
-        case 5:
-        case 6:
-        case 7: cpu->reg.es = val; return;
-        default: return;
-    }
+    cpu->reg.sreg[reg_id & 3] = val;
+    if ((reg_id & 3) == CPU_SREG_CS) cpu->reg.ip32 = (cpu->reg.cs * 16 + cpu->reg.ip) & MEMORY_MASK;
+    if ((reg_id & 3) == CPU_SREG_SS) cpu->state |= CPU_SHADOW;
 }
 
 static inline void opcode_set_byte_register(struct cpu *cpu, uint8_t reg_id, uint8_t val)  {
-    switch (reg_id) {
-        case 0: cpu->reg.ax[0] = val; return;
-        case 1: cpu->reg.cx[0] = val; return;
-        case 2: cpu->reg.dx[0] = val; return;
-        case 3: cpu->reg.bx[0] = val; return;
-        case 4: cpu->reg.ax[1] = val; return;
-        case 5: cpu->reg.cx[1] = val; return;
-        case 6: cpu->reg.dx[1] = val; return;
-        case 7: cpu->reg.bx[1] = val; return;
-        default: return;
-    }
+    cpu->reg.gpr8[CPU_REG8(reg_id)] = val;
 }
 
 static inline void opcode_set_word_register(struct cpu *cpu, uint8_t reg_id, uint16_t val)  {
-    switch (reg_id) {
-        case 0: opcode_set_reg16_val(cpu->reg.ax, val); return;
-        case 1: opcode_set_reg16_val(cpu->reg.cx, val); return;
-        case 2: opcode_set_reg16_val(cpu->reg.dx, val); return;
-        case 3: opcode_set_reg16_val(cpu->reg.bx, val); return;
-        case 4: cpu->reg.sp = val; return;
-        case 5: cpu->reg.bp = val; return;
-        case 6: cpu->reg.si = val; return;
-        case 7: cpu->reg.di = val; return;
-        default: return;
-    }
-}
-
-static inline uint8_t opcode_get_byte_registers_offset(struct cpu *cpu, uint8_t reg_id, uint16_t nex_op) {
-    switch (reg_id) {
-        case 0: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si + nex_op);
-        case 1: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di + nex_op);
-        case 2: return memory_read_byte(cpu, cpu->reg.bp + cpu->reg.si + nex_op);
-        case 3: return memory_read_byte(cpu, cpu->reg.bp + cpu->reg.di + nex_op);
-        case 4: return memory_read_byte(cpu, cpu->reg.si + nex_op);
-        case 5: return memory_read_byte(cpu, cpu->reg.bp + nex_op);
-        case 6: return memory_read_byte(cpu, cpu->reg.di + nex_op);
-        case 7: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + nex_op);
-        default: return -1;
-    }
-}
-
-static inline uint8_t opcode_get_byte_registers(struct cpu *cpu, uint8_t reg_id) {
-    switch (reg_id) {
-        case 0: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si);
-        case 1: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di);
-        case 2: return memory_read_byte(cpu, cpu->reg.bp + cpu->reg.si);
-        case 3: return memory_read_byte(cpu, cpu->reg.bp + cpu->reg.di);
-        case 4: return memory_read_byte(cpu, cpu->reg.si);
-        case 5: return memory_read_byte(cpu, cpu->reg.bp);
-        case 6: return memory_read_byte(cpu, cpu->reg.di);
-        case 7: return memory_read_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx));
-        default: return -1;
-    }
-}
-
-static inline void opcode_set_byte_registers_offset(struct cpu *cpu, uint8_t reg_id, uint16_t nex_op, uint8_t byte) {
-    switch (reg_id) {
-        case 0: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si + nex_op, byte);
-        case 1: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di + nex_op, byte);
-        case 2: return memory_write_byte(cpu, cpu->reg.bp + cpu->reg.si + nex_op, byte);
-        case 3: return memory_write_byte(cpu, cpu->reg.bp + cpu->reg.di + nex_op, byte);
-        case 4: return memory_write_byte(cpu, cpu->reg.si + nex_op, byte);
-        case 5: return memory_write_byte(cpu, cpu->reg.bp + nex_op, byte);
-        case 6: return memory_write_byte(cpu, cpu->reg.di + nex_op, byte);
-        case 7: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + nex_op, byte);
-        default: return;
-    }
-}
-
-static inline void opcode_set_byte_registers(struct cpu *cpu, uint8_t reg_id, uint8_t byte) {
-    switch (reg_id) {
-        case 0: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si, byte);
-        case 1: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di, byte);
-        case 2: return memory_write_byte(cpu, cpu->reg.bp + cpu->reg.si, byte);
-        case 3: return memory_write_byte(cpu, cpu->reg.bp + cpu->reg.di, byte);
-        case 4: return memory_write_byte(cpu, cpu->reg.si, byte);
-        case 5: return memory_write_byte(cpu, cpu->reg.bp, byte);
-        case 6: return memory_write_byte(cpu, cpu->reg.di, byte);
-        case 7: return memory_write_byte(cpu, opcode_reg8_to_reg16(cpu->reg.bx), byte);
-        default: return;
-    }
-}
-
-static inline uint16_t opcode_get_word_registers_offset(struct cpu *cpu, uint8_t reg_id, uint16_t nex_op) {
-    switch (reg_id) {
-        case 0: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si + nex_op);
-        case 1: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di + nex_op);
-        case 2: return memory_read_word(cpu, cpu->reg.bp + cpu->reg.si + nex_op);
-        case 3: return memory_read_word(cpu, cpu->reg.bp + cpu->reg.di + nex_op);
-        case 4: return memory_read_word(cpu, cpu->reg.si + nex_op);
-        case 5: return memory_read_word(cpu, cpu->reg.bp + nex_op);
-        case 6: return memory_read_word(cpu, cpu->reg.di + nex_op);
-        case 7: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + nex_op);
-        default: return -1;
-    }
-}
-
-static inline uint16_t opcode_get_word_registers(struct cpu *cpu, uint8_t reg_id) {
-    switch (reg_id) {
-        case 0: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si);
-        case 1: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di);
-        case 2: return memory_read_word(cpu, cpu->reg.bp + cpu->reg.si);
-        case 3: return memory_read_word(cpu, cpu->reg.bp + cpu->reg.di);
-        case 4: return memory_read_word(cpu, cpu->reg.si);
-        case 5: return memory_read_word(cpu, cpu->reg.bp);
-        case 6: return memory_read_word(cpu, cpu->reg.di);
-        case 7: return memory_read_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx));
-        default: return -1;
-    }
-}
-
-static inline void opcode_set_word_registers_offset(struct cpu *cpu, uint8_t reg_id, uint16_t nex_op, uint16_t word) {
-    switch (reg_id) {
-        case 0: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si + nex_op, word);
-        case 1: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di + nex_op, word);
-        case 2: return memory_write_word(cpu, cpu->reg.bp + cpu->reg.si + nex_op, word);
-        case 3: return memory_write_word(cpu, cpu->reg.bp + cpu->reg.di + nex_op, word);
-        case 4: return memory_write_word(cpu, cpu->reg.si + nex_op, word);
-        case 5: return memory_write_word(cpu, cpu->reg.bp + nex_op, word);
-        case 6: return memory_write_word(cpu, cpu->reg.di + nex_op, word);
-        case 7: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + nex_op, word);
-        default: return;
-    }
-}
-
-static inline void opcode_set_word_registers(struct cpu *cpu, uint8_t reg_id, uint16_t word) {
-    switch (reg_id) {
-        case 0: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.si, word);
-        case 1: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx) + cpu->reg.di, word);
-        case 2: return memory_write_word(cpu, cpu->reg.bp + cpu->reg.si, word);
-        case 3: return memory_write_word(cpu, cpu->reg.bp + cpu->reg.di, word);
-        case 4: return memory_write_word(cpu, cpu->reg.si, word);
-        case 5: return memory_write_word(cpu, cpu->reg.bp, word);
-        case 6: return memory_write_word(cpu, cpu->reg.di, word);
-        case 7: return memory_write_word(cpu, opcode_reg8_to_reg16(cpu->reg.bx), word);
-        default: return;
-    }
-}
-
-static inline uint8_t opcode_decode_mod_rm8l_and_read(struct cpu *cpu, uint8_t reg_id) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_get_byte_register(cpu, reg_id & ((1 << 3) - 1));
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_byte_registers_offset(cpu, reg_id & ((1 << 3) - 1), ((nex_op1 << 8) & (nex_op & 0xff)));
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_byte_registers_offset(cpu, reg_id & ((1 << 3) - 1), nex_op);
-        case 0b00:
-            return opcode_get_byte_registers(cpu, reg_id & ((1 << 3) - 1));
-        default:
-            return -1;
-    }
-}
-
-static inline uint8_t opcode_decode_mod_rm8h_and_read(struct cpu *cpu, uint8_t reg_id) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_get_byte_register(cpu, ((reg_id & 0b00111000) >> 3));
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), ((nex_op1 << 8) & (nex_op & 0xff)));
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), nex_op);
-        case 0b00:
-            return opcode_get_byte_registers(cpu, ((reg_id & 0b00111000) >> 3));
-        default:
-            return -1;
-    }
-}
-
-static inline void opcode_decode_mod_rm8l_and_write(struct cpu *cpu, uint8_t reg_id, uint8_t val) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_set_byte_register(cpu, reg_id & ((1 << 3) - 1), val);
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, reg_id & ((1 << 3) - 1), ((nex_op1 << 8) & (nex_op & 0xff)), val);
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, reg_id & ((1 << 3) - 1), nex_op, val);
-        case 0b00:
-            return opcode_set_byte_registers(cpu, reg_id & ((1 << 3) - 1), val);
-        default:
-            return;
-    }
-}
-
-static inline void opcode_decode_mod_rm8h_and_write(struct cpu *cpu, uint8_t reg_id, uint8_t val) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_set_byte_register(cpu, ((reg_id & 0b00111000) >> 3), val);
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), ((nex_op1 << 8) & (nex_op & 0xff)), val);
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), nex_op, val);
-        case 0b00:
-            return opcode_set_byte_registers(cpu, ((reg_id & 0b00111000) >> 3), val);
-        default:
-            return;
-    }
-}
-
-static inline uint16_t opcode_decode_mod_rm16l_and_read(struct cpu *cpu, uint8_t reg_id) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_get_word_register(cpu, reg_id & ((1 << 3) - 1));
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_word_registers_offset(cpu, reg_id & ((1 << 3) - 1), ((nex_op1 << 8) & (nex_op & 0xff)));
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_word_registers_offset(cpu, reg_id & ((1 << 3) - 1), nex_op);
-        case 0b00:
-            return opcode_get_word_registers(cpu, reg_id & ((1 << 3) - 1));
-        default:
-            return -1;
-    }
-}
-
-static inline uint16_t opcode_decode_mod_rm16h_and_read(struct cpu *cpu, uint8_t reg_id) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_get_word_register(cpu, ((reg_id & 0b00111000) >> 3));
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_word_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), ((nex_op1 << 8) & (nex_op & 0xff)));
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_get_word_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), nex_op);
-        case 0b00:
-            return opcode_get_word_registers(cpu, ((reg_id & 0b00111000) >> 3));
-        default:
-            return -1;
-    }
-}
-
-static inline void opcode_decode_mod_rm16l_and_write(struct cpu *cpu, uint8_t reg_id, uint16_t val) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_set_word_register(cpu, reg_id & ((1 << 3) - 1), val);
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_word_registers_offset(cpu, reg_id & ((1 << 3) - 1), ((nex_op1 << 8) & (nex_op & 0xff)), val);
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_word_registers_offset(cpu, reg_id & ((1 << 3) - 1), nex_op, val);
-        case 0b00:
-            return opcode_set_word_registers(cpu, reg_id & ((1 << 3) - 1), val);
-        default:
-            return;
-    }
-}
-
-static inline void opcode_decode_mod_rm16h_and_write(struct cpu *cpu, uint8_t reg_id, uint8_t val) {
-    uint8_t nex_op = 0, nex_op1 = 0;
-    switch (reg_id >> 6) {
-        case 0b11:
-            return opcode_set_byte_register(cpu, ((reg_id & 0b00111000) >> 3), val);
-        case 0b10:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op1 = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), ((nex_op1 << 8) & (nex_op & 0xff)), val);
-        case 0b01:
-            cpu->reg.ip++;
-            cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
-            nex_op = memory_read_byte(cpu, cpu->reg.ip32);
-            return opcode_set_byte_registers_offset(cpu, ((reg_id & 0b00111000) >> 3), nex_op, val);
-        case 0b00:
-            return opcode_set_byte_registers(cpu, ((reg_id & 0b00111000) >> 3), val);
-        default:
-            return;
-    }
+    cpu->reg.gpr[reg_id] = val;
 }
 
+// SP points at the last word pushed, the same frame layout INT and IRET work with
 static inline void opcode_push(struct cpu *cpu, uint16_t val) {
-    memory_write_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp, val);
     cpu->reg.sp -= 2;
+    memory_write_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp, val);
 }
 
 static inline uint16_t opcode_pop(struct cpu *cpu) {
-    cpu->reg.sp += 2;
     uint16_t t = memory_read_word(cpu, cpu->reg.ss * 16 + cpu->reg.sp);
+    cpu->reg.sp += 2;
     return t;
 }
 
-static inline void opcode_set_flags_based_on_result(struct cpu *cpu, uint16_t val) {
-    if (!val) cpu->reg.flags |= CPU_FLAGS_ZERO;
-    else cpu->reg.flags &= ~(CPU_FLAGS_ZERO);
-
-    if (val & 0x8000) { cpu->reg.flags |= CPU_FLAGS_SIGN; }
-    else { cpu->reg.flags &= ~(CPU_FLAGS_SIGN); }
-
-    if (parity_table[val & 0xff]) { cpu->reg.flags |= CPU_FLAGS_PARITY; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_PARITY);
-}
-
 static inline uint16_t opcode_add(struct cpu *cpu, uint16_t a, uint16_t b) {
     uint32_t res = a + b;
-
-    opcode_set_flags_based_on_result(cpu, res);
-
-    if (res & 0xFFFF0000) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
-
-    if (((res ^ a) & (res ^ b) & 0x8000) == 0x8000) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
+    flags_set_lazy(cpu, FLAGS_OP_ADD, 16, a, b, res);
     return res;
 }
 
 static inline uint16_t opcode_sub(struct cpu *cpu, uint16_t a, uint16_t b) {
     uint32_t res = a - b;
-
-    opcode_set_flags_based_on_result(cpu, res);
-
-    if (res & 0xFFFF0000) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
-
-    if (((res ^ a) & (a ^ b) & 0x8000) == 0x8000) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
+    flags_set_lazy(cpu, FLAGS_OP_SUB, 16, a, b, res);
     return res;
 }
 
 static inline uint16_t opcode_add8(struct cpu *cpu, uint8_t a, uint8_t b) {
     uint32_t res = a + b;
-
-    opcode_set_flags_based_on_result(cpu, res);
-
-    if (res & 0xFF00) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
-
-    if (((res ^ a) & (res ^ b) & 0x80) == 0x80) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
+    flags_set_lazy(cpu, FLAGS_OP_ADD, 8, a, b, res);
     return res;
 }
 
 static inline uint16_t opcode_adc(struct cpu *cpu, uint16_t a, uint16_t b) {
-    uint32_t res = a + b + (cpu->reg.flags & CPU_FLAGS_CARRY);
-
-    opcode_set_flags_based_on_result(cpu, res);
-
-    if (res & 0xFFFF0000) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
-
-    if (((res ^ a) & (res ^ b) & 0x8000) == 0x8000) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
+    uint32_t res = a + b + flags_get_carry(cpu);
+    flags_set_lazy(cpu, FLAGS_OP_ADD, 16, a, b, res);
     return res;
 }
 
 static inline uint16_t opcode_subb(struct cpu *cpu, uint16_t a, uint16_t b) {
-    uint32_t res = a - (b + (cpu->reg.flags & CPU_FLAGS_CARRY));
-
-    opcode_set_flags_based_on_result(cpu, res);
-
-    if (res & 0xFFFF0000) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
-
-    if (((res ^ a) & (a ^ b) & 0x8000) == 0x8000) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
+    uint32_t res = a - (b + flags_get_carry(cpu));
+    flags_set_lazy(cpu, FLAGS_OP_SUB, 16, a, b, res);
     return res;
 }
 
 static inline uint16_t opcode_adc8(struct cpu *cpu, uint8_t a, uint8_t b) {
-    uint32_t res = a + b + (cpu->reg.flags & CPU_FLAGS_CARRY);
-
-    opcode_set_flags_based_on_result(cpu, res);
+    uint32_t res = a + b + flags_get_carry(cpu);
+    flags_set_lazy(cpu, FLAGS_OP_ADD, 8, a, b, res);
+    return res;
+}
 
-    if (res & 0xFF00) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
+static inline uint16_t opcode_subb8(struct cpu *cpu, uint8_t a, uint8_t b) {
+    uint32_t res = a - (b + flags_get_carry(cpu));
+    flags_set_lazy(cpu, FLAGS_OP_SUB, 8, a, b, res);
+    return res;
+}
 
-    if (((res ^ a) & (res ^ b) & 0x80) == 0x80) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
+static inline uint16_t opcode_sub8(struct cpu *cpu, uint8_t a, uint8_t b) {
+    uint32_t res = a - b;
+    flags_set_lazy(cpu, FLAGS_OP_SUB, 8, a, b, res);
+    return res;
+}
 
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+// INC and DEC leave CF alone, so carry it over from whatever set it last
+static inline uint16_t opcode_inc(struct cpu *cpu, uint16_t a) {
+    uint8_t carry = flags_get_carry(cpu);
+    uint32_t res = a + 1;
+    flags_set_lazy(cpu, FLAGS_OP_INC, 16, a, 1, res);
+    cpu->lazy.carry = carry;
+    return res;
+}
 
+static inline uint16_t opcode_dec(struct cpu *cpu, uint16_t a) {
+    uint8_t carry = flags_get_carry(cpu);
+    uint32_t res = a - 1;
+    flags_set_lazy(cpu, FLAGS_OP_DEC, 16, a, 1, res);
+    cpu->lazy.carry = carry;
     return res;
 }
 
-static inline uint16_t opcode_subb8(struct cpu *cpu, uint8_t a, uint8_t b) {
-    uint32_t res = a - (b + (cpu->reg.flags & CPU_FLAGS_CARRY));
+static inline void opcode_jump_short(struct cpu *cpu, uint8_t rel) {
+    cpu->reg.ip += (int8_t) rel;
+}
 
-    opcode_set_flags_based_on_result(cpu, res);
+// Byte offset bytes into the instruction being executed, for operands past op0 and op1
+static inline uint8_t opcode_fetch(struct cpu *cpu, uint8_t offset) {
+    return memory_fetch_byte(cpu, cpu->reg.cs * 16 + (uint16_t) (cpu->reg.ip + offset));
+}
 
-    if (res & 0xFF00) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
+static inline uint16_t opcode_fetch_word(struct cpu *cpu, uint8_t offset) {
+    return opcode_fetch(cpu, offset) | opcode_fetch(cpu, offset + 1) << 8;
+}
 
-    if (((res ^ a) & (a ^ b) & 0x80) == 0x80) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
+// Immediates follow the ModR/M byte and its displacement
+static inline uint8_t opcode_immediate8(struct cpu *cpu, uint8_t modrm) {
+    return opcode_fetch(cpu, 2 + modrm_table[modrm].disp);
+}
 
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+static inline uint16_t opcode_immediate16(struct cpu *cpu, uint8_t modrm) {
+    return opcode_fetch_word(cpu, 2 + modrm_table[modrm].disp);
+}
 
+static inline uint8_t opcode_inc8(struct cpu *cpu, uint8_t a) {
+    uint8_t carry = flags_get_carry(cpu);
+    uint32_t res = a + 1;
+    flags_set_lazy(cpu, FLAGS_OP_INC, 8, a, 1, res);
+    cpu->lazy.carry = carry;
     return res;
 }
 
-static inline uint16_t opcode_sub8(struct cpu *cpu, uint8_t a, uint8_t b) {
-    uint32_t res = a - b;
+static inline uint8_t opcode_dec8(struct cpu *cpu, uint8_t a) {
+    uint8_t carry = flags_get_carry(cpu);
+    uint32_t res = a - 1;
+    flags_set_lazy(cpu, FLAGS_OP_DEC, 8, a, 1, res);
+    cpu->lazy.carry = carry;
+    return res;
+}
 
-    opcode_set_flags_based_on_result(cpu, res);
+// Arithmetic flags as a logic op on res sets them (ZF, SF, PF, CF and OF clear), with CF and OF then put in by hand
+static inline void opcode_set_flags(struct cpu *cpu, uint8_t width, uint16_t res, uint16_t set) {
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, width, 0, 0, res);
+    flags_set(cpu, flags_get(cpu) | set);
+}
 
-    if (res & 0xFF00) { cpu->reg.flags |= CPU_FLAGS_CARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_CARRY);
+// Only CF and OF change, the rest stays whatever the last operation left
+static inline void opcode_set_carry_overflow(struct cpu *cpu, int carry, int overflow) {
+    uint16_t flags = flags_get(cpu) & ~(CPU_FLAGS_CARRY | CPU_FLAGS_OVERFLOW);
+    if (carry) flags |= CPU_FLAGS_CARRY;
+    if (overflow) flags |= CPU_FLAGS_OVERFLOW;
+    flags_set(cpu, flags);
+}
 
-    if (((res ^ a) & (a ^ b) & 0x80) == 0x80) { cpu->reg.flags |= CPU_FLAGS_OVERFLOW ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
+/*
+    The eight ALU operations in the order bits 3-5 of the opcode and the reg field of group 1
+    number them: ADD, OR, ADC, SBB, AND, SUB, XOR, CMP. CMP is a SUB whose result the caller
+    doesn't write back.
+ */
+#define OPCODE_ALU_CMP 7
 
-    if (((a ^ b ^ res) & 0x10) == 0x10) { cpu->reg.flags |= CPU_FLAGS_ACARRY ; }
-    else cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+static uint16_t opcode_alu(struct cpu *cpu, uint8_t operation, uint8_t width, uint16_t a, uint16_t b) {
+    uint16_t res;
 
+    switch (operation & 7) {
+        case 0: return width == 8 ? opcode_add8(cpu, a, b) : opcode_add(cpu, a, b);
+        case 2: return width == 8 ? opcode_adc8(cpu, a, b) : opcode_adc(cpu, a, b);
+        case 3: return width == 8 ? opcode_subb8(cpu, a, b) : opcode_subb(cpu, a, b);
+        case 5:
+        case 7: return width == 8 ? opcode_sub8(cpu, a, b) : opcode_sub(cpu, a, b);
+        case 1: res = a | b; break;
+        case 4: res = a & b; break;
+        default: res = a ^ b; break;
+    }
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, width, 0, 0, res);
     return res;
 }
 
+// A far or near transfer lands on IP after opcode_call has added the instruction length on
+static inline void opcode_jump(struct cpu *cpu, uint16_t ip, uint16_t length) {
+    cpu->reg.ip = ip - length;
+}
+
+// Divide overflow is INT 0 with the return address past the faulting instruction, as the 8086 pushes it
+static void opcode_divide_error(struct cpu *cpu, uint16_t length) {
+    cpu->reg.ip += length;
+    if (!cpu_hle(cpu, 0)) cpu_interrupt(cpu, 0);
+    cpu->reg.ip -= length;
+}
+
 // START OF OPCODE IMPLEMENTATIONS
 
-static void opcode_hlt(struct cpu *cpu) {
+// With IF set and a controller on INTR an interrupt can still wake us, the run loop waits for it
+static void opcode_hlt(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    if ((cpu->reg.flags & CPU_FLAGS_INTERRUPTS) && cpu->intc.acknowledge) {
+        cpu->state |= CPU_WAITING;
+        return;
+    }
     cpu->state |= CPU_HALTED;
     debug_print("[*] Halting the CPU\n");
 }
 
 static void opcode_xorrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a ^ b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_xorrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a ^ b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_andrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a & b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_andrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a & b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_orrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a | b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_orrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a | b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_addrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_add8(cpu, a, b);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_addrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_add(cpu, a, b);
 
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_adcrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_adc8(cpu, a, b);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_adcrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_adc(cpu, a, b);
 
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_subrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_sub8(cpu, a, b);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_subrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_sub(cpu, a, b);
 
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_cmprm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     opcode_sub8(cpu, a, b);
 }
 
 static void opcode_cmprm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     opcode_sub(cpu, a, b);
 }
 
 static void opcode_subbrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_subb8(cpu, a, b);
 
-    opcode_decode_mod_rm8l_and_write(cpu, op0, result);
+    modrm_write8(cpu, &rm, result);
 }
 
 static void opcode_subbrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_subb(cpu, a, b);
 
-    opcode_decode_mod_rm16l_and_write(cpu, op0, result);
+    modrm_write16(cpu, &rm, result);
 }
 
 static void opcode_xorr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a ^ b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_xorr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a ^ b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_andr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a & b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_andr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a & b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_orr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = a | b;
-    opcode_set_flags_based_on_result(cpu, result);
-
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_orr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = a | b;
-    opcode_set_flags_based_on_result(cpu, result);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
 
-    cpu->reg.flags &= ~(CPU_FLAGS_OVERFLOW);
-    cpu->reg.flags &= ~(CPU_FLAGS_ACARRY);
-
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_addr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_add8(cpu, a, b);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_addr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_add(cpu, a, b);
 
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_adcr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint8_t b = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
 
     uint8_t result = opcode_adc8(cpu, a, b);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_adcr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t b = opcode_get_word_register(cpu, (op0 >> 3) & 7);
 
     uint16_t result = opcode_adc(cpu, a, b);
 
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_subr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
+    uint8_t b = modrm_read8(cpu, &rm);
 
     uint8_t result = opcode_sub8(cpu, a, b);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_subr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = opcode_get_word_register(cpu, (op0 >> 3) & 7);
+    uint16_t b = modrm_read16(cpu, &rm);
 
     uint16_t result = opcode_sub(cpu, a, b);
 
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_cmpr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
+    uint8_t b = modrm_read8(cpu, &rm);
 
     opcode_sub8(cpu, a, b);
 }
 
 static void opcode_cmpr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = opcode_get_word_register(cpu, (op0 >> 3) & 7);
+    uint16_t b = modrm_read16(cpu, &rm);
 
     opcode_sub(cpu, a, b);
 }
 
 static void opcode_subbr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint8_t a = opcode_decode_mod_rm8l_and_read(cpu, op0);
-    uint8_t b = opcode_decode_mod_rm8h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = opcode_get_byte_register(cpu, (op0 >> 3) & 7);
+    uint8_t b = modrm_read8(cpu, &rm);
 
     uint8_t result = opcode_subb8(cpu, a, b);
 
-    opcode_decode_mod_rm8h_and_write(cpu, op0, result);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, result);
 }
 
 static void opcode_subbr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
-    uint16_t a = opcode_decode_mod_rm16l_and_read(cpu, op0);
-    uint16_t b = opcode_decode_mod_rm16h_and_read(cpu, op0);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = opcode_get_word_register(cpu, (op0 >> 3) & 7);
+    uint16_t b = modrm_read16(cpu, &rm);
 
     uint16_t result = opcode_subb(cpu, a, b);
 
-    opcode_decode_mod_rm16h_and_write(cpu, op0, result);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, result);
 }
 
-static void opcode_pushax(struct cpu *cpu) {
-    opcode_push(cpu,opcode_reg8_to_reg16(cpu->reg.ax));
+static void opcode_pushax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu,cpu->reg.ax);
 }
 
-static void opcode_pushcx(struct cpu *cpu) {
-    opcode_push(cpu,opcode_reg8_to_reg16(cpu->reg.cx));
+static void opcode_pushcx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu,cpu->reg.cx);
 }
-static void opcode_pushdx(struct cpu *cpu) {
-    opcode_push(cpu,opcode_reg8_to_reg16(cpu->reg.dx));
+static void opcode_pushdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu,cpu->reg.dx);
 }
-static void opcode_pushbx(struct cpu *cpu) {
-    opcode_push(cpu,opcode_reg8_to_reg16(cpu->reg.bx));
+static void opcode_pushbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu,cpu->reg.bx);
 }
 
-static void opcode_pushsp(struct cpu *cpu) {
+static void opcode_pushsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.sp);
 }
 
-static void opcode_pushbp(struct cpu *cpu) {
+static void opcode_pushbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.bp);
 }
-static void opcode_pushsi(struct cpu *cpu) {
+static void opcode_pushsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.si);
 }
-static void opcode_pushdi(struct cpu *cpu) {
+static void opcode_pushdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.di);
 }
 
-static void opcode_pushes(struct cpu *cpu) {
+static void opcode_pushes(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.es);
 }
 
-static void opcode_pushcs(struct cpu *cpu) {
+static void opcode_pushcs(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.cs);
 }
 
-static void opcode_pushds(struct cpu *cpu) {
+static void opcode_pushds(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.ds);
 }
 
-static void opcode_pushss(struct cpu *cpu) {
+static void opcode_pushss(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     opcode_push(cpu,cpu->reg.ss);
 }
 
-static void opcode_popax(struct cpu *cpu) {
-    uint16_t t =  opcode_pop(cpu);
-    opcode_set_reg16_val(cpu->reg.ax, t);
+static void opcode_popax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = opcode_pop(cpu);
 }
 
-static void opcode_popcx(struct cpu *cpu) {
-    uint16_t t =  opcode_pop(cpu);
-    opcode_set_reg16_val(cpu->reg.cx, t);
+static void opcode_popcx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx = opcode_pop(cpu);
 }
-static void opcode_popdx(struct cpu *cpu) {
-    uint16_t t =  opcode_pop(cpu);
-    opcode_set_reg16_val(cpu->reg.dx, t);
+static void opcode_popdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.dx = opcode_pop(cpu);
 }
-static void opcode_popbx(struct cpu *cpu) {
-    uint16_t t =  opcode_pop(cpu);
-    opcode_set_reg16_val(cpu->reg.bx, t);
+static void opcode_popbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bx = opcode_pop(cpu);
 }
 
-static void opcode_popsp(struct cpu *cpu) {
+static void opcode_popsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.sp = opcode_pop(cpu);
 }
 
-static void opcode_popbp(struct cpu *cpu) {
+static void opcode_popbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.bp = opcode_pop(cpu);
 }
-static void opcode_popsi(struct cpu *cpu) {
+static void opcode_popsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.si = opcode_pop(cpu);
 }
-static void opcode_popdi(struct cpu *cpu) {
+static void opcode_popdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.di = opcode_pop(cpu);
 }
 
-static void opcode_popes(struct cpu *cpu) {
+static void opcode_popes(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.es = opcode_pop(cpu);
 }
 
-static void opcode_popcs(struct cpu *cpu) {
-    cpu->reg.cs = opcode_pop(cpu);
+static void opcode_popcs(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_segment_register(cpu, CPU_SREG_CS, opcode_pop(cpu));
 }
-static void opcode_popds(struct cpu *cpu) {
+static void opcode_popds(struct cpu *cpu, uint8_t op0, uint8_t op1) {
     cpu->reg.ds = opcode_pop(cpu);
 }
-static void opcode_popss(struct cpu *cpu) {
-    cpu->reg.ss = opcode_pop(cpu);
+static void opcode_popss(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_segment_register(cpu, CPU_SREG_SS, opcode_pop(cpu));
 }
 
-static void opcode_incax(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, opcode_reg8_to_reg16(cpu->reg.ax), 1);
-    opcode_set_reg16_val(cpu->reg.ax, res);
+static void opcode_incax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = opcode_inc(cpu, cpu->reg.ax);
 }
 
-static void opcode_inccx(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, opcode_reg8_to_reg16(cpu->reg.cx), 1);
-    opcode_set_reg16_val(cpu->reg.cx, res);
+static void opcode_inccx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx = opcode_inc(cpu, cpu->reg.cx);
 }
 
-static void opcode_incdx(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, opcode_reg8_to_reg16(cpu->reg.dx), 1);
-    opcode_set_reg16_val(cpu->reg.dx, res);
+static void opcode_incdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.dx = opcode_inc(cpu, cpu->reg.dx);
 }
 
-static void opcode_incbx(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, opcode_reg8_to_reg16(cpu->reg.bx), 1);
-    opcode_set_reg16_val(cpu->reg.bx, res);
+static void opcode_incbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bx = opcode_inc(cpu, cpu->reg.bx);
 }
 
-static void opcode_incsp(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, cpu->reg.sp, 1);
-    cpu->reg.sp = res;
+static void opcode_incsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.sp = opcode_inc(cpu, cpu->reg.sp);
 }
 
-static void opcode_incbp(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, cpu->reg.bp, 1);
-    cpu->reg.bp = res;
+static void opcode_incbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bp = opcode_inc(cpu, cpu->reg.bp);
 }
 
-static void opcode_incsi(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, cpu->reg.bp, 1);
-    cpu->reg.bp = res;
+static void opcode_incsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.si = opcode_inc(cpu, cpu->reg.si);
 }
 
-static void opcode_incdi(struct cpu *cpu) {
-    uint16_t res = opcode_add(cpu, cpu->reg.di, 1);
-    cpu->reg.di = res;
+static void opcode_incdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.di = opcode_inc(cpu, cpu->reg.di);
 }
 
-static void opcode_decax(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, opcode_reg8_to_reg16(cpu->reg.ax), 1);
-    opcode_set_reg16_val(cpu->reg.ax, res);
+static void opcode_decax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = opcode_dec(cpu, cpu->reg.ax);
 }
 
-static void opcode_deccx(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, opcode_reg8_to_reg16(cpu->reg.cx), 1);
-    opcode_set_reg16_val(cpu->reg.cx, res);
+static void opcode_deccx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx = opcode_dec(cpu, cpu->reg.cx);
 }
 
-static void opcode_decdx(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, opcode_reg8_to_reg16(cpu->reg.dx), 1);
-    opcode_set_reg16_val(cpu->reg.dx, res);
+static void opcode_decdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.dx = opcode_dec(cpu, cpu->reg.dx);
 }
 
-static void opcode_decbx(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, opcode_reg8_to_reg16(cpu->reg.bx), 1);
-    opcode_set_reg16_val(cpu->reg.bx, res);
+static void opcode_decbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bx = opcode_dec(cpu, cpu->reg.bx);
 }
 
-static void opcode_decsp(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, cpu->reg.sp, 1);
-    cpu->reg.sp = res;
+static void opcode_decsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.sp = opcode_dec(cpu, cpu->reg.sp);
 }
 
-static void opcode_decbp(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, cpu->reg.bp, 1);
-    cpu->reg.bp = res;
+static void opcode_decbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bp = opcode_dec(cpu, cpu->reg.bp);
 }
 
-static void opcode_decsi(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, cpu->reg.bp, 1);
-    cpu->reg.bp = res;
+static void opcode_decsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.si = opcode_dec(cpu, cpu->reg.si);
 }
 
-static void opcode_decdi(struct cpu *cpu) {
-    uint16_t res = opcode_sub(cpu, cpu->reg.di, 1);
-    cpu->reg.di = res;
+static void opcode_decdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.di = opcode_dec(cpu, cpu->reg.di);
 }
 
-// END OF OPCODE IMPLEMENTATIONS
+static void opcode_jo(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & CPU_FLAGS_OVERFLOW) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jno(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_OVERFLOW)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & CPU_FLAGS_CARRY) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jnb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_CARRY)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & CPU_FLAGS_ZERO) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jnz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_ZERO)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jbe(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & (CPU_FLAGS_CARRY | CPU_FLAGS_ZERO)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_ja(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & (CPU_FLAGS_CARRY | CPU_FLAGS_ZERO))) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_js(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & CPU_FLAGS_SIGN) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jns(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_SIGN)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jpe(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (flags & CPU_FLAGS_PARITY) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jpo(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_PARITY)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_SIGN) != !(flags & CPU_FLAGS_OVERFLOW)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jge(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_SIGN) == !(flags & CPU_FLAGS_OVERFLOW)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jle(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if ((flags & CPU_FLAGS_ZERO) || (!(flags & CPU_FLAGS_SIGN) != !(flags & CPU_FLAGS_OVERFLOW))) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jg(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu);
+    if (!(flags & CPU_FLAGS_ZERO) && (!(flags & CPU_FLAGS_SIGN) == !(flags & CPU_FLAGS_OVERFLOW))) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_pushf(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu, flags_get(cpu));
+}
+
+static void opcode_popf(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set(cpu, opcode_pop(cpu));
+    if (cpu->reg.flags & CPU_FLAGS_INTERRUPTS) cpu_set_intr(cpu, cpu->intr);
+}
+
+static void opcode_sahf(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu) & 0xff00;
+    flags_set(cpu, flags | opcode_get_byte_register(cpu, 4));
+}
+
+static void opcode_lahf(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 4, flags_get(cpu) & 0xff);
+}
 
+static void opcode_cmc(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set(cpu, flags_get(cpu) ^ CPU_FLAGS_CARRY);
+}
+
+static void opcode_clc(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set(cpu, flags_get(cpu) & ~(CPU_FLAGS_CARRY));
+}
+
+static void opcode_stc(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set(cpu, flags_get(cpu) | CPU_FLAGS_CARRY);
+}
+
+static void opcode_cld(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.flags &= ~CPU_FLAGS_DIRECTION;
+}
+
+static void opcode_std(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.flags |= CPU_FLAGS_DIRECTION;
+}
+
+static void opcode_cli(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.flags &= ~CPU_FLAGS_INTERRUPTS;
+}
+
+// A request that was held off while IF was clear gets taken once the next instruction has run
+static void opcode_sti(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    if (!(cpu->reg.flags & CPU_FLAGS_INTERRUPTS)) cpu->state |= CPU_SHADOW;
+    cpu->reg.flags |= CPU_FLAGS_INTERRUPTS;
+    cpu_set_intr(cpu, cpu->intr);
+}
+
+// The return address points past the instruction, opcode_call adds length back on after the handler.
+// A native handler that wants the INT to run again, say to wait for a key, takes length off IP itself.
+static inline void opcode_software_interrupt(struct cpu *cpu, uint8_t vector, uint8_t length) {
+    cpu->reg.ip += length;
+    if (!cpu_hle(cpu, vector)) cpu_interrupt(cpu, vector);
+    cpu->reg.ip -= length;
+}
+
+static void opcode_int3(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_software_interrupt(cpu, 3, 1);
+}
+
+static void opcode_int(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_software_interrupt(cpu, op0, 2);
+}
+
+static void opcode_into(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    if (flags_get(cpu) & CPU_FLAGS_OVERFLOW) opcode_software_interrupt(cpu, 4, 1);
+}
+
+static void opcode_iret(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ip = opcode_pop(cpu) - 1;
+    cpu->reg.cs = opcode_pop(cpu);
+    opcode_popf(cpu, op0, op1);
+}
 
 /*
-    addr8 = 8-bit address of I/O port
-    reg8 = AL = 0, CL = 1, DL = 2, BL = 3, AH =4, CH = 5, DH = 6, BH = 7
-    reg16 = AX = 0, CX =1, DX =2, BX =3, SP = 4, BP = 5, SI = 6, DI = 7
-    sreg = ES = 0, CS = 1, SS = 2, DS = 3
-    mem8 = memory byte (direct addressing only)
-    mem16 = memory word (direct addressing only)
-    r/m8 = reg8 or mem8
-    r/m16 = reg16 or mem16
-    imm8 = 8 bit immediate
-    imm16 = 16 bit immediate
+    String instructions. Sources are DS:SI, destinations ES:DI, both offsets step by the element
+    width, up or down depending on DF, and wrap within their 64KB segment. A REP prefix runs the
+    whole count in one go: opcode_string_bulk takes memmove/memset or a vectorised search when
+    everything it touches is plain memory, anything else goes element by element.
  */
 
-const struct opcode opcodes[256] = {
-        {"ADD r/m8, r8", 2, opcode_addrm8},
-        {"ADD r/m16, r16", 2, opcode_addrm16},
-        {"ADD r8, r/m8", 2, opcode_addr8},
-        {"ADD r16, r/m16", 2, opcode_addr16},
-        {"ADD al, imm8", 2, NULL},
-        {"ADD ax, imm16", 3, NULL},
-        {"PUSH es", 0, opcode_pushes},
-        {"POP es", 0, opcode_popes},
-        {"OR r/m8, r8", 2, opcode_orrm8},
-        {"OR r/m16, r16", 2, opcode_orrm16},
-        {"OR r8, r/m8", 2, opcode_orr8},
-        {"OR r16, r/m16", 2, opcode_orr16},
-        {"OR al, imm8", 2, NULL},
-        {"OR ax, imm16", 3, NULL},
-        {"PUSH cs", 0, opcode_pushcs},
-        {"POP cs", 0, opcode_popcs},
-        {"ADC r/m8, r8", 2, opcode_adcrm8},
-        {"ADC r/m16, r16", 2, opcode_adcrm16},
-        {"ADC r8, r/m8", 2, opcode_adcr8},
-        {"ADC r16, r/m16", 2, opcode_adcr16},
-        {"ADC al, imm8", 2, NULL},
-        {"ADC ax, imm16", 3, NULL},
-        {"PUSH ss", 0, opcode_pushss},
-        {"POP ss", 0, opcode_popss},
-        {"SBB r/m8, r8", 2, opcode_subbrm8},
-        {"SBB r/m16, r16", 2, opcode_subbrm16},
-        {"SBB r8, r/m8", 2, opcode_subbr8},
-        {"SBB r16, r/m16", 2, opcode_subbr16},
-        {"SBB al, imm8", 2, NULL},
-        {"SBB ax, imm16", 3, NULL},
-        {"PUSH ds", 0, opcode_pushds},
-        {"POP ds", 0, opcode_popds},
-        {"AND r/m8, r8", 2, opcode_andrm8},
-        {"AND r/m16, r16", 2, opcode_andrm16},
-        {"AND r8, r/m8", 2, opcode_andr8},
-        {"AND r16, r/m16", 2, opcode_andr16},
-        {"AND al, imm8", 2, NULL},
-        {"AND ax, imm16", 3, NULL},
-        {"", 0, NULL},
-        {"DAA", 0, NULL},
-        {"SUB r/m8, r8", 2, opcode_subrm8},
-        {"SUB r/m16, r16", 2,  opcode_subrm16},
-        {"SUB r8, r/m8", 2, opcode_subr8},
-        {"SUB r16, r/m16", 2, opcode_subr16},
-        {"SUB al, imm8", 2, NULL},
-        {"SUB ax, imm16", 3, NULL},
-        {"", 0, NULL},
-        {"DAS", 0, NULL},
-        {"XOR r/m8, r8", 2, opcode_xorrm8},
-        {"XOR r/m16, r16", 2, opcode_xorrm16},
-        {"XOR r8, r/m8", 2, opcode_xorr8},
-        {"XOR r16, r/m16", 2, opcode_xorr16},
-        {"XOR al, imm8", 2, NULL},
-        {"XOR ax, imm16", 3, NULL},
-        {"", 0, NULL},
-        {"AAA", 0, NULL},
-        {"CMP r/m8, r8", 2, opcode_cmprm8},
-        {"CMP r/m16, r16", 2, opcode_cmprm16},
-        {"CMP r8, r/m8", 2, opcode_cmpr8},
-        {"CMP r16, r/m16", 2, opcode_cmpr16},
-        {"CMP al, imm8", 2, NULL},
-        {"CMP ax, imm16", 3, NULL},
-        {"", 0, NULL},
-        {"AAS", 0, NULL},
-        {"INC ax", 0, opcode_incax},
-        {"INC cx", 0, opcode_inccx},
-        {"INC dx", 0, opcode_incdx},
-        {"INC bx", 0, opcode_incbx},
-        {"INC sp", 0, opcode_incsp},
-        {"INC bp", 0, opcode_incbp},
-        {"INC si", 0, opcode_incsi},
-        {"INC di", 0, opcode_incdi},
-        {"DEC ax", 0, opcode_decax},
-        {"DEC cx", 0, opcode_deccx},
-        {"DEC dx", 0, opcode_decdx},
-        {"DEC bx", 0, opcode_decbx},
-        {"DEC sp", 0, opcode_decsp},
-        {"DEC bp", 0, opcode_decbp},
-        {"DEC si", 0, opcode_decsi},
-        {"DEC di", 0, opcode_decdi},
-        {"PUSH ax", 0, opcode_pushax},
-        {"PUSH cx", 0, opcode_pushcx},
-        {"PUSH dx", 0, opcode_pushdx},
-        {"PUSH bx", 0, opcode_pushbx},
-        {"PUSH sp", 0, opcode_pushsp},
-        {"PUSH bp", 0, opcode_pushbp},
-        {"PUSH si", 0, opcode_pushsi},
-        {"PUSH di", 0, opcode_pushdi},
-        {"POP ax", 0, opcode_popax},
-        {"POP cx", 0, opcode_popcx},
-        {"POP dx", 0, opcode_popdx},
-        {"POP bx", 0, opcode_popbx},
-        {"POP sp", 0, opcode_popsp},
-        {"POP bp", 0, opcode_popbp},
-        {"POP si", 0, opcode_popsi},
-        {"POP di", 0, opcode_popdi},
-        {"PUSHA", 0, NULL},
-        {"POPA", 0, NULL},
-        {"BOUND r16, m16", 3, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"PUSH imm16", 3, NULL},
-        {"IMUL r16, r/m16, imm16", 4, NULL},
-        {"PUSH imm8", 1, NULL},
-        {"IMUL r16, r/m16, imm8", 3, NULL},
-        {"INSB", 0, NULL},
-        {"INSW", 0, NULL},
-        {"OUTSB", 0, NULL},
-        {"OUTSW", 0, NULL},
-        {"JO rel8", 1, NULL},
-        {"JNO rel8", 1, NULL},
-        {"JB rel8", 1, NULL},
-        {"JNB rel8", 1, NULL},
-        {"JZ rel8", 1, NULL},
-        {"JNZ rel8", 1, NULL},
-        {"JBE rel8", 1, NULL},
-        {"JA rel8", 1, NULL},
-        {"JS rel8", 1, NULL},
-        {"JNS rel8", 1, NULL},
-        {"JPE rel8", 1, NULL},
-        {"JPO rel8", 1, NULL},
-        {"JL rel8", 1, NULL},
-        {"JGE rel8", 1, NULL},
-        {"JLE rel8", 1, NULL},
-        {"JG rel8", 1, NULL},
-        {"GRP1 r/m8, imm8", 2, NULL},
-        {"GRP1 r/m16, imm8", 2, NULL},
-        {"GRP1 r/m8, imm8", 2, NULL},
-        {"GRP1 r/m16, imm8", 2, NULL},
-        {"TEST r8, r/m8", 2, NULL},
-        {"TEST r16, r/m16", 2, NULL},
-        {"XCHG r8, r/m8", 2, NULL},
-        {"XCHG r16, r/m16", 2, NULL},
-        {"MOV r/m8, r8", 2, NULL},
-        {"MOV r/m16, r16", 2, NULL},
-        {"MOV r8, r/m8", 2, NULL},
-        {"MOV r16, r/m16", 2, NULL},
-        {"MOV r/m16, sreg", 2, NULL},
-        {"LEA r16, mem16", 2, NULL},
-        {"MOV sreg, r/m16", 2, NULL},
-        {"POP r/m16", 1, NULL},
-        {"NOP", 0, NULL},
-        {"XCHG CX, AX", 0, NULL},
-        {"XCHG DX, AX", 0, NULL},
-        {"XCHG BX, AX", 0, NULL},
-        {"XCHG SP, AX", 0, NULL},
-        {"XCHG BP, AX", 0, NULL},
-        {"XCHG SI, AX", 0, NULL},
-        {"XCHG DI, AX", 0, NULL},
-        {"CBW", 0, NULL},
-        {"CWD", 0, NULL},
-        {"CALL m16:16", 2, NULL},
-        {"WAIT", 0, NULL},
-        {"PUSHF", 0, NULL},
-        {"POPF", 0, NULL},
-        {"SAHF", 0, NULL},
-        {"LAHF", 0, NULL},
-        {"MOV al, moffs8", 2, NULL},
-        {"MOV ax, moffs16", 3, NULL},
-        {"MOV moffs8, al", 2, NULL},
-        {"MOV moffs16, ax", 3, NULL},
-        {"MOVSB", 0, NULL},
-        {"MOVSW", 0, NULL},
-        {"CMPSB", 0, NULL},
-        {"CMPSW", 0, NULL},
-        {"TEST al, imm8", 2, NULL},
-        {"TEST ax, imm16", 3, NULL},
-        {"STOSB", 0, NULL},
-        {"STOSW", 0, NULL},
-        {"LODSB", 0, NULL},
-        {"LODSW", 0, NULL},
-        {"SCASB", 0, NULL},
-        {"SCASW", 0, NULL},
-        {"MOV al, imm8", 2, NULL},
-        {"MOV cl, imm8", 2, NULL},
-        {"MOV dl, imm8", 2, NULL},
-        {"MOV bl, imm8", 2, NULL},
-        {"MOV ah, imm8", 2, NULL},
-        {"MOV ch, imm8", 2, NULL},
-        {"MOV dh, imm8", 2, NULL},
-        {"MOV bh, imm8", 2, NULL},
-        {"MOV ax, imm16", 3, NULL},
-        {"MOV cx, imm16", 3, NULL},
-        {"MOV dx, imm16", 3, NULL},
-        {"MOV bx, imm16", 3, NULL},
-        {"MOV sp, imm16", 3, NULL},
-        {"MOV bp, imm16", 3, NULL},
-        {"MOV si, imm16", 3, NULL},
-        {"MOV di, imm16", 3, NULL},
-        {"GRP2 r/m8, imm8", 1, NULL},
-        {"GRP2 r/m16, imm8", 1, NULL},
-        {"RET imm16", 2, NULL},
-        {"RET", 0, NULL},
-        {"LES r16, m16:16", 3, NULL},
-        {"LDS r16, m16:16", 3, NULL},
-        {"MOV r8, m8", 2, NULL},
-        {"MOV r16, m16", 2, NULL},
-        {"ENTER", 0, NULL},
-        {"LEAVE", 0, NULL},
-        {"RETF imm16", 2, NULL},
-        {"RETF", 0, NULL},
-        {"INT3", 0, NULL},
-        {"INT imm8", 1, NULL},
-        {"INTO", 0, NULL},
-        {"IRET", 0, NULL},
-        {"GRP2 r/m8, 1", 1, NULL},
-        {"GRP2 r/m16, 1", 1, NULL},
-        {"GRP2 r/m8, cl", 1, NULL},
-        {"GRP2 r/m16, cl", 1, NULL},
-        {"AAM imm8", 1, NULL},
-        {"AAD imm8", 1, NULL},
-        {"SALC", 0, NULL},
-        {"XLAT", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"[x87ONLY]", 0, NULL},
-        {"LOOPNZ rel8", 1, NULL},
-        {"LOOPZ rel8", 1, NULL},
-        {"LOOP rel8", 1, NULL},
-        {"JCXZ rel8", 1, NULL},
-        {"IN al, imm8", 2, NULL},
-        {"IN ax, imm8", 2, NULL},
-        {"OUT imm8, al", 2, NULL},
-        {"OUT imm8, ax", 2, NULL},
-        {"CALL rel16", 1, NULL},
-        {"JMP rel16", 1, NULL},
-        {"JMP m16:16", 1, NULL},
-        {"JMP rel8", 1, NULL},
-        {"IN al, dx", 0, NULL},
-        {"IN ax, dx", 0, NULL},
-        {"OUT dx, al", 0, NULL},
-        {"OUT dx, ax", 0, NULL},
-        {"LOCK", 0, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"", 0, NULL},
-        {"HLT", 0, opcode_hlt},
-        {"CMC", 0, NULL},
-        {"GRP3a r/m8", 2, NULL},
-        {"GRP3b r/m16", 2, NULL},
-        {"CLC", 0, NULL},
-        {"STC", 0, NULL},
-        {"CLI", 0, NULL},
-        {"STI", 0, NULL},
-        {"CLD", 0, NULL},
-        {"STD", 0, NULL},
-        {"GRP4 r/m8", 2, NULL},
-        {"GRP5 r/m16", 2, NULL},
-};
+static inline int16_t opcode_string_delta(struct cpu *cpu, uint8_t width) {
+    return cpu->reg.flags & CPU_FLAGS_DIRECTION ? -width : width;
+}
 
-void opcode_execute(struct cpu *cpu) {
-    uint8_t opcode_byte = memory_read_byte(cpu, cpu->reg.ip32);
-    struct opcode opcode = opcodes[opcode_byte];
+static inline uint16_t opcode_string_read(struct cpu *cpu, uint32_t addr, uint8_t width) {
+    return width == 1 ? memory_read_byte(cpu, addr) : memory_read_word(cpu, addr);
+}
 
-    if (opcode.function == NULL) {
-        debug_print("[!] Not implemented or invalid instruction %#x (%s) hit, bailing out.\n", opcode_byte, opcode.name);
-        cpu->state |= CPU_HALTED;
-    } else {
-        uint8_t op0, op1, op2, op3;
-        printf("[*] %s\n", opcode.name);
-        switch (opcode.operand_length) {
-            case 0:
-                ((void (*)(struct cpu *cpu))opcode.function)(cpu);
-                break;
-            case 1:
-                op0 = memory_read_byte(cpu, cpu->reg.ip32 + 1);
-                ((void (*)(struct cpu *cpu, uint8_t))opcode.function)(cpu, op0);
-            case 2:
-                op0 = memory_read_byte(cpu, cpu->reg.ip32 + 1);
-                op1 = memory_read_byte(cpu, cpu->reg.ip32 + 2);
-                ((void (*)(struct cpu *cpu, uint8_t, uint8_t))opcode.function)(cpu, op0, op1);
-                break;
-            case 3:
-                op0 = memory_read_byte(cpu, cpu->reg.ip32 + 1);
-                op1 = memory_read_byte(cpu, cpu->reg.ip32 + 2);
-                op2 = memory_read_byte(cpu, cpu->reg.ip32 + 3);
-                ((void (*)(struct cpu *cpu, uint8_t, uint8_t, uint8_t))opcode.function)(cpu, op0, op1, op2);
-                break;
-            case 4:
-                op0 = memory_read_byte(cpu, cpu->reg.ip32 + 1);
-                op1 = memory_read_byte(cpu, cpu->reg.ip32 + 2);
-                op2 = memory_read_byte(cpu, cpu->reg.ip32 + 3);
-                op3 = memory_read_byte(cpu, cpu->reg.ip32 + 4);
-                ((void (*)(struct cpu *cpu, uint8_t, uint8_t, uint8_t, uint8_t))opcode.function)(cpu, op0, op1, op2, op3);
-                break;
-            default:
-                return;
-        }
-    }
+static inline void opcode_string_write(struct cpu *cpu, uint32_t addr, uint8_t width, uint16_t val) {
+    if (width == 1) memory_write_byte(cpu, addr, val);
+    else memory_write_word(cpu, addr, val);
+}
 
-    if (opcode.operand_length) cpu->reg.ip += opcode.operand_length;
-    else cpu->reg.ip++;
+static inline uint16_t opcode_string_acc(struct cpu *cpu, uint8_t width) {
+    return width == 1 ? opcode_get_byte_register(cpu, 0) : cpu->reg.ax;
+}
 
-    // PhysicalAddress = Segment * 16 + Offset
-    cpu->reg.ip32 = cpu->reg.cs * 16 + cpu->reg.ip;
+static inline void opcode_string_compare(struct cpu *cpu, uint8_t width, uint16_t a, uint16_t b) {
+    if (width == 1) opcode_sub8(cpu, a, b);
+    else opcode_sub(cpu, a, b);
+}
+
+// One element of MOVS/CMPS/STOS/LODS/SCAS, byte or word picked by the low opcode bit
+static void opcode_string_step(struct cpu *cpu, uint8_t opcode_byte) {
+    uint8_t width = (opcode_byte & 1) + 1;
+    int16_t delta = opcode_string_delta(cpu, width);
+    uint32_t src = cpu_segment(cpu, CPU_SREG_DS) * 16 + cpu->reg.si;
+    uint32_t dst = cpu->reg.es * 16 + cpu->reg.di;
+
+    switch (opcode_byte & 0xfe) {
+        case 0xa4:
+            opcode_string_write(cpu, dst, width, opcode_string_read(cpu, src, width));
+            cpu->reg.si += delta;
+            cpu->reg.di += delta;
+            return;
+        case 0xa6:
+            opcode_string_compare(cpu, width, opcode_string_read(cpu, src, width), opcode_string_read(cpu, dst, width));
+            cpu->reg.si += delta;
+            cpu->reg.di += delta;
+            return;
+        case 0xaa:
+            opcode_string_write(cpu, dst, width, opcode_string_acc(cpu, width));
+            cpu->reg.di += delta;
+            return;
+        case 0xac:
+            if (width == 1) opcode_set_byte_register(cpu, 0, memory_read_byte(cpu, src));
+            else cpu->reg.ax = memory_read_word(cpu, src);
+            cpu->reg.si += delta;
+            return;
+        case 0xae:
+            opcode_string_compare(cpu, width, opcode_string_acc(cpu, width), opcode_string_read(cpu, dst, width));
+            cpu->reg.di += delta;
+            return;
+        default:
+            return;
+    }
+}
+
+// Linear start of the count elements an offset walks over, or -1 if they wrap around the segment
+static inline int32_t opcode_string_range(uint16_t segment, uint16_t offset, uint32_t bytes, uint8_t width, int16_t delta) {
+    if (delta > 0) return offset + bytes <= 0x10000 ? segment * 16 + offset : -1;
+    if (offset + width < bytes || offset + width > 0x10000) return -1;
+    return segment * 16 + offset + width - bytes;
+}
+
+// Runs all count elements straight on host memory, returns how many ran or 0 if it can't
+static uint16_t opcode_string_bulk(struct cpu *cpu, uint8_t opcode_byte, uint16_t count, int repne) {
+    uint8_t width = (opcode_byte & 1) + 1;
+    int16_t delta = opcode_string_delta(cpu, width);
+    uint32_t bytes = count * width;
+    int32_t src = opcode_string_range(cpu_segment(cpu, CPU_SREG_DS), cpu->reg.si, bytes, width, delta);
+    int32_t dst = opcode_string_range(cpu->reg.es, cpu->reg.di, bytes, width, delta);
+    uint16_t done = count;
+    uint8_t *s, *d;
+
+    switch (opcode_byte & 0xfe) {
+        case 0xa4:
+            // Overlap is only safe when the copy direction reads every byte before it gets overwritten
+            if (src < 0 || dst < 0) return 0;
+            if (delta > 0 && dst > src && dst < src + (int32_t) bytes) return 0;
+            if (delta < 0 && dst < src && dst + (int32_t) bytes > src) return 0;
+            if (!(s = memory_span(cpu, src, bytes, 0)) || !(d = memory_span(cpu, dst, bytes, 1))) return 0;
+            memmove(d, s, bytes);
+            cpu->reg.si += delta * count;
+            cpu->reg.di += delta * count;
+            return count;
+        case 0xaa: {
+            if (dst < 0 || !(d = memory_span(cpu, dst, bytes, 1))) return 0;
+            uint16_t val = opcode_string_acc(cpu, width);
+            if (width == 1) memset(d, val, bytes);
+            else for (uint32_t i = 0; i < bytes; i += 2) memcpy(d + i, &val, 2);
+            cpu->reg.di += delta * count;
+            return count;
+        }
+        case 0xac:
+            // Only the last element survives
+            if (src < 0 || !memory_span(cpu, src, bytes, 0)) return 0;
+            cpu->reg.si += delta * (count - 1);
+            opcode_string_step(cpu, opcode_byte);
+            return count;
+        case 0xa6:
+            if (delta < 0 || src < 0 || dst < 0) return 0;
+            if (!(s = memory_span(cpu, src, bytes, 0)) || !(d = memory_span(cpu, dst, bytes, 0))) return 0;
+            done = string_compare(s, d, count, width, repne);
+            break;
+        case 0xae:
+            if (delta < 0 || dst < 0 || !(d = memory_span(cpu, dst, bytes, 0))) return 0;
+            done = string_scan(d, opcode_string_acc(cpu, width), count, width, repne);
+            break;
+        default:
+            return 0;
+    }
+
+    // CMPS/SCAS: skip to the element that ends the run and let it set the flags
+    if (done < count) done++;
+    cpu->reg.si += (opcode_byte & 0xfe) == 0xa6 ? delta * (done - 1) : 0;
+    cpu->reg.di += delta * (done - 1);
+    opcode_string_step(cpu, opcode_byte);
+    return done;
+}
+
+// Extra clocks per repetition, on top of the 9 a REP string instruction costs up front
+static inline uint8_t opcode_string_rep_cycles(uint8_t opcode_byte) {
+    switch (opcode_byte & 0xfe) {
+        case 0xa4: return 17;
+        case 0xa6: return 22;
+        case 0xaa: return 10;
+        case 0xac: return 13;
+        case 0xae: return 15;
+        default: return 0;
+    }
+}
+
+/*
+    On the 8086 an interrupt can come in between two repetitions: it pushes the address of the
+    prefix, and the instruction picks up with what is left in CX once the handler returns. A run
+    with more elements than fit before the deadline does the same, it stops there with IP back
+    on the prefix. Each call gets at least one element through so stepping still moves. In fast
+    timing every repetition counts as an instruction, the way single-stepping sees them.
+    Returns 1 when IP was put back to run the prefix again.
+ */
+static int opcode_rep_prefix(struct cpu *cpu, uint8_t opcode_byte, int repne) {
+    // A segment prefix between REP and the string instruction applies to its source
+    if (opcode_is_segment_prefix(opcode_byte)) {
+        uint8_t saved = cpu->segment_override;
+        cpu->segment_override = ((opcode_byte >> 3) & 3) + 1;
+        cpu->reg.ip++;
+        int again = opcode_rep_prefix(cpu, opcode_fetch(cpu, 1), repne);
+        cpu->segment_override = saved;
+        if (again) cpu->reg.ip--;
+        return again;
+    }
+
+    // Anything but a string instruction runs on its own, so only the prefix byte is consumed
+    if (!opcode_is_string(opcode_byte)) {
+        cpu->reg.ip--;
+        return 0;
+    }
+
+    uint16_t count = cpu->reg.cx, limit = count;
+    uint8_t rep_cycles = cpu->timing == CPU_TIMING_FAST ? 1 : opcode_string_rep_cycles(opcode_byte);
+    uint64_t budget = cpu->deadline > cpu->cycles ? (cpu->deadline - cpu->cycles) / rep_cycles : 0;
+    if (budget < limit) limit = budget ? budget : 1;
+
+    uint16_t done = limit ? opcode_string_bulk(cpu, opcode_byte, limit, repne) : 0;
+    int compares = (opcode_byte & 0xfe) == 0xa6 || (opcode_byte & 0xfe) == 0xae;
+
+    if (!done) {
+        while (done < limit) {
+            opcode_string_step(cpu, opcode_byte);
+            done++;
+            if (!compares) continue;
+
+            // REPZ keeps going while the elements match, REPNZ while they don't
+            uint16_t zero = flags_get(cpu) & CPU_FLAGS_ZERO;
+            if (repne ? zero : !zero) break;
+        }
+    }
+
+    // Fast timing has already counted the first repetition as the instruction itself
+    cpu->reg.cx = count - done;
+    if (cpu->timing == CPU_TIMING_ACCURATE) cpu->cycles += 7 + done * rep_cycles;
+    else if (done) cpu->cycles += done - 1;
+    if (!cpu->reg.cx) return 0;
+
+    // CMPS/SCAS that stopped on their condition are finished, whatever CX says
+    if (compares) {
+        uint16_t zero = flags_get(cpu) & CPU_FLAGS_ZERO;
+        if (repne ? zero : !zero) return 0;
+    }
+    cpu->reg.ip -= 2;
+    return 1;
+}
+
+static void opcode_repnz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_rep_prefix(cpu, op0, 1);
+}
+
+static void opcode_repz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_rep_prefix(cpu, op0, 0);
+}
+
+static void opcode_movsb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xa4);
+}
+
+static void opcode_movsw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xa5);
+}
+
+static void opcode_cmpsb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xa6);
+}
+
+static void opcode_cmpsw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xa7);
+}
+
+static void opcode_stosb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xaa);
+}
+
+static void opcode_stosw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xab);
+}
+
+static void opcode_lodsb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xac);
+}
+
+static void opcode_lodsw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xad);
+}
+
+static void opcode_scasb(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xae);
+}
+
+static void opcode_scasw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_string_step(cpu, 0xaf);
+}
+
+static void opcode_inalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 0, io_read_byte(cpu, op0));
+}
+
+static void opcode_inaximm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = io_read_word(cpu, op0);
+}
+
+static void opcode_outimm8al(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    io_write_byte(cpu, op0, opcode_get_byte_register(cpu, 0));
+}
+
+static void opcode_outimm8ax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    io_write_word(cpu, op0, cpu->reg.ax);
+}
+
+static void opcode_inaldx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 0, io_read_byte(cpu, cpu->reg.dx));
+}
+
+static void opcode_inaxdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = io_read_word(cpu, cpu->reg.dx);
+}
+
+static void opcode_outdxal(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    io_write_byte(cpu, cpu->reg.dx, opcode_get_byte_register(cpu, 0));
+}
+
+static void opcode_outdxax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    io_write_word(cpu, cpu->reg.dx, cpu->reg.ax);
+}
+
+static inline void opcode_alu_accumulator8(struct cpu *cpu, uint8_t operation, uint8_t imm) {
+    uint8_t result = opcode_alu(cpu, operation, 8, opcode_get_byte_register(cpu, 0), imm);
+    if (operation != OPCODE_ALU_CMP) opcode_set_byte_register(cpu, 0, result);
+}
+
+static inline void opcode_alu_accumulator16(struct cpu *cpu, uint8_t operation, uint16_t imm) {
+    uint16_t result = opcode_alu(cpu, operation, 16, cpu->reg.ax, imm);
+    if (operation != OPCODE_ALU_CMP) cpu->reg.ax = result;
+}
+
+static void opcode_addalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 0, op0);
+}
+
+static void opcode_addaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 0, op0 | op1 << 8);
+}
+
+static void opcode_oralimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 1, op0);
+}
+
+static void opcode_oraximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 1, op0 | op1 << 8);
+}
+
+static void opcode_adcalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 2, op0);
+}
+
+static void opcode_adcaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 2, op0 | op1 << 8);
+}
+
+static void opcode_subbalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 3, op0);
+}
+
+static void opcode_subbaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 3, op0 | op1 << 8);
+}
+
+static void opcode_andalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 4, op0);
+}
+
+static void opcode_andaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 4, op0 | op1 << 8);
+}
+
+static void opcode_subalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 5, op0);
+}
+
+static void opcode_subaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 5, op0 | op1 << 8);
+}
+
+static void opcode_xoralimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, 6, op0);
+}
+
+static void opcode_xoraximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, 6, op0 | op1 << 8);
+}
+
+static void opcode_cmpalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator8(cpu, OPCODE_ALU_CMP, op0);
+}
+
+static void opcode_cmpaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_alu_accumulator16(cpu, OPCODE_ALU_CMP, op0 | op1 << 8);
+}
+
+/*
+    ES:, CS:, SS: and DS: run the instruction they prefix from inside their own handler, so
+    nothing can get in between the two and the override is gone again by the time anything
+    else looks at memory. op0 and op1 are the prefixed opcode and its first operand byte.
+ */
+static void opcode_segment_prefix(struct cpu *cpu, uint8_t sreg, uint8_t opcode_byte, uint8_t op0) {
+    uint8_t saved = cpu->segment_override;
+    cpu->reg.ip++;
+    uint8_t op1 = opcodes[opcode_byte].operand_length > 1 ? opcode_fetch(cpu, 2) : 0;
+
+    uint16_t prefixed = cpu->reg.ip;
+    cpu->segment_override = sreg + 1;
+    opcode_call(cpu, opcode_byte, op0, op1);
+    cpu->segment_override = saved;
+    if (cpu->timing == CPU_TIMING_ACCURATE) cpu->cycles += opcode_cycles(opcode_byte, op0);
+
+    // An instruction that left IP on itself to run again, like an interrupted REP, keeps its prefix
+    if (cpu->reg.ip == prefixed) cpu->reg.ip--;
+    // opcode_call has moved past the prefixed instruction, the caller still adds the prefix's two bytes
+    cpu->reg.ip -= 2;
+}
+
+static void opcode_es(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_segment_prefix(cpu, CPU_SREG_ES, op0, op1);
+}
+
+static void opcode_cs(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_segment_prefix(cpu, CPU_SREG_CS, op0, op1);
+}
+
+static void opcode_ss(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_segment_prefix(cpu, CPU_SREG_SS, op0, op1);
+}
+
+static void opcode_ds(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_segment_prefix(cpu, CPU_SREG_DS, op0, op1);
+}
+
+static void opcode_daa(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu), set = 0;
+    uint8_t al = opcode_get_byte_register(cpu, 0), result = al;
+
+    if ((al & 0x0f) > 9 || (flags & CPU_FLAGS_ACARRY)) {
+        result += 0x06;
+        set |= CPU_FLAGS_ACARRY;
+    }
+    if (al > 0x99 || (flags & CPU_FLAGS_CARRY)) {
+        result += 0x60;
+        set |= CPU_FLAGS_CARRY;
+    }
+    opcode_set_byte_register(cpu, 0, result);
+    opcode_set_flags(cpu, 8, result, set);
+}
+
+static void opcode_das(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t flags = flags_get(cpu), set = 0;
+    uint8_t al = opcode_get_byte_register(cpu, 0), result = al;
+
+    // Subtracting 6 can borrow out of AL, which sets CF on its own
+    if ((al & 0x0f) > 9 || (flags & CPU_FLAGS_ACARRY)) {
+        result -= 0x06;
+        set |= CPU_FLAGS_ACARRY | (al < 0x06 ? CPU_FLAGS_CARRY : 0);
+    }
+    if (al > 0x99 || (flags & CPU_FLAGS_CARRY)) {
+        result -= 0x60;
+        set |= CPU_FLAGS_CARRY;
+    }
+    opcode_set_byte_register(cpu, 0, result);
+    opcode_set_flags(cpu, 8, result, set);
+}
+
+static void opcode_aaa(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t set = 0;
+    if ((opcode_get_byte_register(cpu, 0) & 0x0f) > 9 || (flags_get(cpu) & CPU_FLAGS_ACARRY)) {
+        cpu->reg.ax += 0x106;
+        set = CPU_FLAGS_ACARRY | CPU_FLAGS_CARRY;
+    }
+    opcode_set_byte_register(cpu, 0, opcode_get_byte_register(cpu, 0) & 0x0f);
+    opcode_set_flags(cpu, 8, opcode_get_byte_register(cpu, 0), set);
+}
+
+static void opcode_aas(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t set = 0;
+    if ((opcode_get_byte_register(cpu, 0) & 0x0f) > 9 || (flags_get(cpu) & CPU_FLAGS_ACARRY)) {
+        opcode_set_byte_register(cpu, 0, opcode_get_byte_register(cpu, 0) - 6);
+        opcode_set_byte_register(cpu, 4, opcode_get_byte_register(cpu, 4) - 1);
+        set = CPU_FLAGS_ACARRY | CPU_FLAGS_CARRY;
+    }
+    opcode_set_byte_register(cpu, 0, opcode_get_byte_register(cpu, 0) & 0x0f);
+    opcode_set_flags(cpu, 8, opcode_get_byte_register(cpu, 0), set);
+}
+
+// 80 and 82 take an imm8, 81 an imm16 and 83 an imm8 sign-extended to a word
+static void opcode_grp1rm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t operation = (op0 >> 3) & 7;
+
+    uint8_t result = opcode_alu(cpu, operation, 8, modrm_read8(cpu, &rm), opcode_immediate8(cpu, op0));
+    if (operation != OPCODE_ALU_CMP) modrm_write8(cpu, &rm, result);
+}
+
+static void opcode_grp1rm16imm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t operation = (op0 >> 3) & 7;
+
+    uint16_t result = opcode_alu(cpu, operation, 16, modrm_read16(cpu, &rm), opcode_immediate16(cpu, op0));
+    if (operation != OPCODE_ALU_CMP) modrm_write16(cpu, &rm, result);
+}
+
+static void opcode_grp1rm16imm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t operation = (op0 >> 3) & 7;
+
+    uint16_t result = opcode_alu(cpu, operation, 16, modrm_read16(cpu, &rm), (int8_t) opcode_immediate8(cpu, op0));
+    if (operation != OPCODE_ALU_CMP) modrm_write16(cpu, &rm, result);
+}
+
+static void opcode_testrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t result = modrm_read8(cpu, &rm) & opcode_get_byte_register(cpu, (op0 >> 3) & 7);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, result);
+}
+
+static void opcode_testrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t result = modrm_read16(cpu, &rm) & opcode_get_word_register(cpu, (op0 >> 3) & 7);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, result);
+}
+
+static void opcode_xchgrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    modrm_write8(cpu, &rm, opcode_get_byte_register(cpu, (op0 >> 3) & 7));
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, a);
+}
+
+static void opcode_xchgrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    modrm_write16(cpu, &rm, opcode_get_word_register(cpu, (op0 >> 3) & 7));
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, a);
+}
+
+static void opcode_movrm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write8(cpu, &rm, opcode_get_byte_register(cpu, (op0 >> 3) & 7));
+}
+
+static void opcode_movrm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write16(cpu, &rm, opcode_get_word_register(cpu, (op0 >> 3) & 7));
+}
+
+static void opcode_movr8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    opcode_set_byte_register(cpu, (op0 >> 3) & 7, modrm_read8(cpu, &rm));
+}
+
+static void opcode_movr16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, modrm_read16(cpu, &rm));
+}
+
+static void opcode_movrmsreg(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write16(cpu, &rm, opcode_get_segment_register(cpu, (op0 >> 3) & 7));
+}
+
+// Only the offset is loaded, a segment prefix on LEA changes nothing
+static void opcode_lea(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, modrm_offset(cpu, op0));
+}
+
+static void opcode_movsregrm(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    opcode_set_segment_register(cpu, (op0 >> 3) & 7, modrm_read16(cpu, &rm));
+}
+
+// SP is already past the popped word when an SP-relative destination gets worked out
+static void opcode_poprm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t val = opcode_pop(cpu);
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write16(cpu, &rm, val);
+}
+
+static void opcode_nop(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+}
+
+static inline void opcode_xchg_ax(struct cpu *cpu, uint8_t reg_id) {
+    uint16_t t = cpu->reg.ax;
+    cpu->reg.ax = opcode_get_word_register(cpu, reg_id);
+    opcode_set_word_register(cpu, reg_id, t);
+}
+
+static void opcode_xchgcx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 1);
+}
+
+static void opcode_xchgdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 2);
+}
+
+static void opcode_xchgbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 3);
+}
+
+static void opcode_xchgsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 4);
+}
+
+static void opcode_xchgbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 5);
+}
+
+static void opcode_xchgsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 6);
+}
+
+static void opcode_xchgdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_xchg_ax(cpu, 7);
+}
+
+static void opcode_cbw(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = (int8_t) opcode_get_byte_register(cpu, 0);
+}
+
+static void opcode_cwd(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.dx = (cpu->reg.ax & 0x8000) ? 0xffff : 0;
+}
+
+static void opcode_callfar(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t segment = opcode_fetch_word(cpu, 3);
+    opcode_push(cpu, cpu->reg.cs);
+    opcode_push(cpu, cpu->reg.ip + 5);
+    cpu->reg.cs = segment;
+    opcode_jump(cpu, op0 | op1 << 8, 5);
+}
+
+// There is no coprocessor to wait for
+static void opcode_wait(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+}
+
+static void opcode_movalmoffs8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint32_t addr = cpu_segment(cpu, CPU_SREG_DS) * 16 + (op0 | op1 << 8);
+    opcode_set_byte_register(cpu, 0, memory_read_byte(cpu, addr));
+}
+
+static void opcode_movaxmoffs16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint32_t addr = cpu_segment(cpu, CPU_SREG_DS) * 16 + (op0 | op1 << 8);
+    cpu->reg.ax = memory_read_word(cpu, addr);
+}
+
+static void opcode_movmoffs8al(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint32_t addr = cpu_segment(cpu, CPU_SREG_DS) * 16 + (op0 | op1 << 8);
+    memory_write_byte(cpu, addr, opcode_get_byte_register(cpu, 0));
+}
+
+static void opcode_movmoffs16ax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint32_t addr = cpu_segment(cpu, CPU_SREG_DS) * 16 + (op0 | op1 << 8);
+    memory_write_word(cpu, addr, cpu->reg.ax);
+}
+
+static void opcode_testalimm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, opcode_get_byte_register(cpu, 0) & op0);
+}
+
+static void opcode_testaximm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, cpu->reg.ax & (op0 | op1 << 8));
+}
+
+static void opcode_moval(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 0, op0);
+}
+
+static void opcode_movcl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 1, op0);
+}
+
+static void opcode_movdl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 2, op0);
+}
+
+static void opcode_movbl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 3, op0);
+}
+
+static void opcode_movah(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 4, op0);
+}
+
+static void opcode_movch(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 5, op0);
+}
+
+static void opcode_movdh(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 6, op0);
+}
+
+static void opcode_movbh(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 7, op0);
+}
+
+static void opcode_movax(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ax = op0 | op1 << 8;
+}
+
+static void opcode_movcx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx = op0 | op1 << 8;
+}
+
+static void opcode_movdx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.dx = op0 | op1 << 8;
+}
+
+static void opcode_movbx(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bx = op0 | op1 << 8;
+}
+
+static void opcode_movsp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.sp = op0 | op1 << 8;
+}
+
+static void opcode_movbp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.bp = op0 | op1 << 8;
+}
+
+static void opcode_movsi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.si = op0 | op1 << 8;
+}
+
+static void opcode_movdi(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.di = op0 | op1 << 8;
+}
+
+static void opcode_retimm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_jump(cpu, opcode_pop(cpu), 3);
+    cpu->reg.sp += op0 | op1 << 8;
+}
+
+static void opcode_ret(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_jump(cpu, opcode_pop(cpu), 1);
+}
+
+static void opcode_retfimm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_jump(cpu, opcode_pop(cpu), 3);
+    cpu->reg.cs = opcode_pop(cpu);
+    cpu->reg.sp += op0 | op1 << 8;
+}
+
+static void opcode_retf(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_jump(cpu, opcode_pop(cpu), 1);
+    cpu->reg.cs = opcode_pop(cpu);
+}
+
+// The far pointer is stored offset first, segment in the word after it
+static void opcode_les(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, modrm_read16(cpu, &rm));
+    cpu->reg.es = memory_read_word(cpu, rm.addr + 2);
+}
+
+static void opcode_lds(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    opcode_set_word_register(cpu, (op0 >> 3) & 7, modrm_read16(cpu, &rm));
+    cpu->reg.ds = memory_read_word(cpu, rm.addr + 2);
+}
+
+static void opcode_movrm8imm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write8(cpu, &rm, opcode_immediate8(cpu, op0));
+}
+
+static void opcode_movrm16imm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    modrm_write16(cpu, &rm, opcode_immediate16(cpu, op0));
+}
+
+/*
+    ROL, ROR, RCL, RCR, SHL, SHR, SAL (the same as SHL) and SAR, in reg field order. The 8086
+    doesn't mask the count and a count of 0 leaves the flags alone. Rotates only touch CF and
+    OF, shifts set ZF, SF and PF from the result too. OF is only defined for a count of 1 but
+    is worked out the same way for any count.
+ */
+static uint16_t opcode_shift(struct cpu *cpu, uint8_t operation, uint8_t width, uint16_t val, uint8_t count) {
+    uint32_t sign = 1 << (width - 1), mask = (sign << 1) - 1, res = val;
+    int carry = flags_get_carry(cpu), overflow, out;
+
+    if (!count) return val;
+    for (uint8_t i = 0; i < count; i++) {
+        switch (operation) {
+            case 0:
+                carry = (res & sign) != 0;
+                res = ((res << 1) | carry) & mask;
+                break;
+            case 1:
+                carry = res & 1;
+                res = (res >> 1) | (carry ? sign : 0);
+                break;
+            case 2:
+                out = (res & sign) != 0;
+                res = ((res << 1) | carry) & mask;
+                carry = out;
+                break;
+            case 3:
+                out = res & 1;
+                res = (res >> 1) | (carry ? sign : 0);
+                carry = out;
+                break;
+            case 5:
+                carry = res & 1;
+                res >>= 1;
+                break;
+            case 7:
+                carry = res & 1;
+                res = (res >> 1) | (res & sign);
+                break;
+            default:
+                carry = (res & sign) != 0;
+                res = (res << 1) & mask;
+                break;
+        }
+    }
+
+    switch (operation) {
+        case 1:
+        case 3: overflow = ((res ^ (res << 1)) & sign) != 0; break;
+        case 5: overflow = count == 1 && (val & sign); break;
+        case 7: overflow = 0; break;
+        default: overflow = ((res & sign) != 0) ^ carry; break;
+    }
+
+    if (operation < 4) opcode_set_carry_overflow(cpu, carry, overflow);
+    else opcode_set_flags(cpu, width, res, (carry ? CPU_FLAGS_CARRY : 0) | (overflow ? CPU_FLAGS_OVERFLOW : 0));
+    return res;
+}
+
+static inline void opcode_grp2rm8(struct cpu *cpu, uint8_t modrm, uint8_t count) {
+    struct modrm_operand rm = modrm_decode(cpu, modrm);
+    modrm_write8(cpu, &rm, opcode_shift(cpu, (modrm >> 3) & 7, 8, modrm_read8(cpu, &rm), count));
+}
+
+static inline void opcode_grp2rm16(struct cpu *cpu, uint8_t modrm, uint8_t count) {
+    struct modrm_operand rm = modrm_decode(cpu, modrm);
+    modrm_write16(cpu, &rm, opcode_shift(cpu, (modrm >> 3) & 7, 16, modrm_read16(cpu, &rm), count));
+}
+
+static void opcode_grp2rm8one(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_grp2rm8(cpu, op0, 1);
+}
+
+static void opcode_grp2rm16one(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_grp2rm16(cpu, op0, 1);
+}
+
+static void opcode_grp2rm8cl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_grp2rm8(cpu, op0, opcode_get_byte_register(cpu, 1));
+}
+
+static void opcode_grp2rm16cl(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_grp2rm16(cpu, op0, opcode_get_byte_register(cpu, 1));
+}
+
+static void opcode_aam(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint8_t al = opcode_get_byte_register(cpu, 0);
+    if (!op0) {
+        opcode_divide_error(cpu, 2);
+        return;
+    }
+    opcode_set_byte_register(cpu, 4, al / op0);
+    opcode_set_byte_register(cpu, 0, al % op0);
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, al % op0);
+}
+
+static void opcode_aad(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint8_t al = opcode_get_byte_register(cpu, 0) + opcode_get_byte_register(cpu, 4) * op0;
+    cpu->reg.ax = al;
+    flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, al);
+}
+
+static void opcode_salc(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_set_byte_register(cpu, 0, flags_get_carry(cpu) ? 0xff : 0);
+}
+
+static void opcode_xlat(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    uint16_t offset = cpu->reg.bx + opcode_get_byte_register(cpu, 0);
+    opcode_set_byte_register(cpu, 0, memory_read_byte(cpu, cpu_segment(cpu, CPU_SREG_DS) * 16 + offset));
+}
+
+static void opcode_loopnz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx--;
+    if (cpu->reg.cx && !(flags_get(cpu) & CPU_FLAGS_ZERO)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_loopz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx--;
+    if (cpu->reg.cx && (flags_get(cpu) & CPU_FLAGS_ZERO)) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_loop(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cx--;
+    if (cpu->reg.cx) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_jcxz(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    if (!cpu->reg.cx) opcode_jump_short(cpu, op0);
+}
+
+static void opcode_callnear(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_push(cpu, cpu->reg.ip + 3);
+    cpu->reg.ip += op0 | op1 << 8;
+}
+
+static void opcode_jmp(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.ip += op0 | op1 << 8;
+}
+
+static void opcode_jmpfar(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    cpu->reg.cs = opcode_fetch_word(cpu, 3);
+    opcode_jump(cpu, op0 | op1 << 8, 5);
+}
+
+static void opcode_jmpshort(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    opcode_jump_short(cpu, op0);
+}
+
+// Nothing else drives the bus, so there is nothing to lock it against
+static void opcode_lock(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+}
+
+// Reg fields the 8086 doesn't define stop the CPU on the instruction, like an unimplemented opcode
+static void opcode_invalid(struct cpu *cpu, uint8_t opcode_byte, uint8_t modrm) {
+    debug_print("[!] Invalid instruction %#x /%d hit, bailing out.\n", opcode_byte, (modrm >> 3) & 7);
+    cpu->state |= CPU_HALTED;
+    cpu->reg.ip -= opcodes[opcode_byte].operand_length + opcode_extra_length(opcode_byte, modrm);
+}
+
+// TEST, TEST (an undocumented alias), NOT, NEG, MUL, IMUL, DIV and IDIV
+static void opcode_grp3rm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+    uint16_t ax = cpu->reg.ax;
+    int16_t quotient;
+
+    switch ((op0 >> 3) & 7) {
+        case 0:
+        case 1:
+            flags_set_lazy(cpu, FLAGS_OP_LOGIC, 8, 0, 0, a & opcode_immediate8(cpu, op0));
+            break;
+        case 2:
+            modrm_write8(cpu, &rm, ~a);
+            break;
+        case 3:
+            modrm_write8(cpu, &rm, opcode_sub8(cpu, 0, a));
+            break;
+        case 4:
+            cpu->reg.ax = opcode_get_byte_register(cpu, 0) * a;
+            opcode_set_carry_overflow(cpu, cpu->reg.ax > 0xff, cpu->reg.ax > 0xff);
+            break;
+        case 5:
+            cpu->reg.ax = (int8_t) opcode_get_byte_register(cpu, 0) * (int8_t) a;
+            opcode_set_carry_overflow(cpu, (int16_t) cpu->reg.ax != (int8_t) cpu->reg.ax, (int16_t) cpu->reg.ax != (int8_t) cpu->reg.ax);
+            break;
+        case 6:
+            if (!a || ax / a > 0xff) {
+                opcode_divide_error(cpu, 2 + modrm_table[op0].disp);
+                return;
+            }
+            opcode_set_byte_register(cpu, 0, ax / a);
+            opcode_set_byte_register(cpu, 4, ax % a);
+            break;
+        case 7:
+            if (!a || (quotient = (int16_t) ax / (int8_t) a) > 127 || quotient < -127) {
+                opcode_divide_error(cpu, 2 + modrm_table[op0].disp);
+                return;
+            }
+            opcode_set_byte_register(cpu, 0, quotient);
+            opcode_set_byte_register(cpu, 4, (int16_t) ax % (int8_t) a);
+            break;
+    }
+}
+
+static void opcode_grp3rm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint32_t dxax = (uint32_t) cpu->reg.dx << 16 | cpu->reg.ax;
+    int32_t product;
+    int64_t quotient;
+
+    switch ((op0 >> 3) & 7) {
+        case 0:
+        case 1:
+            flags_set_lazy(cpu, FLAGS_OP_LOGIC, 16, 0, 0, a & opcode_immediate16(cpu, op0));
+            break;
+        case 2:
+            modrm_write16(cpu, &rm, ~a);
+            break;
+        case 3:
+            modrm_write16(cpu, &rm, opcode_sub(cpu, 0, a));
+            break;
+        case 4:
+            dxax = (uint32_t) cpu->reg.ax * a;
+            cpu->reg.ax = dxax;
+            cpu->reg.dx = dxax >> 16;
+            opcode_set_carry_overflow(cpu, cpu->reg.dx != 0, cpu->reg.dx != 0);
+            break;
+        case 5:
+            product = (int32_t) (int16_t) cpu->reg.ax * (int16_t) a;
+            cpu->reg.ax = product;
+            cpu->reg.dx = (uint32_t) product >> 16;
+            opcode_set_carry_overflow(cpu, product != (int16_t) product, product != (int16_t) product);
+            break;
+        case 6:
+            if (!a || dxax / a > 0xffff) {
+                opcode_divide_error(cpu, 2 + modrm_table[op0].disp);
+                return;
+            }
+            cpu->reg.ax = dxax / a;
+            cpu->reg.dx = dxax % a;
+            break;
+        case 7:
+            if (!a || (quotient = (int64_t) (int32_t) dxax / (int16_t) a) > 32767 || quotient < -32767) {
+                opcode_divide_error(cpu, 2 + modrm_table[op0].disp);
+                return;
+            }
+            cpu->reg.ax = quotient;
+            cpu->reg.dx = (int64_t) (int32_t) dxax % (int16_t) a;
+            break;
+    }
+}
+
+static void opcode_grp4rm8(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint8_t a = modrm_read8(cpu, &rm);
+
+    switch ((op0 >> 3) & 7) {
+        case 0: modrm_write8(cpu, &rm, opcode_inc8(cpu, a)); break;
+        case 1: modrm_write8(cpu, &rm, opcode_dec8(cpu, a)); break;
+        default: opcode_invalid(cpu, 0xfe, op0); break;
+    }
+}
+
+// INC, DEC, CALL, CALL far, JMP, JMP far and PUSH, far pointers are stored offset first
+static void opcode_grp5rm16(struct cpu *cpu, uint8_t op0, uint8_t op1) {
+    struct modrm_operand rm = modrm_decode(cpu, op0);
+    uint16_t a = modrm_read16(cpu, &rm);
+    uint16_t length = 2 + modrm_table[op0].disp;
+
+    switch ((op0 >> 3) & 7) {
+        case 0:
+            modrm_write16(cpu, &rm, opcode_inc(cpu, a));
+            break;
+        case 1:
+            modrm_write16(cpu, &rm, opcode_dec(cpu, a));
+            break;
+        case 2:
+            opcode_push(cpu, cpu->reg.ip + length);
+            opcode_jump(cpu, a, length);
+            break;
+        case 3:
+            opcode_push(cpu, cpu->reg.cs);
+            opcode_push(cpu, cpu->reg.ip + length);
+            cpu->reg.cs = memory_read_word(cpu, rm.addr + 2);
+            opcode_jump(cpu, a, length);
+            break;
+        case 4:
+            opcode_jump(cpu, a, length);
+            break;
+        case 5:
+            cpu->reg.cs = memory_read_word(cpu, rm.addr + 2);
+            opcode_jump(cpu, a, length);
+            break;
+        case 6:
+            opcode_push(cpu, a);
+            break;
+        default:
+            opcode_invalid(cpu, 0xff, op0);
+            break;
+    }
+}
+
+// END OF OPCODE IMPLEMENTATIONS
+
+
+/*
+    addr8 = 8-bit address of I/O port
+    reg8 = AL = 0, CL = 1, DL = 2, BL = 3, AH =4, CH = 5, DH = 6, BH = 7
+    reg16 = AX = 0, CX =1, DX =2, BX =3, SP = 4, BP = 5, SI = 6, DI = 7
+    sreg = ES = 0, CS = 1, SS = 2, DS = 3
+    mem8 = memory byte (direct addressing only)
+    mem16 = memory word (direct addressing only)
+    r/m8 = reg8 or mem8
+    r/m16 = reg16 or mem16
+    imm8 = 8 bit immediate
+    imm16 = 16 bit immediate
+ */
+
+const struct opcode opcodes[256] = {
+        {"ADD r/m8, r8", 2, opcode_addrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"ADD r/m16, r16", 2, opcode_addrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"ADD r8, r/m8", 2, opcode_addr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"ADD r16, r/m16", 2, opcode_addr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"ADD al, imm8", 2, opcode_addalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"ADD ax, imm16", 3, opcode_addaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"PUSH es", 0, opcode_pushes, 0, 10, 0},
+        {"POP es", 0, opcode_popes, 0, 8, 0},
+        {"OR r/m8, r8", 2, opcode_orrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"OR r/m16, r16", 2, opcode_orrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"OR r8, r/m8", 2, opcode_orr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"OR r16, r/m16", 2, opcode_orr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"OR al, imm8", 2, opcode_oralimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"OR ax, imm16", 3, opcode_oraximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"PUSH cs", 0, opcode_pushcs, 0, 10, 0},
+        {"POP cs", 0, opcode_popcs, OPCODE_BRANCH, 8, 0},
+        {"ADC r/m8, r8", 2, opcode_adcrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"ADC r/m16, r16", 2, opcode_adcrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"ADC r8, r/m8", 2, opcode_adcr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"ADC r16, r/m16", 2, opcode_adcr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"ADC al, imm8", 2, opcode_adcalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"ADC ax, imm16", 3, opcode_adcaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"PUSH ss", 0, opcode_pushss, 0, 10, 0},
+        {"POP ss", 0, opcode_popss, 0, 8, 0},
+        {"SBB r/m8, r8", 2, opcode_subbrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"SBB r/m16, r16", 2, opcode_subbrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"SBB r8, r/m8", 2, opcode_subbr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"SBB r16, r/m16", 2, opcode_subbr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"SBB al, imm8", 2, opcode_subbalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"SBB ax, imm16", 3, opcode_subbaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"PUSH ds", 0, opcode_pushds, 0, 10, 0},
+        {"POP ds", 0, opcode_popds, 0, 8, 0},
+        {"AND r/m8, r8", 2, opcode_andrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"AND r/m16, r16", 2, opcode_andrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"AND r8, r/m8", 2, opcode_andr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"AND r16, r/m16", 2, opcode_andr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"AND al, imm8", 2, opcode_andalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"AND ax, imm16", 3, opcode_andaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"ES:", 2, opcode_es, OPCODE_IP, 2, 0},
+        {"DAA", 0, opcode_daa, 0, 4, 0},
+        {"SUB r/m8, r8", 2, opcode_subrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"SUB r/m16, r16", 2, opcode_subrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"SUB r8, r/m8", 2, opcode_subr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"SUB r16, r/m16", 2, opcode_subr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"SUB al, imm8", 2, opcode_subalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"SUB ax, imm16", 3, opcode_subaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"CS:", 2, opcode_cs, OPCODE_IP, 2, 0},
+        {"DAS", 0, opcode_das, 0, 4, 0},
+        {"XOR r/m8, r8", 2, opcode_xorrm8, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"XOR r/m16, r16", 2, opcode_xorrm16, OPCODE_MODRM, 3, 16, OPCODE_NATIVE_ALU},
+        {"XOR r8, r/m8", 2, opcode_xorr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"XOR r16, r/m16", 2, opcode_xorr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"XOR al, imm8", 2, opcode_xoralimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"XOR ax, imm16", 3, opcode_xoraximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"SS:", 2, opcode_ss, OPCODE_IP, 2, 0},
+        {"AAA", 0, opcode_aaa, 0, 4, 0},
+        {"CMP r/m8, r8", 2, opcode_cmprm8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"CMP r/m16, r16", 2, opcode_cmprm16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"CMP r8, r/m8", 2, opcode_cmpr8, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"CMP r16, r/m16", 2, opcode_cmpr16, OPCODE_MODRM, 3, 9, OPCODE_NATIVE_ALU},
+        {"CMP al, imm8", 2, opcode_cmpalimm8, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"CMP ax, imm16", 3, opcode_cmpaximm16, 0, 4, 0, OPCODE_NATIVE_ALU_ACC},
+        {"DS:", 2, opcode_ds, OPCODE_IP, 2, 0},
+        {"AAS", 0, opcode_aas, 0, 4, 0},
+        {"INC ax", 0, opcode_incax, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC cx", 0, opcode_inccx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC dx", 0, opcode_incdx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC bx", 0, opcode_incbx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC sp", 0, opcode_incsp, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC bp", 0, opcode_incbp, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC si", 0, opcode_incsi, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"INC di", 0, opcode_incdi, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC ax", 0, opcode_decax, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC cx", 0, opcode_deccx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC dx", 0, opcode_decdx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC bx", 0, opcode_decbx, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC sp", 0, opcode_decsp, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC bp", 0, opcode_decbp, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC si", 0, opcode_decsi, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"DEC di", 0, opcode_decdi, 0, 2, 0, OPCODE_NATIVE_INCDEC},
+        {"PUSH ax", 0, opcode_pushax, 0, 11, 0},
+        {"PUSH cx", 0, opcode_pushcx, 0, 11, 0},
+        {"PUSH dx", 0, opcode_pushdx, 0, 11, 0},
+        {"PUSH bx", 0, opcode_pushbx, 0, 11, 0},
+        {"PUSH sp", 0, opcode_pushsp, 0, 11, 0},
+        {"PUSH bp", 0, opcode_pushbp, 0, 11, 0},
+        {"PUSH si", 0, opcode_pushsi, 0, 11, 0},
+        {"PUSH di", 0, opcode_pushdi, 0, 11, 0},
+        {"POP ax", 0, opcode_popax, 0, 8, 0},
+        {"POP cx", 0, opcode_popcx, 0, 8, 0},
+        {"POP dx", 0, opcode_popdx, 0, 8, 0},
+        {"POP bx", 0, opcode_popbx, 0, 8, 0},
+        {"POP sp", 0, opcode_popsp, 0, 8, 0},
+        {"POP bp", 0, opcode_popbp, 0, 8, 0},
+        {"POP si", 0, opcode_popsi, 0, 8, 0},
+        {"POP di", 0, opcode_popdi, 0, 8, 0},
+        {"PUSHA", 0, NULL, 0, 36, 0},
+        {"POPA", 0, NULL, 0, 51, 0},
+        {"BOUND r16, m16", 3, NULL, OPCODE_MODRM, 0, 33},
+        {"", 0, NULL, 0, 0, 0},
+        {"", 0, NULL, 0, 0, 0},
+        {"", 0, NULL, 0, 0, 0},
+        {"", 0, NULL, 0, 0, 0},
+        {"", 0, NULL, 0, 0, 0},
+        {"PUSH imm16", 3, NULL, 0, 10, 0},
+        {"IMUL r16, r/m16, imm16", 4, NULL, OPCODE_MODRM, 22, 25},
+        {"PUSH imm8", 1, NULL, 0, 10, 0},
+        {"IMUL r16, r/m16, imm8", 3, NULL, OPCODE_MODRM, 22, 25},
+        {"INSB", 0, NULL, 0, 14, 0},
+        {"INSW", 0, NULL, 0, 14, 0},
+        {"OUTSB", 0, NULL, 0, 14, 0},
+        {"OUTSW", 0, NULL, 0, 14, 0},
+        {"JO rel8", 2, opcode_jo, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JNO rel8", 2, opcode_jno, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JB rel8", 2, opcode_jb, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JNB rel8", 2, opcode_jnb, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JZ rel8", 2, opcode_jz, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JNZ rel8", 2, opcode_jnz, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JBE rel8", 2, opcode_jbe, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JA rel8", 2, opcode_ja, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JS rel8", 2, opcode_js, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JNS rel8", 2, opcode_jns, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JPE rel8", 2, opcode_jpe, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JPO rel8", 2, opcode_jpo, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JL rel8", 2, opcode_jl, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JGE rel8", 2, opcode_jge, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JLE rel8", 2, opcode_jle, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"JG rel8", 2, opcode_jg, OPCODE_BRANCH, 4, 0, OPCODE_NATIVE_JCC},
+        {"GRP1 r/m8, imm8", 3, opcode_grp1rm8, OPCODE_MODRM | OPCODE_IP, 4, 17, OPCODE_NATIVE_ALU_IMM},
+        {"GRP1 r/m16, imm16", 4, opcode_grp1rm16imm16, OPCODE_MODRM | OPCODE_IP, 4, 17, OPCODE_NATIVE_ALU_IMM},
+        {"GRP1 r/m8, imm8", 3, opcode_grp1rm8, OPCODE_MODRM | OPCODE_IP, 4, 17, OPCODE_NATIVE_ALU_IMM},
+        {"GRP1 r/m16, imm8", 3, opcode_grp1rm16imm8, OPCODE_MODRM | OPCODE_IP, 4, 17, OPCODE_NATIVE_ALU_IMM},
+        {"TEST r8, r/m8", 2, opcode_testrm8, OPCODE_MODRM, 3, 9},
+        {"TEST r16, r/m16", 2, opcode_testrm16, OPCODE_MODRM, 3, 9},
+        {"XCHG r8, r/m8", 2, opcode_xchgrm8, OPCODE_MODRM, 4, 17},
+        {"XCHG r16, r/m16", 2, opcode_xchgrm16, OPCODE_MODRM, 4, 17},
+        {"MOV r/m8, r8", 2, opcode_movrm8, OPCODE_MODRM, 2, 9, OPCODE_NATIVE_MOV},
+        {"MOV r/m16, r16", 2, opcode_movrm16, OPCODE_MODRM, 2, 9, OPCODE_NATIVE_MOV},
+        {"MOV r8, r/m8", 2, opcode_movr8, OPCODE_MODRM, 2, 8, OPCODE_NATIVE_MOV},
+        {"MOV r16, r/m16", 2, opcode_movr16, OPCODE_MODRM, 2, 8, OPCODE_NATIVE_MOV},
+        {"MOV r/m16, sreg", 2, opcode_movrmsreg, OPCODE_MODRM, 2, 9},
+        {"LEA r16, mem16", 2, opcode_lea, OPCODE_MODRM, 2, 2},
+        {"MOV sreg, r/m16", 2, opcode_movsregrm, OPCODE_MODRM | OPCODE_BRANCH, 2, 8},
+        {"POP r/m16", 2, opcode_poprm16, OPCODE_MODRM, 8, 17},
+        {"NOP", 0, opcode_nop, 0, 3, 0},
+        {"XCHG CX, AX", 0, opcode_xchgcx, 0, 3, 0},
+        {"XCHG DX, AX", 0, opcode_xchgdx, 0, 3, 0},
+        {"XCHG BX, AX", 0, opcode_xchgbx, 0, 3, 0},
+        {"XCHG SP, AX", 0, opcode_xchgsp, 0, 3, 0},
+        {"XCHG BP, AX", 0, opcode_xchgbp, 0, 3, 0},
+        {"XCHG SI, AX", 0, opcode_xchgsi, 0, 3, 0},
+        {"XCHG DI, AX", 0, opcode_xchgdi, 0, 3, 0},
+        {"CBW", 0, opcode_cbw, 0, 2, 0},
+        {"CWD", 0, opcode_cwd, 0, 5, 0},
+        {"CALL m16:16", 5, opcode_callfar, OPCODE_BRANCH | OPCODE_IP, 28, 0},
+        {"WAIT", 0, opcode_wait, 0, 4, 0},
+        {"PUSHF", 0, opcode_pushf, 0, 10, 0},
+        {"POPF", 0, opcode_popf, OPCODE_BRANCH, 8, 0},
+        {"SAHF", 0, opcode_sahf, 0, 4, 0},
+        {"LAHF", 0, opcode_lahf, 0, 4, 0},
+        {"MOV al, moffs8", 3, opcode_movalmoffs8, 0, 10, 0},
+        {"MOV ax, moffs16", 3, opcode_movaxmoffs16, 0, 10, 0},
+        {"MOV moffs8, al", 3, opcode_movmoffs8al, 0, 10, 0},
+        {"MOV moffs16, ax", 3, opcode_movmoffs16ax, 0, 10, 0},
+        {"MOVSB", 0, opcode_movsb, 0, 18, 0},
+        {"MOVSW", 0, opcode_movsw, 0, 18, 0},
+        {"CMPSB", 0, opcode_cmpsb, 0, 22, 0},
+        {"CMPSW", 0, opcode_cmpsw, 0, 22, 0},
+        {"TEST al, imm8", 2, opcode_testalimm8, 0, 4, 0},
+        {"TEST ax, imm16", 3, opcode_testaximm16, 0, 4, 0},
+        {"STOSB", 0, opcode_stosb, 0, 11, 0},
+        {"STOSW", 0, opcode_stosw, 0, 11, 0},
+        {"LODSB", 0, opcode_lodsb, 0, 12, 0},
+        {"LODSW", 0, opcode_lodsw, 0, 12, 0},
+        {"SCASB", 0, opcode_scasb, 0, 15, 0},
+        {"SCASW", 0, opcode_scasw, 0, 15, 0},
+        {"MOV al, imm8", 2, opcode_moval, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV cl, imm8", 2, opcode_movcl, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV dl, imm8", 2, opcode_movdl, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV bl, imm8", 2, opcode_movbl, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV ah, imm8", 2, opcode_movah, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV ch, imm8", 2, opcode_movch, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV dh, imm8", 2, opcode_movdh, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV bh, imm8", 2, opcode_movbh, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV ax, imm16", 3, opcode_movax, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV cx, imm16", 3, opcode_movcx, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV dx, imm16", 3, opcode_movdx, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV bx, imm16", 3, opcode_movbx, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV sp, imm16", 3, opcode_movsp, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV bp, imm16", 3, opcode_movbp, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV si, imm16", 3, opcode_movsi, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"MOV di, imm16", 3, opcode_movdi, 0, 4, 0, OPCODE_NATIVE_MOV_IMM},
+        {"GRP2 r/m8, imm8", 1, NULL, OPCODE_MODRM, 5, 17},
+        {"GRP2 r/m16, imm8", 1, NULL, OPCODE_MODRM, 5, 17},
+        {"RET imm16", 3, opcode_retimm16, OPCODE_BRANCH, 12, 0},
+        {"RET", 0, opcode_ret, OPCODE_BRANCH, 8, 0},
+        {"LES r16, m16:16", 2, opcode_les, OPCODE_MODRM, 0, 16},
+        {"LDS r16, m16:16", 2, opcode_lds, OPCODE_MODRM, 0, 16},
+        {"MOV r/m8, imm8", 3, opcode_movrm8imm8, OPCODE_MODRM | OPCODE_IP, 4, 10},
+        {"MOV r/m16, imm16", 4, opcode_movrm16imm16, OPCODE_MODRM | OPCODE_IP, 4, 10},
+        {"ENTER", 0, NULL, 0, 15, 0},
+        {"LEAVE", 0, NULL, 0, 8, 0},
+        {"RETF imm16", 3, opcode_retfimm16, OPCODE_BRANCH, 17, 0},
+        {"RETF", 0, opcode_retf, OPCODE_BRANCH, 18, 0},
+        {"INT3", 0, opcode_int3, OPCODE_BRANCH, 52, 0},
+        {"INT imm8", 2, opcode_int, OPCODE_BRANCH, 51, 0},
+        {"INTO", 0, opcode_into, OPCODE_BRANCH, 4, 0},
+        {"IRET", 0, opcode_iret, OPCODE_BRANCH, 24, 0},
+        {"GRP2 r/m8, 1", 2, opcode_grp2rm8one, OPCODE_MODRM, 2, 15},
+        {"GRP2 r/m16, 1", 2, opcode_grp2rm16one, OPCODE_MODRM, 2, 15},
+        {"GRP2 r/m8, cl", 2, opcode_grp2rm8cl, OPCODE_MODRM, 8, 20},
+        {"GRP2 r/m16, cl", 2, opcode_grp2rm16cl, OPCODE_MODRM, 8, 20},
+        {"AAM imm8", 2, opcode_aam, OPCODE_IP, 83, 0},
+        {"AAD imm8", 2, opcode_aad, 0, 60, 0},
+        {"SALC", 0, opcode_salc, 0, 3, 0},
+        {"XLAT", 0, opcode_xlat, 0, 11, 0},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"[x87ONLY]", 0, NULL, 0, 2, 8},
+        {"LOOPNZ rel8", 2, opcode_loopnz, OPCODE_BRANCH, 5, 0},
+        {"LOOPZ rel8", 2, opcode_loopz, OPCODE_BRANCH, 6, 0},
+        {"LOOP rel8", 2, opcode_loop, OPCODE_BRANCH, 5, 0},
+        {"JCXZ rel8", 2, opcode_jcxz, OPCODE_BRANCH, 6, 0},
+        {"IN al, imm8", 2, opcode_inalimm8, 0, 10, 0},
+        {"IN ax, imm8", 2, opcode_inaximm8, 0, 10, 0},
+        {"OUT imm8, al", 2, opcode_outimm8al, OPCODE_BRANCH, 10, 0},
+        {"OUT imm8, ax", 2, opcode_outimm8ax, OPCODE_BRANCH, 10, 0},
+        {"CALL rel16", 3, opcode_callnear, OPCODE_BRANCH, 19, 0},
+        {"JMP rel16", 3, opcode_jmp, OPCODE_BRANCH, 15, 0},
+        {"JMP m16:16", 5, opcode_jmpfar, OPCODE_BRANCH | OPCODE_IP, 15, 0},
+        {"JMP rel8", 2, opcode_jmpshort, OPCODE_BRANCH, 15, 0},
+        {"IN al, dx", 0, opcode_inaldx, 0, 8, 0},
+        {"IN ax, dx", 0, opcode_inaxdx, 0, 8, 0},
+        {"OUT dx, al", 0, opcode_outdxal, OPCODE_BRANCH, 8, 0},
+        {"OUT dx, ax", 0, opcode_outdxax, OPCODE_BRANCH, 8, 0},
+        {"LOCK", 0, opcode_lock, 0, 2, 0},
+        {"", 0, NULL, 0, 2, 0},
+        {"REPNZ", 2, opcode_repnz, OPCODE_IP, 2, 0},
+        {"REPZ", 2, opcode_repz, OPCODE_IP, 2, 0},
+        {"HLT", 0, opcode_hlt, OPCODE_BRANCH, 2, 0},
+        {"CMC", 0, opcode_cmc, 0, 2, 0},
+        {"GRP3a r/m8", 2, opcode_grp3rm8, OPCODE_MODRM | OPCODE_IP, 3, 16},
+        {"GRP3b r/m16", 2, opcode_grp3rm16, OPCODE_MODRM | OPCODE_IP, 3, 16},
+        {"CLC", 0, opcode_clc, 0, 2, 0},
+        {"STC", 0, opcode_stc, 0, 2, 0},
+        {"CLI", 0, opcode_cli, 0, 2, 0},
+        {"STI", 0, opcode_sti, OPCODE_BRANCH, 2, 0},
+        {"CLD", 0, opcode_cld, 0, 2, 0},
+        {"STD", 0, opcode_std, 0, 2, 0},
+        {"GRP4 r/m8", 2, opcode_grp4rm8, OPCODE_MODRM, 3, 15},
+        {"GRP5 r/m16", 2, opcode_grp5rm16, OPCODE_MODRM | OPCODE_BRANCH, 3, 15}
+};
+
+void opcode_call(struct cpu *cpu, uint8_t opcode_byte, uint8_t op0, uint8_t op1) {
+    const struct opcode *opcode = &opcodes[opcode_byte];
+
+    // IP stays on the instruction so whoever reports the halt points at the culprit
+    if (opcode->function == NULL) {
+        debug_print("[!] Not implemented or invalid instruction %#x (%s) hit, bailing out.\n", opcode_byte, opcode->name);
+        cpu->state |= CPU_HALTED;
+        return;
+    }
+
+    trace_instruction(cpu, cpu->reg.ip, opcode_byte);
+    profile_instruction(cpu, opcode_byte, op0);
+    opcode->function(cpu, op0, op1);
+
+    if (opcode->operand_length) cpu->reg.ip += opcode->operand_length;
+    else cpu->reg.ip++;
+    cpu->reg.ip += opcode_extra_length(opcode_byte, op0);
+
+    // PhysicalAddress = Segment * 16 + Offset
+    cpu->reg.ip32 = (cpu->reg.cs * 16 + cpu->reg.ip) & MEMORY_MASK;
+}
+
+void opcode_execute(struct cpu *cpu) {
+    // This is the instruction any shadow was waiting on
+    cpu->state &= ~CPU_SHADOW;
+    uint8_t opcode_byte = memory_fetch_byte(cpu, cpu->reg.ip32);
+    size_t operand_length = opcodes[opcode_byte].operand_length;
+    uint8_t op0 = 0, op1 = 0;
+
+    if (operand_length > 0) op0 = memory_fetch_byte(cpu, cpu->reg.ip32 + 1);
+    if (operand_length > 1) op1 = memory_fetch_byte(cpu, cpu->reg.ip32 + 2);
+
+    if (cpu->timing == CPU_TIMING_FAST) {
+        opcode_call(cpu, opcode_byte, op0, op1);
+        cpu->cycles++;
+        return;
+    }
+
+    uint16_t next = cpu->reg.ip + (operand_length ? operand_length : 1) + opcode_extra_length(opcode_byte, op0);
+    opcode_call(cpu, opcode_byte, op0, op1);
+
+    cpu->cycles += opcode_cycles(opcode_byte, op0);
+    if (cpu->reg.ip != next) cpu->cycles += opcode_taken_cycles(opcode_byte);
+}
+
+// Full encoded length of the instruction at addr, ModR/M displacement included
+/*
+    Segment prefixes run the instruction after them from their own handler, and REP takes its
+    string instruction (and any segment prefix in between) along the same way, so the length of
+    a prefix is that of everything it runs. REP in front of anything else only covers itself.
+ */
+size_t opcode_length(struct cpu *cpu, uintptr_t addr) {
+    size_t prefixes = 0;
+    uint8_t opcode_byte;
+    while (opcode_is_segment_prefix(opcode_byte = memory_fetch_byte(cpu, addr + prefixes)) && prefixes < OPCODE_MAX_PREFIXES) prefixes++;
+
+    if (opcode_byte == 0xf2 || opcode_byte == 0xf3) {
+        size_t rep = prefixes + 1;
+        while (opcode_is_segment_prefix(opcode_byte = memory_fetch_byte(cpu, addr + rep)) && rep < OPCODE_MAX_PREFIXES) rep++;
+        return opcode_is_string(opcode_byte) ? rep + 1 : rep;
+    }
+
+    const struct opcode *opcode = &opcodes[opcode_byte];
+    size_t length = opcode->operand_length ? opcode->operand_length : 1;
+    return prefixes + length + opcode_extra_length(opcode_byte, memory_fetch_byte(cpu, addr + prefixes + 1));
+}
+
+// Flags of the instruction at addr, together with those of the instruction its segment prefixes run
+uint8_t opcode_flags(struct cpu *cpu, uintptr_t addr) {
+    uint8_t opcode_byte = memory_fetch_byte(cpu, addr), flags = opcodes[opcode_byte].flags;
+    for (size_t prefixes = 1; opcode_is_segment_prefix(opcode_byte) && prefixes <= OPCODE_MAX_PREFIXES; prefixes++) {
+        opcode_byte = memory_fetch_byte(cpu, addr + prefixes);
+        flags |= opcodes[opcode_byte].flags;
+    }
+    return flags;
 }
 
 size_t opcode_how_many_implemented(void) {
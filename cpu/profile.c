@@ -0,0 +1,115 @@
+#include <cpu/cpu.h>
+#include <cpu/profile.h>
+#include <cpu/opcodes.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const profile_modrm_names[8] = {
+        "[bx+si]", "[bx+di]", "[bp+si]", "[bp+di]", "[si]", "[di]", "[bp]", "[bx]",
+};
+
+// Fails when the counters weren't compiled in, there would be nothing feeding them
+int profile_create(struct cpu *cpu) {
+#ifdef CPU_PROFILE
+    struct profile *profile = calloc(1, sizeof(struct profile));
+    if (!profile) return -1;
+
+    cpu->profile = profile;
+    return 0;
+#else
+    (void) cpu;
+    return -1;
+#endif
+}
+
+void profile_destroy(struct cpu *cpu) {
+    free(cpu->profile);
+    cpu->profile = NULL;
+}
+
+void profile_reset(struct cpu *cpu) {
+    if (cpu->profile) memset(cpu->profile, 0, sizeof(struct profile));
+}
+
+void profile_block_hit(struct cpu *cpu, uint16_t cs, uint16_t ip) {
+    struct profile *profile = cpu->profile;
+    uint32_t key = ((uint32_t) cs << 16) | ip;
+    uint32_t slot = (key * 2654435761u) >> 20;
+
+    for (int i = 0; i < PROFILE_PROBES; i++) {
+        struct profile_block *block = &profile->blocks[(slot + i) % PROFILE_BLOCKS];
+        if (!block->hits) {
+            block->cs = cs;
+            block->ip = ip;
+        } else if (block->cs != cs || block->ip != ip) {
+            continue;
+        }
+        block->hits++;
+        return;
+    }
+    profile->dropped++;
+}
+
+static int profile_compare_counts(const void *a, const void *b) {
+    uint64_t x = **(const uint64_t *const *) a, y = **(const uint64_t *const *) b;
+    return (x < y) - (x > y);
+}
+
+static int profile_compare_blocks(const void *a, const void *b) {
+    uint32_t x = ((const struct profile_block *) a)->hits, y = ((const struct profile_block *) b)->hits;
+    return (x < y) - (x > y);
+}
+
+// Prints the top entries of each table, hottest first
+void profile_report(struct cpu *cpu, FILE *out, size_t top) {
+    struct profile *profile = cpu->profile;
+    if (!profile) return;
+
+    uint64_t total = 0;
+    const uint64_t *order[256];
+    for (size_t i = 0; i < 256; i++) {
+        total += profile->opcodes[i];
+        order[i] = &profile->opcodes[i];
+    }
+    qsort(order, 256, sizeof(order[0]), profile_compare_counts);
+
+    fprintf(out, "[*] %llu instructions\n", (unsigned long long) total);
+    fprintf(out, "[*] Opcodes:\n");
+    for (size_t i = 0; i < top && i < 256 && *order[i]; i++) {
+        size_t byte = order[i] - profile->opcodes;
+        fprintf(out, "    %#04zx %-20s %12llu %6.2f%%\n", byte, opcodes[byte].name,
+                (unsigned long long) *order[i], 100.0 * *order[i] / total);
+    }
+
+    // Memory forms are listed one per mode, the register forms fold into a single line
+    const uint64_t *modes[24];
+    uint64_t registers = 0;
+    for (size_t i = 0; i < 24; i++) modes[i] = &profile->modrm[i];
+    for (size_t i = 24; i < 32; i++) registers += profile->modrm[i];
+    qsort(modes, 24, sizeof(modes[0]), profile_compare_counts);
+
+    static const char *const suffix[3] = {"", "+disp8", "+disp16"};
+    fprintf(out, "[*] ModR/M modes:\n");
+    if (registers) fprintf(out, "    %-16s %12llu\n", "reg", (unsigned long long) registers);
+    for (size_t i = 0; i < 24 && *modes[i]; i++) {
+        size_t mode = modes[i] - profile->modrm;
+        char name[20];
+        if (mode == 6) snprintf(name, sizeof(name), "[disp16]");
+        else snprintf(name, sizeof(name), "%s%s", profile_modrm_names[mode % 8], suffix[mode / 8]);
+        fprintf(out, "    %-16s %12llu\n", name, (unsigned long long) *modes[i]);
+    }
+
+    struct profile_block *blocks = malloc(sizeof(profile->blocks));
+    if (!blocks) return;
+    memcpy(blocks, profile->blocks, sizeof(profile->blocks));
+    qsort(blocks, PROFILE_BLOCKS, sizeof(blocks[0]), profile_compare_blocks);
+
+    fprintf(out, "[*] Blocks:\n");
+    for (size_t i = 0; i < top && i < PROFILE_BLOCKS && blocks[i].hits; i++)
+        fprintf(out, "    %04x:%04x %12u\n", blocks[i].cs, blocks[i].ip, blocks[i].hits);
+    if (profile->dropped)
+        fprintf(out, "    (%llu hits on blocks that didn't fit)\n", (unsigned long long) profile->dropped);
+
+    free(blocks);
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include <cpu/sched.h>
+
+#include <stdlib.h>
+
+int sched_create(struct cpu *cpu) {
+    cpu->sched = calloc(1, sizeof(struct sched));
+    return cpu->sched ? 0 : -1;
+}
+
+void sched_destroy(struct cpu *cpu) {
+    free(cpu->sched);
+    cpu->sched = NULL;
+}
+
+void sched_event_init(struct sched_event *event, sched_fn fire, void *ctx) {
+    event->deadline = SCHED_NEVER;
+    event->fire = fire;
+    event->ctx = ctx;
+    event->slot = 0;
+}
+
+static inline void sched_place(struct sched *sched, size_t index, struct sched_event *event) {
+    sched->heap[index] = event;
+    event->slot = index + 1;
+}
+
+static void sched_sift_up(struct sched *sched, size_t index) {
+    struct sched_event *event = sched->heap[index];
+    while (index) {
+        size_t parent = (index - 1) / 2;
+        if (sched->heap[parent]->deadline <= event->deadline) break;
+        sched_place(sched, index, sched->heap[parent]);
+        index = parent;
+    }
+    sched_place(sched, index, event);
+}
+
+static void sched_sift_down(struct sched *sched, size_t index) {
+    struct sched_event *event = sched->heap[index];
+    for (;;) {
+        size_t child = index * 2 + 1;
+        if (child >= sched->count) break;
+        if (child + 1 < sched->count && sched->heap[child + 1]->deadline < sched->heap[child]->deadline) child++;
+        if (event->deadline <= sched->heap[child]->deadline) break;
+        sched_place(sched, index, sched->heap[child]);
+        index = child;
+    }
+    sched_place(sched, index, event);
+}
+
+// Queues the event, or moves it when it is already queued
+int sched_at(struct cpu *cpu, struct sched_event *event, uint64_t deadline) {
+    struct sched *sched = cpu->sched;
+
+    if (!event->slot) {
+        if (sched->count == SCHED_MAX_EVENTS) return -1;
+        event->deadline = deadline;
+        sched_place(sched, sched->count++, event);
+        sched_sift_up(sched, sched->count - 1);
+        return 0;
+    }
+
+    uint64_t old = event->deadline;
+    event->deadline = deadline;
+    if (deadline < old) sched_sift_up(sched, event->slot - 1);
+    else sched_sift_down(sched, event->slot - 1);
+    return 0;
+}
+
+void sched_cancel(struct cpu *cpu, struct sched_event *event) {
+    struct sched *sched = cpu->sched;
+    if (!event->slot) return;
+
+    size_t index = event->slot - 1;
+    struct sched_event *last = sched->heap[--sched->count];
+    event->slot = 0;
+    if (last == event) return;
+
+    sched_place(sched, index, last);
+    sched_sift_up(sched, index);
+    sched_sift_down(sched, last->slot - 1);
+}
+
+// Fires everything that is due. deadline still says when the event was due, so a periodic one
+// can queue itself again from inside fire without drifting
+void sched_dispatch(struct cpu *cpu) {
+    struct sched *sched = cpu->sched;
+    while (sched->count && sched->heap[0]->deadline <= cpu->cycles) {
+        struct sched_event *event = sched->heap[0];
+        sched_cancel(cpu, event);
+        event->fire(cpu, event->ctx);
+    }
+}
\ No newline at end of file
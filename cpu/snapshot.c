@@ -0,0 +1,63 @@
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    A snapshot keeps a full copy of guest memory, but after taking or restoring one every
+    RAM page carries a dirty trap. Restoring then only copies back the pages the guest
+    wrote to since, so a reset costs the size of the working set rather than 1MB.
+ */
+
+int cpu_snapshot(struct cpu *cpu, struct snapshot *snapshot) {
+    if (!snapshot->memory) {
+        snapshot->memory = malloc(MEMORY_SIZE);
+        if (!snapshot->memory) return -1;
+    }
+
+    snapshot->reg = cpu->reg;
+    snapshot->lazy = cpu->lazy;
+    snapshot->state = cpu->state;
+    snapshot->cycles = cpu->cycles;
+    memcpy(snapshot->memory, cpu->memory.backing, MEMORY_SIZE);
+
+    memory_track_dirty(cpu, snapshot);
+    return 0;
+}
+
+static void cpu_restore_page(struct cpu *cpu, const struct snapshot *snapshot, uint32_t page) {
+    uint32_t offset = page << MEMORY_PAGE_SHIFT;
+    memcpy(cpu->memory.backing + offset, snapshot->memory + offset, MEMORY_PAGE_SIZE);
+    block_notify_write(cpu, offset, MEMORY_PAGE_SIZE);
+    if (cpu->memory.traps[page] & MEMORY_TRAP_NOTIFY) memory_notify_write(cpu, offset, MEMORY_PAGE_SIZE);
+}
+
+void cpu_restore(struct cpu *cpu, const struct snapshot *snapshot) {
+    cpu->reg = snapshot->reg;
+    cpu->lazy = snapshot->lazy;
+    cpu->state = snapshot->state;
+    cpu->cycles = snapshot->cycles;
+
+    if (cpu->memory.dirty_base == snapshot) {
+        for (size_t i = 0; i < cpu->memory.dirty_count; i++) {
+            uint32_t page = cpu->memory.dirty_pages[i];
+            cpu_restore_page(cpu, snapshot, page);
+            memory_set_trap(cpu, page, MEMORY_TRAP_DIRTY);
+        }
+        cpu->memory.dirty_count = 0;
+        return;
+    }
+
+    // Dirty pages were tracked against some other snapshot, so copy everything
+    for (uint32_t page = 0; page < MEMORY_PAGES; page++)
+        if (cpu->memory.type[page] == MEMORY_RAM || cpu->memory.type[page] == MEMORY_ROM)
+            cpu_restore_page(cpu, snapshot, page);
+    memory_track_dirty(cpu, snapshot);
+}
+
+void cpu_snapshot_free(struct snapshot *snapshot) {
+    free(snapshot->memory);
+    snapshot->memory = NULL;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <cpu/string.h>
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static inline uint16_t string_element(const uint8_t *p, uint8_t width) {
+    return width == 1 ? p[0] : p[0] | p[1] << 8;
+}
+
+// 16 bytes at a time, movemask has one bit per byte so a word match shows up as a pair of bits
+size_t string_compare(const uint8_t *a, const uint8_t *b, size_t count, uint8_t width, int until_equal) {
+    size_t i = 0;
+#ifdef __SSE2__
+    size_t per = 16 / width;
+    for (; i + per <= count; i += per) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i * width));
+        __m128i y = _mm_loadu_si128((const __m128i *) (b + i * width));
+        __m128i eq = width == 1 ? _mm_cmpeq_epi8(x, y) : _mm_cmpeq_epi16(x, y);
+        uint32_t mask = _mm_movemask_epi8(eq);
+        if (!until_equal) mask ^= 0xffff;
+        if (mask) return i + __builtin_ctz(mask) / width;
+    }
+#endif
+    for (; i < count; i++)
+        if ((string_element(a + i * width, width) == string_element(b + i * width, width)) == !!until_equal) return i;
+    return count;
+}
+
+size_t string_scan(const uint8_t *a, uint16_t value, size_t count, uint8_t width, int until_equal) {
+    size_t i = 0;
+    if (width == 1) value &= 0xff;
+
+    // memchr is already vectorised by libc
+    if (width == 1 && until_equal) {
+        const uint8_t *hit = memchr(a, value, count);
+        return hit ? (size_t) (hit - a) : count;
+    }
+#ifdef __SSE2__
+    size_t per = 16 / width;
+    __m128i y = width == 1 ? _mm_set1_epi8((char) value) : _mm_set1_epi16((short) value);
+    for (; i + per <= count; i += per) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i * width));
+        __m128i eq = width == 1 ? _mm_cmpeq_epi8(x, y) : _mm_cmpeq_epi16(x, y);
+        uint32_t mask = _mm_movemask_epi8(eq);
+        if (!until_equal) mask ^= 0xffff;
+        if (mask) return i + __builtin_ctz(mask) / width;
+    }
+#endif
+    for (; i < count; i++)
+        if ((string_element(a + i * width, width) == value) == !!until_equal) return i;
+    return count;
+}
\ No newline at end of file
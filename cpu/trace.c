@@ -0,0 +1,106 @@
+#include <cpu/cpu.h>
+#include <cpu/trace.h>
+#include <cpu/flags.h>
+#include <cpu/opcodes.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int trace_create(struct cpu *cpu, uint8_t level, size_t records, const char *path) {
+    struct trace *trace = calloc(1, sizeof(struct trace));
+    if (!trace) return -1;
+
+    if (level > TRACE_LEVEL) level = TRACE_LEVEL;
+    trace->level = level;
+    trace->path = path;
+
+    if (level == TRACE_BINARY) {
+        trace->ring = calloc(records, sizeof(struct trace_record));
+        if (!trace->ring) {
+            free(trace);
+            return -1;
+        }
+        trace->size = records;
+    }
+
+    cpu->trace = trace;
+    return 0;
+}
+
+void trace_destroy(struct cpu *cpu) {
+    if (!cpu->trace) return;
+    free(cpu->trace->ring);
+    free(cpu->trace);
+    cpu->trace = NULL;
+}
+
+// Compiled out with tracing so an untraced build never touches stdout
+void trace_text(struct cpu *cpu, uint16_t ip, uint8_t opcode_byte) {
+    (void) cpu;
+    (void) ip;
+#if TRACE_LEVEL >= TRACE_TEXT
+    printf("[*] %s\n", opcodes[opcode_byte].name);
+#else
+    (void) opcode_byte;
+#endif
+}
+
+void trace_record(struct cpu *cpu, uint16_t ip, uint8_t opcode_byte) {
+    struct trace *trace = cpu->trace;
+    struct trace_record *record = &trace->ring[trace->head];
+
+    record->cs = cpu->reg.cs;
+    record->ip = ip;
+    record->opcode = opcode_byte;
+    record->reserved = 0;
+    record->flags = flags_get(cpu);
+    record->ax = cpu->reg.ax;
+    record->bx = cpu->reg.bx;
+    record->cx = cpu->reg.cx;
+    record->dx = cpu->reg.dx;
+    record->sp = cpu->reg.sp;
+    record->bp = cpu->reg.bp;
+    record->si = cpu->reg.si;
+    record->di = cpu->reg.di;
+    record->ds = cpu->reg.ds;
+    record->es = cpu->reg.es;
+    record->ss = cpu->reg.ss;
+
+    if (++trace->head == trace->size) trace->head = 0;
+    if (trace->count < trace->size) trace->count++;
+}
+
+// Writes the ring oldest record first, behind a trace_header
+int trace_dump(struct cpu *cpu, FILE *out) {
+    struct trace *trace = cpu->trace;
+    if (!trace || !trace->ring) return -1;
+
+    struct trace_header header = {0};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(struct trace_record);
+    header.count = trace->count;
+
+    if (fwrite(&header, sizeof(header), 1, out) != 1) return -1;
+
+    size_t start = (trace->head + trace->size - trace->count) % trace->size;
+    size_t first = trace->count < trace->size - start ? trace->count : trace->size - start;
+
+    if (fwrite(&trace->ring[start], sizeof(struct trace_record), first, out) != first) return -1;
+    if (fwrite(trace->ring, sizeof(struct trace_record), trace->count - first, out) != trace->count - first) return -1;
+    return 0;
+}
+
+// Called once the CPU stops, either through HLT or a fault
+void trace_halt(struct cpu *cpu) {
+    struct trace *trace = cpu->trace;
+    if (!trace || trace->level != TRACE_BINARY || !trace->path || !trace->count) return;
+
+    FILE *out = fopen(trace->path, "wb");
+    if (!out) return;
+    trace_dump(cpu, out);
+    fclose(out);
+
+    trace->count = 0;
+    trace->head = 0;
+}
\ No newline at end of file
@@ -0,0 +1,381 @@
+#include <devices/hle.h>
+#include <cpu/memory.h>
+#include <cpu/io.h>
+
+#include <string.h>
+#include <time.h>
+
+static inline uint32_t hle_cell(struct hle *hle, uint8_t row, uint8_t column) {
+    return hle->video_base + (row * VIDEO_COLUMNS + column) * 2;
+}
+
+// Cursor moves are mirrored into the CRTC so the adapter and the BIOS data area agree
+static void hle_set_cursor(struct hle *hle, uint8_t row, uint8_t column) {
+    struct cpu *cpu = hle->cpu;
+    uint16_t port = memory_read_word(cpu, HLE_BDA_CRTC_PORT);
+    uint16_t offset = row * VIDEO_COLUMNS + column;
+
+    memory_write_byte(cpu, HLE_BDA_CURSOR, column);
+    memory_write_byte(cpu, HLE_BDA_CURSOR + 1, row);
+    io_write_byte(cpu, port, 14);
+    io_write_byte(cpu, port + 1, offset >> 8);
+    io_write_byte(cpu, port, 15);
+    io_write_byte(cpu, port + 1, offset & 0xff);
+}
+
+// Moves the window between (top, left) and (bottom, right) by lines, 0 lines blanks all of it
+static void hle_scroll(struct hle *hle, int lines, uint8_t attr, uint8_t top, uint8_t left, uint8_t bottom, uint8_t right) {
+    struct cpu *cpu = hle->cpu;
+    if (bottom >= VIDEO_ROWS) bottom = VIDEO_ROWS - 1;
+    if (right >= VIDEO_COLUMNS) right = VIDEO_COLUMNS - 1;
+    if (top > bottom || left > right) return;
+
+    int height = bottom - top + 1;
+    if (!lines || lines >= height || -lines >= height) lines = 0;
+    uint32_t width = (right - left + 1) * 2;
+
+    uint8_t *screen = memory_span(cpu, hle_cell(hle, 0, 0), VIDEO_ROWS * VIDEO_ROW_BYTES, 1);
+    for (int i = 0; i < height; i++) {
+        // Walk against the direction of the move so rows are read before they are overwritten
+        int row = lines >= 0 ? top + i : bottom - i;
+        int from = row + lines;
+        uint32_t target = hle_cell(hle, row, left);
+
+        for (uint32_t j = 0; j < width; j += 2) {
+            uint16_t cell = attr << 8 | ' ';
+            if (lines && from >= top && from <= bottom) cell = memory_read_word(cpu, hle_cell(hle, from, left) + j);
+            if (screen) memcpy(screen + (target - hle_cell(hle, 0, 0)) + j, &cell, 2);
+            else memory_write_word(cpu, target + j, cell);
+        }
+    }
+}
+
+// TTY output: control characters move the cursor, running off the bottom scrolls the screen
+void hle_teletype(struct hle *hle, uint8_t ch) {
+    struct cpu *cpu = hle->cpu;
+    uint8_t column = memory_read_byte(cpu, HLE_BDA_CURSOR);
+    uint8_t row = memory_read_byte(cpu, HLE_BDA_CURSOR + 1);
+
+    switch (ch) {
+        case '\a':
+            return;
+        case '\b':
+            if (column) column--;
+            break;
+        case '\r':
+            column = 0;
+            break;
+        case '\n':
+            row++;
+            break;
+        default:
+            memory_write_byte(cpu, hle_cell(hle, row, column), ch);
+            if (++column == VIDEO_COLUMNS) {
+                column = 0;
+                row++;
+            }
+            break;
+    }
+
+    if (row == VIDEO_ROWS) {
+        uint8_t attr = memory_read_byte(cpu, hle_cell(hle, VIDEO_ROWS - 1, 0) + 1);
+        hle_scroll(hle, 1, attr, 0, 0, VIDEO_ROWS - 1, VIDEO_COLUMNS - 1);
+        row = VIDEO_ROWS - 1;
+    }
+    hle_set_cursor(hle, row, column);
+}
+
+static int hle_video(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint8_t column = memory_read_byte(cpu, HLE_BDA_CURSOR);
+    uint8_t row = memory_read_byte(cpu, HLE_BDA_CURSOR + 1);
+
+    switch (hle_reg8(cpu, HLE_AH)) {
+        case 0x00:
+            memory_write_byte(cpu, HLE_BDA_VIDEO_MODE, hle_reg8(cpu, HLE_AL) & 0x7f);
+            hle_scroll(hle, 0, 0x07, 0, 0, VIDEO_ROWS - 1, VIDEO_COLUMNS - 1);
+            hle_set_cursor(hle, 0, 0);
+            return 1;
+        case 0x01:
+            return 1;
+        case 0x02:
+            hle_set_cursor(hle, hle_reg8(cpu, HLE_DH), hle_reg8(cpu, HLE_DL));
+            return 1;
+        case 0x03:
+            hle_set_reg8(cpu, HLE_DH, row);
+            hle_set_reg8(cpu, HLE_DL, column);
+            cpu->reg.cx = 0x0607;
+            return 1;
+        case 0x05:
+            return 1;
+        case 0x06:
+        case 0x07: {
+            int lines = hle_reg8(cpu, HLE_AL);
+            hle_scroll(hle, hle_reg8(cpu, HLE_AH) == 0x06 ? lines : -lines, hle_reg8(cpu, HLE_BH),
+                       hle_reg8(cpu, HLE_CH), hle_reg8(cpu, HLE_CL), hle_reg8(cpu, HLE_DH), hle_reg8(cpu, HLE_DL));
+            return 1;
+        }
+        case 0x08:
+            cpu->reg.ax = memory_read_word(cpu, hle_cell(hle, row, column));
+            return 1;
+        case 0x09:
+        case 0x0a: {
+            // Repeats at the cursor without moving it, 0Ah leaves the attributes alone
+            uint32_t cell = hle_cell(hle, row, column);
+            uint32_t end = hle_cell(hle, VIDEO_ROWS, 0);
+            for (uint16_t i = 0; i < cpu->reg.cx && cell < end; i++, cell += 2) {
+                memory_write_byte(cpu, cell, hle_reg8(cpu, HLE_AL));
+                if (hle_reg8(cpu, HLE_AH) == 0x09) memory_write_byte(cpu, cell + 1, hle_reg8(cpu, HLE_BL));
+            }
+            return 1;
+        }
+        case 0x0e:
+            hle_teletype(hle, hle_reg8(cpu, HLE_AL));
+            return 1;
+        case 0x0f:
+            hle_set_reg8(cpu, HLE_AL, memory_read_byte(cpu, HLE_BDA_VIDEO_MODE));
+            hle_set_reg8(cpu, HLE_AH, VIDEO_COLUMNS);
+            hle_set_reg8(cpu, HLE_BH, 0);
+            return 1;
+        case 0x13: {
+            // ES:BP string of CX characters at DH:DL, AL bit 1 says attributes are interleaved
+            uint8_t mode = hle_reg8(cpu, HLE_AL);
+            uint32_t string = hle_linear(cpu->reg.es, cpu->reg.bp);
+            hle_set_cursor(hle, hle_reg8(cpu, HLE_DH), hle_reg8(cpu, HLE_DL));
+            for (uint16_t i = 0; i < cpu->reg.cx; i++) {
+                uint8_t ch = memory_read_byte(cpu, string++);
+                uint8_t attr = (mode & 2) ? memory_read_byte(cpu, string++) : hle_reg8(cpu, HLE_BL);
+                uint8_t at_column = memory_read_byte(cpu, HLE_BDA_CURSOR);
+                uint8_t at_row = memory_read_byte(cpu, HLE_BDA_CURSOR + 1);
+                hle_teletype(hle, ch);
+                if (ch >= ' ') memory_write_byte(cpu, hle_cell(hle, at_row, at_column) + 1, attr);
+            }
+            if (!(mode & 1)) hle_set_cursor(hle, row, column);
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+static struct hle_disk *hle_disk(struct hle *hle, uint8_t drive) {
+    uint8_t slot = (drive & 0x80) ? 2 + (drive & 0x7f) : drive;
+    if (slot >= HLE_DISKS || !hle->disks[slot].transfer) return NULL;
+    return &hle->disks[slot];
+}
+
+static void hle_disk_done(struct hle *hle, uint8_t status) {
+    hle->disk_status = status;
+    hle_set_reg8(hle->cpu, HLE_AH, status);
+    hle_carry(hle->cpu, status != HLE_DISK_OK);
+}
+
+// CHS from CX and DH the way INT 13h packs them: cylinder bits 8-9 ride in the top of CL
+static int hle_disk_chs(struct hle *hle, struct hle_disk *disk, uint8_t write) {
+    struct cpu *cpu = hle->cpu;
+    uint16_t cylinder = hle_reg8(cpu, HLE_CH) | (hle_reg8(cpu, HLE_CL) & 0xc0) << 2;
+    uint8_t sector = hle_reg8(cpu, HLE_CL) & 0x3f;
+    uint8_t head = hle_reg8(cpu, HLE_DH);
+    uint8_t count = hle_reg8(cpu, HLE_AL);
+
+    if (!sector || sector > disk->sectors || head >= disk->heads || cylinder >= disk->cylinders)
+        return HLE_DISK_NOT_FOUND;
+
+    uint32_t lba = (cylinder * disk->heads + head) * disk->sectors + sector - 1;
+    if (lba + count > disk->total) return HLE_DISK_NOT_FOUND;
+
+    int status = disk->transfer(disk->ctx, cpu, lba, count, hle_linear(cpu->reg.es, cpu->reg.bx), write);
+    if (status == HLE_DISK_OK) hle_set_reg8(cpu, HLE_AL, count);
+    else hle_set_reg8(cpu, HLE_AL, 0);
+    return status;
+}
+
+// Extended read and write take a disk address packet at DS:SI with a 64 bit LBA
+static int hle_disk_lba(struct hle *hle, struct hle_disk *disk, uint8_t write) {
+    struct cpu *cpu = hle->cpu;
+    uint32_t packet = hle_linear(cpu->reg.ds, cpu->reg.si);
+    uint16_t count = memory_read_word(cpu, packet + 2);
+    uint32_t buffer = hle_linear(memory_read_word(cpu, packet + 6), memory_read_word(cpu, packet + 4));
+    uint32_t lba = memory_read_word(cpu, packet + 8) | (uint32_t) memory_read_word(cpu, packet + 10) << 16;
+
+    if (memory_read_word(cpu, packet + 12) || memory_read_word(cpu, packet + 14) || lba + count > disk->total) {
+        memory_write_word(cpu, packet + 2, 0);
+        return HLE_DISK_NOT_FOUND;
+    }
+    return disk->transfer(disk->ctx, cpu, lba, count, buffer, write);
+}
+
+static int hle_disk_service(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint8_t function = hle_reg8(cpu, HLE_AH);
+    uint8_t drive = hle_reg8(cpu, HLE_DL);
+    struct hle_disk *disk = hle_disk(hle, drive);
+
+    switch (function) {
+        case 0x00:
+            hle_disk_done(hle, disk ? HLE_DISK_OK : HLE_DISK_TIMEOUT);
+            return 1;
+        case 0x01:
+            hle_set_reg8(cpu, HLE_AL, hle->disk_status);
+            hle_disk_done(hle, HLE_DISK_OK);
+            return 1;
+        case 0x02:
+        case 0x03:
+            hle_disk_done(hle, disk ? hle_disk_chs(hle, disk, function == 0x03) : HLE_DISK_TIMEOUT);
+            return 1;
+        case 0x08: {
+            if (!disk) {
+                hle_disk_done(hle, HLE_DISK_BAD_COMMAND);
+                return 1;
+            }
+            uint16_t cylinder = disk->cylinders - 1;
+            uint8_t drives = 0;
+            for (uint8_t i = (drive & 0x80) ? 2 : 0; i < ((drive & 0x80) ? HLE_DISKS : 2); i++)
+                drives += hle->disks[i].transfer != NULL;
+            hle_set_reg8(cpu, HLE_CH, cylinder & 0xff);
+            hle_set_reg8(cpu, HLE_CL, (cylinder >> 2 & 0xc0) | disk->sectors);
+            hle_set_reg8(cpu, HLE_DH, disk->heads - 1);
+            hle_set_reg8(cpu, HLE_DL, drives);
+            // 1.44MB drive type for floppies
+            if (!(drive & 0x80)) hle_set_reg8(cpu, HLE_BL, 0x04);
+            hle_disk_done(hle, HLE_DISK_OK);
+            return 1;
+        }
+        case 0x15:
+            if (!disk) {
+                hle_set_reg8(cpu, HLE_AH, 0);
+            } else if (drive & 0x80) {
+                hle_set_reg8(cpu, HLE_AH, 0x03);
+                cpu->reg.cx = disk->total >> 16;
+                cpu->reg.dx = disk->total & 0xffff;
+            } else {
+                hle_set_reg8(cpu, HLE_AH, 0x01);
+            }
+            hle_carry(cpu, 0);
+            return 1;
+        case 0x41:
+            if (!disk || cpu->reg.bx != 0x55aa) {
+                hle_disk_done(hle, HLE_DISK_BAD_COMMAND);
+                return 1;
+            }
+            cpu->reg.bx = 0xaa55;
+            cpu->reg.cx = 0x0001;
+            hle_disk_done(hle, HLE_DISK_OK);
+            hle_set_reg8(cpu, HLE_AH, 0x01);
+            return 1;
+        case 0x42:
+        case 0x43:
+            hle_disk_done(hle, disk ? hle_disk_lba(hle, disk, function == 0x43) : HLE_DISK_TIMEOUT);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+    A read with no key waiting leaves IP on the INT and parks the CPU in CPU_WAITING, so the guest
+    costs nothing until the host pushes a key. An interrupt taken in the meantime returns to the
+    INT, which then simply waits again.
+ */
+static int hle_keyboard(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint16_t key;
+
+    switch (hle_reg8(cpu, HLE_AH)) {
+        case 0x00:
+        case 0x10:
+            if (!hle_pop_key(hle, &key, 1)) {
+                hle->key_wait = 1;
+                cpu->state |= CPU_WAITING;
+                cpu->reg.ip -= 2;
+                return 1;
+            }
+            hle->key_wait = 0;
+            cpu->reg.ax = key;
+            return 1;
+        case 0x01:
+        case 0x11:
+            if (hle_pop_key(hle, &key, 0)) cpu->reg.ax = key;
+            hle_set_flag(cpu, CPU_FLAGS_ZERO, !hle->key_count);
+            return 1;
+        case 0x02:
+        case 0x12:
+            hle_set_reg8(cpu, HLE_AL, 0);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static inline uint8_t hle_bcd(int value) {
+    return (value / 10) << 4 | value % 10;
+}
+
+static int hle_time(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+
+    switch (hle_reg8(cpu, HLE_AH)) {
+        case 0x00:
+            cpu->reg.cx = memory_read_word(cpu, HLE_BDA_TICKS + 2);
+            cpu->reg.dx = memory_read_word(cpu, HLE_BDA_TICKS);
+            hle_set_reg8(cpu, HLE_AL, memory_read_byte(cpu, HLE_BDA_MIDNIGHT));
+            memory_write_byte(cpu, HLE_BDA_MIDNIGHT, 0);
+            return 1;
+        case 0x01:
+            memory_write_word(cpu, HLE_BDA_TICKS, cpu->reg.dx);
+            memory_write_word(cpu, HLE_BDA_TICKS + 2, cpu->reg.cx);
+            memory_write_byte(cpu, HLE_BDA_MIDNIGHT, 0);
+            return 1;
+        case 0x02:
+            hle_set_reg8(cpu, HLE_CH, hle_bcd(local.tm_hour));
+            hle_set_reg8(cpu, HLE_CL, hle_bcd(local.tm_min));
+            hle_set_reg8(cpu, HLE_DH, hle_bcd(local.tm_sec));
+            hle_set_reg8(cpu, HLE_DL, local.tm_isdst > 0);
+            hle_carry(cpu, 0);
+            return 1;
+        case 0x04:
+            hle_set_reg8(cpu, HLE_CH, hle_bcd((local.tm_year + 1900) / 100));
+            hle_set_reg8(cpu, HLE_CL, hle_bcd(local.tm_year % 100));
+            hle_set_reg8(cpu, HLE_DH, hle_bcd(local.tm_mon + 1));
+            hle_set_reg8(cpu, HLE_DL, hle_bcd(local.tm_mday));
+            hle_carry(cpu, 0);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// IRQ 0: count the tick, acknowledge the PIC and let a guest hook on 1Ch run like the BIOS would
+static int hle_timer(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint32_t ticks = memory_read_word(cpu, HLE_BDA_TICKS) | (uint32_t) memory_read_word(cpu, HLE_BDA_TICKS + 2) << 16;
+
+    if (++ticks >= HLE_TICKS_PER_DAY) {
+        ticks = 0;
+        memory_write_byte(cpu, HLE_BDA_MIDNIGHT, 1);
+    }
+    memory_write_word(cpu, HLE_BDA_TICKS, ticks & 0xffff);
+    memory_write_word(cpu, HLE_BDA_TICKS + 2, ticks >> 16);
+    io_write_byte(cpu, 0x20, 0x20);
+
+    uint16_t offset = memory_read_word(cpu, 0x1c * 4);
+    uint16_t segment = memory_read_word(cpu, 0x1c * 4 + 2);
+    if (offset != HLE_ROM_IRET || segment != HLE_ROM_SEGMENT) cpu_interrupt(cpu, 0x1c);
+    return 1;
+}
+
+// Functions that aren't covered return 0 and go to whatever the vector table holds
+int hle_bios(struct cpu *cpu, uint8_t vector, void *ctx) {
+    struct hle *hle = ctx;
+    switch (vector) {
+        case HLE_VECTOR_TIMER: return hle_timer(hle);
+        case HLE_VECTOR_VIDEO: return hle_video(hle);
+        case HLE_VECTOR_DISK: return hle_disk_service(hle);
+        case HLE_VECTOR_KEYBOARD: return hle_keyboard(hle);
+        case HLE_VECTOR_TIME: return hle_time(hle);
+        default: return 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <devices/disk.h>
+#include <cpu/memory.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard floppy formats, told apart by image size the way most tools do it
+static const struct {
+    uint32_t total;
+    uint16_t cylinders;
+    uint8_t heads;
+    uint8_t sectors;
+} disk_floppies[] = {
+        {320, 40, 1, 8},
+        {360, 40, 1, 9},
+        {640, 40, 2, 8},
+        {720, 40, 2, 9},
+        {1440, 80, 2, 9},
+        {2400, 80, 2, 15},
+        {2880, 80, 2, 18},
+        {5760, 80, 2, 36},
+};
+
+// Anything else is a hard disk with the usual 16 heads and 63 sectors, cylinders capped where CHS ends
+static void disk_guess_geometry(struct disk *disk) {
+    for (size_t i = 0; i < sizeof(disk_floppies) / sizeof(disk_floppies[0]); i++) {
+        if (disk_floppies[i].total != disk->total) continue;
+        disk->cylinders = disk_floppies[i].cylinders;
+        disk->heads = disk_floppies[i].heads;
+        disk->sectors = disk_floppies[i].sectors;
+        return;
+    }
+
+    uint32_t cylinders = disk->total / (16 * 63);
+    disk->heads = 16;
+    disk->sectors = 63;
+    disk->cylinders = cylinders > 1024 ? 1024 : cylinders ? cylinders : 1;
+}
+
+struct disk *disk_open(const char *path, uint8_t mode) {
+    int fd = open(path, (mode == DISK_WRITEBACK ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < DISK_SECTOR_SIZE) {
+        close(fd);
+        return NULL;
+    }
+
+    // A private mapping still has to be writable for the overlay, the file itself never sees it
+    int prot = mode == DISK_READONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = mode == DISK_WRITEBACK ? MAP_SHARED : MAP_PRIVATE;
+    uint8_t *data = mmap(NULL, st.st_size, prot, flags, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    struct disk *disk = calloc(1, sizeof(struct disk));
+    if (!disk) {
+        munmap(data, st.st_size);
+        return NULL;
+    }
+
+    disk->data = data;
+    disk->size = st.st_size;
+    disk->mode = mode;
+    disk->total = st.st_size / DISK_SECTOR_SIZE;
+    disk_guess_geometry(disk);
+    return disk;
+}
+
+void disk_close(struct disk *disk) {
+    if (!disk) return;
+    disk_sync(disk);
+    munmap(disk->data, disk->size);
+    free(disk);
+}
+
+// CHS only bounds what the BIOS calls can address, LBA transfers still reach every sector
+int disk_set_geometry(struct disk *disk, uint16_t cylinders, uint8_t heads, uint8_t sectors) {
+    if (!cylinders || !heads || !sectors || sectors > 63 || cylinders > 1024) return -1;
+    if ((uint64_t) cylinders * heads * sectors > disk->total) return -1;
+    disk->cylinders = cylinders;
+    disk->heads = heads;
+    disk->sectors = sectors;
+    return 0;
+}
+
+int disk_sync(struct disk *disk) {
+    if (disk->mode != DISK_WRITEBACK) return 0;
+    return msync(disk->data, disk->size, MS_SYNC);
+}
+
+// hle_disk transfer hook. Guest RAM that memory_span can't hand out whole goes a byte at a time.
+int disk_transfer(void *ctx, struct cpu *cpu, uint32_t lba, uint32_t count, uint32_t addr, int write) {
+    struct disk *disk = ctx;
+    if (lba > disk->total || count > disk->total - lba) return HLE_DISK_NOT_FOUND;
+    if (write && disk->mode == DISK_READONLY) return HLE_DISK_WRITE_PROTECTED;
+
+    uint8_t *image = disk->data + (size_t) lba * DISK_SECTOR_SIZE;
+    uint32_t size = count * DISK_SECTOR_SIZE;
+    uint8_t *ram = memory_span(cpu, addr, size, !write);
+
+    if (ram) {
+        if (write) memcpy(image, ram, size);
+        else memcpy(ram, image, size);
+    } else {
+        for (uint32_t i = 0; i < size; i++) {
+            if (write) image[i] = memory_read_byte(cpu, addr + i);
+            else memory_write_byte(cpu, addr + i, image[i]);
+        }
+    }
+
+    // Start write-back early without waiting for it, disk_sync is where it has to be on disk
+    if (write && disk->mode == DISK_WRITEBACK) {
+        uintptr_t page = sysconf(_SC_PAGESIZE);
+        uintptr_t start = (uintptr_t) image & ~(page - 1);
+        msync((void *) start, (uintptr_t) image + size - start, MS_ASYNC);
+    }
+    return HLE_DISK_OK;
+}
+
+void disk_hle(struct disk *disk, struct hle_disk *hle) {
+    *hle = (struct hle_disk) {
+            .transfer = disk_transfer,
+            .ctx = disk,
+            .cylinders = disk->cylinders,
+            .heads = disk->heads,
+            .sectors = disk->sectors,
+            .total = disk->total,
+    };
+}
\ No newline at end of file
@@ -0,0 +1,492 @@
+#define _GNU_SOURCE
+
+#include <devices/hle.h>
+#include <cpu/memory.h>
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DOS_PATH_MAX 128
+
+#define DOS_ERROR_FUNCTION 0x01
+#define DOS_ERROR_FILE 0x02
+#define DOS_ERROR_PATH 0x03
+#define DOS_ERROR_HANDLES 0x04
+#define DOS_ERROR_ACCESS 0x05
+#define DOS_ERROR_HANDLE 0x06
+#define DOS_ERROR_MEMORY 0x08
+#define DOS_ERROR_BLOCK 0x09
+
+static inline int dos_fail(struct cpu *cpu, uint16_t error) {
+    cpu->reg.ax = error;
+    hle_carry(cpu, 1);
+    return 1;
+}
+
+static inline int dos_ok(struct cpu *cpu) {
+    hle_carry(cpu, 0);
+    return 1;
+}
+
+static int dos_error(int error) {
+    switch (error) {
+        case ENOENT: return DOS_ERROR_FILE;
+        case ENOTDIR: return DOS_ERROR_PATH;
+        case EMFILE:
+        case ENFILE: return DOS_ERROR_HANDLES;
+        case EBADF: return DOS_ERROR_HANDLE;
+        default: return DOS_ERROR_ACCESS;
+    }
+}
+
+static void dos_output(struct hle *hle, uint8_t ch) {
+    if (hle->console_out) fputc(ch, hle->console_out);
+    if (hle->video) hle_teletype(hle, ch);
+}
+
+// Keys pushed by the host come first, then the console stream, -1 when neither has anything
+static int dos_input(struct hle *hle) {
+    uint16_t key;
+    if (hle_pop_key(hle, &key, 1)) return key & 0xff;
+    if (!hle->console_in) return -1;
+    int ch = fgetc(hle->console_in);
+    return ch == '\n' ? '\r' : ch;
+}
+
+// Copies an ASCIIZ guest path into a host one relative to root: no drive, forward slashes, no way out
+static int dos_path(struct cpu *cpu, uint32_t addr, char *path) {
+    size_t length = 0;
+    for (;;) {
+        char ch = memory_read_byte(cpu, addr++);
+        if (!ch) break;
+        if (length == DOS_PATH_MAX - 1) return -1;
+        path[length++] = ch == '\\' ? '/' : ch;
+    }
+    path[length] = 0;
+
+    if (length >= 2 && path[1] == ':') memmove(path, path + 2, length - 1);
+    while (path[0] == '/') memmove(path, path + 1, strlen(path));
+    if (!path[0]) strcpy(path, ".");
+
+    for (char *part = path; part; part = strchr(part, '/')) {
+        if (*part == '/') part++;
+        if (part[0] == '.' && part[1] == '.' && (!part[2] || part[2] == '/')) return -1;
+    }
+    return 0;
+}
+
+/*
+    Opens the directory holding the last component of path, one component at a time from root
+    with O_NOFOLLOW, so a symlink anywhere along the way can't lead outside it. leaf is left
+    pointing at the last component, the directory goes back through dos_close_parent.
+ */
+static int dos_parent(struct hle *hle, char *path, const char **leaf) {
+    int dir = hle->root;
+    char *part = path, *slash;
+
+    while ((slash = strchr(part, '/'))) {
+        if (slash != part) {
+            *slash = 0;
+            int next = openat(dir, part, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            *slash = '/';
+            if (dir != hle->root) close(dir);
+            if (next < 0) return -1;
+            dir = next;
+        }
+        part = slash + 1;
+    }
+    *leaf = *part ? part : ".";
+    return dir;
+}
+
+static void dos_close_parent(struct hle *hle, int dir) {
+    int saved = errno;
+    if (dir >= 0 && dir != hle->root) close(dir);
+    errno = saved;
+}
+
+static int dos_open_beneath(struct hle *hle, char *path, int flags, mode_t mode) {
+    const char *leaf;
+    int dir = dos_parent(hle, path, &leaf);
+    int fd = dir < 0 ? -1 : openat(dir, leaf, flags | O_CLOEXEC | O_NOFOLLOW, mode);
+    dos_close_parent(hle, dir);
+    return fd;
+}
+
+// DOS names are case insensitive, host ones usually lowercase
+static int dos_openat(struct hle *hle, char *path, int flags, mode_t mode) {
+    int fd = dos_open_beneath(hle, path, flags, mode);
+    if (fd >= 0 || errno != ENOENT) return fd;
+    for (char *c = path; *c; c++) *c = tolower((unsigned char) *c);
+    return dos_open_beneath(hle, path, flags, mode);
+}
+
+static int dos_unlink_beneath(struct hle *hle, char *path) {
+    const char *leaf;
+    int dir = dos_parent(hle, path, &leaf);
+    int result = dir < 0 ? -1 : unlinkat(dir, leaf, 0);
+    dos_close_parent(hle, dir);
+    return result;
+}
+
+static int dos_stat_beneath(struct hle *hle, char *path, struct stat *st) {
+    const char *leaf;
+    int dir = dos_parent(hle, path, &leaf);
+    int result = dir < 0 ? -1 : fstatat(dir, leaf, st, AT_SYMLINK_NOFOLLOW);
+    dos_close_parent(hle, dir);
+    return result;
+}
+
+static int dos_handle(struct hle *hle, uint16_t handle) {
+    if (handle >= HLE_FILES) return -1;
+    return hle->files[handle];
+}
+
+static int dos_open(struct hle *hle, int flags) {
+    struct cpu *cpu = hle->cpu;
+    char path[DOS_PATH_MAX];
+    if (dos_path(cpu, hle_linear(cpu->reg.ds, cpu->reg.dx), path) < 0) return dos_fail(cpu, DOS_ERROR_PATH);
+
+    int handle = 5;
+    while (handle < HLE_FILES && hle->files[handle] >= 0) handle++;
+    if (handle == HLE_FILES) return dos_fail(cpu, DOS_ERROR_HANDLES);
+
+    int fd = dos_openat(hle, path, flags, 0644);
+    if (fd < 0) return dos_fail(cpu, dos_error(errno));
+    hle->files[handle] = fd;
+    cpu->reg.ax = handle;
+    return dos_ok(cpu);
+}
+
+// Reads and writes go straight between the descriptor and guest RAM, a bounce buffer covers the rest
+static int dos_transfer(struct hle *hle, int output) {
+    struct cpu *cpu = hle->cpu;
+    int fd = dos_handle(hle, cpu->reg.bx);
+    uint32_t addr = hle_linear(cpu->reg.ds, cpu->reg.dx);
+    uint16_t count = cpu->reg.cx;
+    if (fd == -1) return dos_fail(cpu, DOS_ERROR_HANDLE);
+
+    if (fd == HLE_FILE_CONSOLE) {
+        uint16_t done = 0;
+        for (; done < count; done++) {
+            if (output) {
+                dos_output(hle, memory_read_byte(cpu, addr + done));
+                continue;
+            }
+            int ch = dos_input(hle);
+            if (ch < 0) break;
+            memory_write_byte(cpu, addr + done, ch);
+            if (ch == '\r') {
+                if (++done < count) memory_write_byte(cpu, addr + done++, '\n');
+                break;
+            }
+        }
+        cpu->reg.ax = done;
+        return dos_ok(cpu);
+    }
+
+    // A zero length write truncates at the file pointer
+    if (output && !count) {
+        if (ftruncate(fd, lseek(fd, 0, SEEK_CUR)) < 0) return dos_fail(cpu, dos_error(errno));
+        cpu->reg.ax = 0;
+        return dos_ok(cpu);
+    }
+
+    ssize_t done;
+    uint8_t *span = count ? memory_span(cpu, addr, count, !output) : NULL;
+    if (span) {
+        done = output ? write(fd, span, count) : read(fd, span, count);
+    } else {
+        uint8_t buffer[4096];
+        done = 0;
+        while (done < count) {
+            size_t left = count - done;
+            size_t chunk = left < sizeof(buffer) ? left : sizeof(buffer);
+            ssize_t moved;
+            if (output) {
+                for (size_t i = 0; i < chunk; i++) buffer[i] = memory_read_byte(cpu, addr + done + i);
+                moved = write(fd, buffer, chunk);
+            } else {
+                moved = read(fd, buffer, chunk);
+                for (ssize_t i = 0; i < moved; i++) memory_write_byte(cpu, addr + done + i, buffer[i]);
+            }
+            if (moved <= 0) {
+                if (moved < 0 && !done) done = -1;
+                break;
+            }
+            done += moved;
+        }
+    }
+
+    if (done < 0) return dos_fail(cpu, dos_error(errno));
+    cpu->reg.ax = done;
+    return dos_ok(cpu);
+}
+
+static int dos_seek(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    int fd = dos_handle(hle, cpu->reg.bx);
+    static const int whence[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+    uint8_t origin = hle_reg8(cpu, HLE_AL);
+    if (fd == -1) return dos_fail(cpu, DOS_ERROR_HANDLE);
+    if (origin > 2) return dos_fail(cpu, DOS_ERROR_FUNCTION);
+
+    if (fd == HLE_FILE_CONSOLE) {
+        cpu->reg.ax = cpu->reg.dx = 0;
+        return dos_ok(cpu);
+    }
+
+    int32_t offset = (int32_t) ((uint32_t) cpu->reg.cx << 16 | cpu->reg.dx);
+    // Relative seeks take CX:DX as signed, an absolute one as an unsigned position
+    off_t position = lseek(fd, origin ? (off_t) offset : (off_t) (uint32_t) offset, whence[origin]);
+    if (position < 0) return dos_fail(cpu, dos_error(errno));
+    cpu->reg.ax = position & 0xffff;
+    cpu->reg.dx = (position >> 16) & 0xffff;
+    return dos_ok(cpu);
+}
+
+static int dos_close(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    int fd = dos_handle(hle, cpu->reg.bx);
+    if (fd == -1) return dos_fail(cpu, DOS_ERROR_HANDLE);
+    if (fd >= 0) close(fd);
+    hle->files[cpu->reg.bx] = -1;
+    return dos_ok(cpu);
+}
+
+static int dos_unlink(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    char path[DOS_PATH_MAX];
+    if (dos_path(cpu, hle_linear(cpu->reg.ds, cpu->reg.dx), path) < 0) return dos_fail(cpu, DOS_ERROR_PATH);
+    if (dos_unlink_beneath(hle, path) < 0) {
+        for (char *c = path; *c; c++) *c = tolower((unsigned char) *c);
+        if (dos_unlink_beneath(hle, path) < 0) return dos_fail(cpu, dos_error(errno));
+    }
+    return dos_ok(cpu);
+}
+
+// Only reading attributes is supported: read-only from the host mode bits, directory from the type
+static int dos_attributes(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    char path[DOS_PATH_MAX];
+    struct stat st;
+    if (hle_reg8(cpu, HLE_AL)) return dos_ok(cpu);
+    if (dos_path(cpu, hle_linear(cpu->reg.ds, cpu->reg.dx), path) < 0) return dos_fail(cpu, DOS_ERROR_PATH);
+    if (dos_stat_beneath(hle, path, &st) < 0) {
+        for (char *c = path; *c; c++) *c = tolower((unsigned char) *c);
+        if (dos_stat_beneath(hle, path, &st) < 0) return dos_fail(cpu, dos_error(errno));
+    }
+    cpu->reg.cx = (S_ISDIR(st.st_mode) ? 0x10 : 0) | (st.st_mode & S_IWUSR ? 0 : 0x01);
+    return dos_ok(cpu);
+}
+
+/*
+    Memory blocks are handed out from a bump pointer: each allocation starts where the last one
+    ended and only the most recent block can grow or be given back, others can only stay within
+    what has been handed out. That is all a single program loaded at the bottom of memory needs.
+    Failures report the largest size that would have worked in BX.
+*/
+static int dos_memory(struct hle *hle, uint8_t function) {
+    struct cpu *cpu = hle->cpu;
+    uint16_t segment = cpu->reg.es;
+
+    switch (function) {
+        case 0x48:
+            if (cpu->reg.bx > hle->memory_top - hle->memory_next) {
+                cpu->reg.bx = hle->memory_top - hle->memory_next;
+                return dos_fail(cpu, DOS_ERROR_MEMORY);
+            }
+            cpu->reg.ax = hle->memory_last = hle->memory_next;
+            hle->memory_next += cpu->reg.bx;
+            return dos_ok(cpu);
+        case 0x49:
+            if (!segment || segment >= hle->memory_next) return dos_fail(cpu, DOS_ERROR_BLOCK);
+            if (segment == hle->memory_last) hle->memory_next = segment;
+            return dos_ok(cpu);
+        default: {
+            uint16_t limit = segment == hle->memory_last ? hle->memory_top : hle->memory_next;
+            if (!segment || segment >= limit) return dos_fail(cpu, DOS_ERROR_BLOCK);
+            if ((uint32_t) segment + cpu->reg.bx > limit) {
+                cpu->reg.bx = limit - segment;
+                return dos_fail(cpu, DOS_ERROR_MEMORY);
+            }
+            if (segment == hle->memory_last) hle->memory_next = segment + cpu->reg.bx;
+            return dos_ok(cpu);
+        }
+    }
+}
+
+static void dos_exit(struct hle *hle, uint8_t code) {
+    hle->exited = 1;
+    hle->exit_code = code;
+    if (hle->console_out) fflush(hle->console_out);
+    hle->cpu->state |= CPU_HALTED;
+}
+
+// Buffered input into DS:DX: max length, returned length, then the line ending in CR
+static int dos_read_line(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint32_t buffer = hle_linear(cpu->reg.ds, cpu->reg.dx);
+    uint8_t max = memory_read_byte(cpu, buffer);
+    uint8_t length = 0;
+    if (!max) return 1;
+
+    for (;;) {
+        int ch = dos_input(hle);
+        if (ch < 0 || ch == '\r') break;
+        if (ch == '\b') {
+            if (length) length--;
+            continue;
+        }
+        if (length + 1 == max) continue;
+        memory_write_byte(cpu, buffer + 2 + length++, ch);
+    }
+    memory_write_byte(cpu, buffer + 1, length);
+    memory_write_byte(cpu, buffer + 2 + length, '\r');
+    return 1;
+}
+
+static int dos_service(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+    uint8_t function = hle_reg8(cpu, HLE_AH);
+    time_t now;
+    struct tm local;
+    int ch;
+
+    switch (function) {
+        case 0x00:
+            dos_exit(hle, 0);
+            return 1;
+        case 0x01:
+        case 0x07:
+        case 0x08:
+            ch = dos_input(hle);
+            hle_set_reg8(cpu, HLE_AL, ch < 0 ? 0x1a : ch);
+            if (function == 0x01 && ch >= 0) dos_output(hle, ch);
+            return 1;
+        case 0x02:
+            dos_output(hle, hle_reg8(cpu, HLE_DL));
+            return 1;
+        case 0x06:
+            if (hle_reg8(cpu, HLE_DL) != 0xff) {
+                dos_output(hle, hle_reg8(cpu, HLE_DL));
+                return 1;
+            }
+            ch = dos_input(hle);
+            hle_set_reg8(cpu, HLE_AL, ch < 0 ? 0 : ch);
+            hle_set_flag(cpu, CPU_FLAGS_ZERO, ch < 0);
+            return 1;
+        case 0x09: {
+            uint32_t string = hle_linear(cpu->reg.ds, cpu->reg.dx);
+            for (uint16_t i = 0; i < 0xffff; i++) {
+                uint8_t c = memory_read_byte(cpu, string + i);
+                if (c == '$') break;
+                dos_output(hle, c);
+            }
+            hle_set_reg8(cpu, HLE_AL, '$');
+            return 1;
+        }
+        case 0x0a:
+            return dos_read_line(hle);
+        case 0x0b:
+            hle_set_reg8(cpu, HLE_AL, hle->key_count ? 0xff : 0);
+            return 1;
+        case 0x0e:
+            hle_set_reg8(cpu, HLE_AL, 26);
+            return 1;
+        case 0x19:
+            hle_set_reg8(cpu, HLE_AL, 2);
+            return 1;
+        case 0x1a:
+            hle->dta_segment = cpu->reg.ds;
+            hle->dta_offset = cpu->reg.dx;
+            return 1;
+        case 0x25: {
+            // A guest taking over a vector gets it, and can still chain to the stub it replaced
+            uint8_t vector = hle_reg8(cpu, HLE_AL);
+            memory_write_word(cpu, vector * 4, cpu->reg.dx);
+            memory_write_word(cpu, vector * 4 + 2, cpu->reg.ds);
+            return 1;
+        }
+        case 0x2a:
+        case 0x2c:
+            now = time(NULL);
+            localtime_r(&now, &local);
+            if (function == 0x2a) {
+                cpu->reg.cx = local.tm_year + 1900;
+                hle_set_reg8(cpu, HLE_DH, local.tm_mon + 1);
+                hle_set_reg8(cpu, HLE_DL, local.tm_mday);
+                hle_set_reg8(cpu, HLE_AL, local.tm_wday);
+            } else {
+                hle_set_reg8(cpu, HLE_CH, local.tm_hour);
+                hle_set_reg8(cpu, HLE_CL, local.tm_min);
+                hle_set_reg8(cpu, HLE_DH, local.tm_sec);
+                hle_set_reg8(cpu, HLE_DL, 0);
+            }
+            return 1;
+        case 0x2f:
+            cpu->reg.es = hle->dta_segment;
+            cpu->reg.bx = hle->dta_offset;
+            return 1;
+        case 0x30:
+            cpu->reg.ax = 0x0005;
+            cpu->reg.bx = cpu->reg.cx = 0;
+            return 1;
+        case 0x35: {
+            uint8_t vector = hle_reg8(cpu, HLE_AL);
+            cpu->reg.bx = memory_read_word(cpu, vector * 4);
+            cpu->reg.es = memory_read_word(cpu, vector * 4 + 2);
+            return 1;
+        }
+        case 0x3c:
+            return dos_open(hle, O_RDWR | O_CREAT | O_TRUNC);
+        case 0x3d: {
+            static const int modes[] = {O_RDONLY, O_WRONLY, O_RDWR};
+            uint8_t mode = hle_reg8(cpu, HLE_AL) & 3;
+            if (mode > 2) return dos_fail(cpu, DOS_ERROR_FUNCTION);
+            return dos_open(hle, modes[mode]);
+        }
+        case 0x3e:
+            return dos_close(hle);
+        case 0x3f:
+        case 0x40:
+            return dos_transfer(hle, function == 0x40);
+        case 0x41:
+            return dos_unlink(hle);
+        case 0x42:
+            return dos_seek(hle);
+        case 0x43:
+            return dos_attributes(hle);
+        case 0x47:
+            // The sandbox root is the only directory a program ever sees as current
+            memory_write_byte(cpu, hle_linear(cpu->reg.ds, cpu->reg.si), 0);
+            return dos_ok(cpu);
+        case 0x48:
+        case 0x49:
+        case 0x4a:
+            return dos_memory(hle, function);
+        case 0x4c:
+            dos_exit(hle, hle_reg8(cpu, HLE_AL));
+            return 1;
+        case 0x4d:
+            cpu->reg.ax = hle->exit_code;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+int hle_dos(struct cpu *cpu, uint8_t vector, void *ctx) {
+    struct hle *hle = ctx;
+    (void) cpu;
+    if (vector == HLE_VECTOR_TERMINATE) {
+        dos_exit(hle, 0);
+        return 1;
+    }
+    return dos_service(hle);
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#define _GNU_SOURCE
+
+#include <devices/hle.h>
+#include <cpu/memory.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static const uint8_t hle_bios_vectors[] = {
+        HLE_VECTOR_TIMER, HLE_VECTOR_VIDEO, HLE_VECTOR_DISK, HLE_VECTOR_KEYBOARD, HLE_VECTOR_TIME,
+};
+
+static const uint8_t hle_dos_vectors[] = {HLE_VECTOR_TERMINATE, HLE_VECTOR_DOS};
+
+static inline uint16_t hle_stub(uint8_t vector) {
+    return HLE_ROM_STUBS + vector * 4;
+}
+
+static int (*hle_service(uint8_t vector))(struct cpu *, uint8_t, void *) {
+    for (size_t i = 0; i < sizeof(hle_bios_vectors); i++)
+        if (hle_bios_vectors[i] == vector) return hle_bios;
+    for (size_t i = 0; i < sizeof(hle_dos_vectors); i++)
+        if (hle_dos_vectors[i] == vector) return hle_dos;
+    return NULL;
+}
+
+/*
+    Native handling stays behind the vector table: an INT or IRQ only runs it while the vector
+    still points at the stub, otherwise the guest's handler gets the interrupt. A guest handler
+    that chains on to the old vector lands on the stub, whose INT comes back here with IP right
+    past it. That runs the service and returns through the frame the guest pushed, keeping the
+    flags the service reported in like a RETF 2 would. A service that asks for the INT to run
+    again (INT 16h waiting for a key) leaves IP on the stub and the frame where it is.
+ */
+static int hle_dispatch(struct cpu *cpu, uint8_t vector, void *ctx) {
+    uint16_t stub = hle_stub(vector);
+
+    if (cpu->reg.cs != HLE_ROM_SEGMENT || cpu->reg.ip != stub + 2) {
+        if (memory_read_word(cpu, vector * 4) != stub || memory_read_word(cpu, vector * 4 + 2) != HLE_ROM_SEGMENT) return 0;
+        return hle_service(vector)(cpu, vector, ctx);
+    }
+
+    hle_service(vector)(cpu, vector, ctx);
+    if (cpu->reg.ip != stub + 2) return 1;
+
+    uint32_t frame = hle_linear(cpu->reg.ss, cpu->reg.sp);
+    uint16_t flags = memory_read_word(cpu, frame + 4);
+    cpu->reg.ip = memory_read_word(cpu, frame);
+    cpu->reg.cs = memory_read_word(cpu, frame + 2);
+    cpu->reg.sp += 6;
+    flags_set(cpu, (flags & ~CPU_FLAGS_ARITH) | (flags_get(cpu) & CPU_FLAGS_ARITH));
+    if (cpu->reg.flags & CPU_FLAGS_INTERRUPTS) cpu_set_intr(cpu, cpu->intr);
+    return 1;
+}
+
+// Vector table, BIOS data area and ROM stub the way a PC looks after POST, without running a BIOS
+static void hle_setup_machine(struct hle *hle) {
+    struct cpu *cpu = hle->cpu;
+
+    memory_map_rom(cpu, hle_linear(HLE_ROM_SEGMENT, 0), 0x10000);
+    uint8_t iret = 0xcf;
+    memory_load(cpu, hle_linear(HLE_ROM_SEGMENT, HLE_ROM_IRET), &iret, 1);
+
+    for (uint32_t vector = 0; vector < 256; vector++) {
+        if (memory_read_word(cpu, vector * 4) || memory_read_word(cpu, vector * 4 + 2)) continue;
+        memory_write_word(cpu, vector * 4, HLE_ROM_IRET);
+        memory_write_word(cpu, vector * 4 + 2, HLE_ROM_SEGMENT);
+    }
+
+    // 80x25 colour, one floppy, 640KB
+    memory_write_word(cpu, HLE_BDA_EQUIPMENT, 0x0021);
+    memory_write_word(cpu, HLE_BDA_MEMORY, 640);
+    memory_write_byte(cpu, HLE_BDA_VIDEO_MODE, 3);
+    memory_write_word(cpu, HLE_BDA_COLUMNS, VIDEO_COLUMNS);
+    memory_write_word(cpu, HLE_BDA_CRTC_PORT, 0x3d4);
+}
+
+// root is the host directory DOS file calls are confined to
+struct hle *hle_create(struct cpu *cpu, const char *root) {
+    struct hle *hle = calloc(1, sizeof(struct hle));
+    if (!hle) return NULL;
+
+    hle->cpu = cpu;
+    hle->video_base = 0xb8000;
+    hle->root = open(root ? root : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (hle->root < 0) {
+        free(hle);
+        return NULL;
+    }
+
+    for (int i = 0; i < HLE_FILES; i++) hle->files[i] = i < 5 ? HLE_FILE_CONSOLE : -1;
+    hle->dta_segment = 0;
+    hle->dta_offset = 0x80;
+    hle->memory_next = 0x1000;
+    hle->memory_top = 0xa000;
+
+    hle_setup_machine(hle);
+    for (size_t i = 0; i < sizeof(hle_bios_vectors); i++) hle_enable(hle, hle_bios_vectors[i], 1);
+    for (size_t i = 0; i < sizeof(hle_dos_vectors); i++) hle_enable(hle, hle_dos_vectors[i], 1);
+    return hle;
+}
+
+void hle_destroy(struct hle *hle) {
+    if (!hle) return;
+    for (size_t i = 0; i < sizeof(hle_bios_vectors); i++) hle_enable(hle, hle_bios_vectors[i], 0);
+    for (size_t i = 0; i < sizeof(hle_dos_vectors); i++) hle_enable(hle, hle_dos_vectors[i], 0);
+    for (int i = 5; i < HLE_FILES; i++) {
+        if (hle->files[i] >= 0) close(hle->files[i]);
+    }
+    close(hle->root);
+    free(hle);
+}
+
+// Turning a vector off turns its stub into a bare IRET, for the vector table and anyone chaining to it
+void hle_enable(struct hle *hle, uint8_t vector, int enable) {
+    struct cpu *cpu = hle->cpu;
+    if (!hle_service(vector)) return;
+
+    uint16_t stub = hle_stub(vector);
+    uint8_t code[] = {0xcd, vector, 0xcf, 0xcf};
+    if (!enable) code[0] = 0xcf;
+    memory_load(cpu, hle_linear(HLE_ROM_SEGMENT, stub), code, sizeof(code));
+
+    if (enable) {
+        cpu->hle[vector] = (struct cpu_hle) {hle_dispatch, hle};
+        if (memory_read_word(cpu, vector * 4) == HLE_ROM_IRET && memory_read_word(cpu, vector * 4 + 2) == HLE_ROM_SEGMENT) {
+            memory_write_word(cpu, vector * 4, stub);
+        }
+    } else if (cpu->hle[vector].ctx == hle) {
+        cpu->hle[vector] = (struct cpu_hle) {0};
+    }
+}
+
+void hle_attach_video(struct hle *hle, struct video *video) {
+    hle->video = video;
+    hle->video_base = video->base;
+    uint8_t mono = video->type == VIDEO_MDA;
+    memory_write_byte(hle->cpu, HLE_BDA_VIDEO_MODE, mono ? 7 : 3);
+    memory_write_word(hle->cpu, HLE_BDA_CRTC_PORT, video->port + 4);
+    memory_write_word(hle->cpu, HLE_BDA_EQUIPMENT, mono ? 0x0031 : 0x0021);
+}
+
+// Drives 0x00-0x01 are floppies and 0x80-0x81 hard disks, as INT 13h numbers them
+int hle_attach_disk(struct hle *hle, uint8_t drive, const struct hle_disk *disk) {
+    uint8_t slot = (drive & 0x80) ? 2 + (drive & 0x7f) : drive;
+    if (slot >= HLE_DISKS) return -1;
+    hle->disks[slot] = *disk;
+    return 0;
+}
+
+// key is the scan code in the high byte and the character in the low byte, as INT 16h returns it
+void hle_push_key(struct hle *hle, uint16_t key) {
+    if (hle->key_count == HLE_KEYS) return;
+    hle->keys[(hle->key_head + hle->key_count++) % HLE_KEYS] = key;
+    // Only a CPU parked by INT 16h is woken, one in HLT still waits for its interrupt
+    if (hle->key_wait) {
+        hle->key_wait = 0;
+        hle->cpu->state &= ~CPU_WAITING;
+    }
+}
+
+int hle_pop_key(struct hle *hle, uint16_t *key, int remove) {
+    if (!hle->key_count) return 0;
+    *key = hle->keys[hle->key_head];
+    if (remove) {
+        hle->key_head = (hle->key_head + 1) % HLE_KEYS;
+        hle->key_count--;
+    }
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <devices/pic.h>
+#include <cpu/io.h>
+
+#include <stdlib.h>
+
+// Lowest set bit is the highest priority request
+static inline int pic_highest(uint8_t bits) {
+    return bits ? __builtin_ctz(bits) : 8;
+}
+
+// INTR is up while some unmasked request outranks everything in service
+static void pic_update(struct pic *pic) {
+    int request = pic_highest(pic->irr & ~pic->imr);
+    cpu_set_intr(pic->cpu, request < pic_highest(pic->isr));
+}
+
+static uint8_t pic_acknowledge(void *ctx) {
+    struct pic *pic = ctx;
+    int irq = pic_highest(pic->irr & ~pic->imr);
+
+    // The request went away between INTR and INTA, the 8259 answers with IRQ 7
+    if (irq == 8) {
+        pic_update(pic);
+        return pic->vector_base | 7;
+    }
+
+    pic->irr &= ~(1 << irq);
+    if (!pic->auto_eoi) pic->isr |= 1 << irq;
+    pic_update(pic);
+    return pic->vector_base | irq;
+}
+
+static uint8_t pic_read(void *ctx, uint16_t port) {
+    struct pic *pic = ctx;
+    if (port == PIC_PORT_DATA) return pic->imr;
+    return pic->read_isr ? pic->isr : pic->irr;
+}
+
+static void pic_write_command(struct pic *pic, uint8_t byte) {
+    // ICW1
+    if (byte & 0x10) {
+        pic->init_step = 2;
+        pic->need_icw3 = !(byte & 0x02);
+        pic->need_icw4 = byte & 0x01;
+        pic->imr = 0;
+        pic->isr = 0;
+        pic->irr = 0;
+        pic->auto_eoi = 0;
+        pic->read_isr = 0;
+        pic_update(pic);
+        return;
+    }
+
+    // OCW3, only the IRR/ISR read select matters here
+    if (byte & 0x08) {
+        if (byte & 0x02) pic->read_isr = byte & 0x01;
+        return;
+    }
+
+    // OCW2, non-specific or specific EOI
+    switch (byte & 0xe0) {
+        case 0x20: pic->isr &= pic->isr - 1; break;
+        case 0x60: pic->isr &= ~(1 << (byte & 7)); break;
+        default: break;
+    }
+    pic_update(pic);
+}
+
+static void pic_write_data(struct pic *pic, uint8_t byte) {
+    switch (pic->init_step) {
+        case 2:
+            pic->vector_base = byte & 0xf8;
+            pic->init_step = pic->need_icw3 ? 3 : pic->need_icw4 ? 4 : 0;
+            return;
+        case 3:
+            pic->init_step = pic->need_icw4 ? 4 : 0;
+            return;
+        case 4:
+            pic->auto_eoi = (byte & 0x02) != 0;
+            pic->init_step = 0;
+            return;
+        default:
+            pic->imr = byte;
+            pic_update(pic);
+            return;
+    }
+}
+
+static void pic_write(void *ctx, uint16_t port, uint8_t byte) {
+    if (port == PIC_PORT_COMMAND) pic_write_command(ctx, byte);
+    else pic_write_data(ctx, byte);
+}
+
+// Comes up the way the PC BIOS leaves it: IRQs on vectors 8-15, nothing masked
+struct pic *pic_create(struct cpu *cpu) {
+    if (!cpu->io) return NULL;
+    struct pic *pic = calloc(1, sizeof(struct pic));
+    if (!pic) return NULL;
+
+    pic->cpu = cpu;
+    pic->vector_base = 0x08;
+
+    struct io_device device = {.read = pic_read, .write = pic_write, .ctx = pic};
+    if (io_attach(cpu, PIC_PORT_COMMAND, 2, &device) < 0) {
+        free(pic);
+        return NULL;
+    }
+
+    cpu->intc.acknowledge = pic_acknowledge;
+    cpu->intc.ctx = pic;
+    return pic;
+}
+
+void pic_destroy(struct pic *pic) {
+    if (!pic) return;
+    io_detach(pic->cpu, PIC_PORT_COMMAND, 2);
+    if (pic->cpu->intc.ctx == pic) {
+        pic->cpu->intc.acknowledge = NULL;
+        pic->cpu->intc.ctx = NULL;
+        pic->cpu->intr = 0;
+    }
+    free(pic);
+}
+
+void pic_raise(struct pic *pic, uint8_t irq) {
+    pic->irr |= 1 << irq;
+    pic_update(pic);
+}
+
+void pic_lower(struct pic *pic, uint8_t irq) {
+    pic->irr &= ~(1 << irq);
+    pic_update(pic);
+}
\ No newline at end of file
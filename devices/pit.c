@@ -0,0 +1,156 @@
+#include <devices/pit.h>
+#include <cpu/io.h>
+
+#include <stdlib.h>
+
+static inline uint64_t pit_period(const struct pit_channel *channel) {
+    return channel->reload ? channel->reload : 0x10000;
+}
+
+uint16_t pit_count(struct pit *pit, uint8_t channel_id) {
+    struct pit_channel *channel = &pit->channels[channel_id];
+    if (!channel->counting) return channel->reload;
+
+    uint64_t ticks = (pit->cpu->cycles - channel->start) / PIT_CYCLES_PER_TICK;
+    uint64_t period = pit_period(channel);
+
+    switch (channel->mode) {
+        // Rate generator and square wave reload at zero
+        case 2:
+        case 3:
+            return period - ticks % period;
+        // One-shot modes keep wrapping through 0xffff after the terminal count
+        default:
+            return (period - ticks) & 0xffff;
+    }
+}
+
+static void pit_fire(struct cpu *cpu, void *ctx) {
+    struct pit *pit = ctx;
+    struct pit_channel *channel = &pit->channels[0];
+
+    if (pit->pic) pic_raise(pit->pic, 0);
+
+    // Periodic modes go again a full period after the last deadline, not after now
+    if (channel->mode == 2 || channel->mode == 3)
+        sched_at(cpu, &pit->event, pit->event.deadline + pit_period(channel) * PIT_CYCLES_PER_TICK);
+}
+
+static void pit_load(struct pit *pit, uint8_t channel_id) {
+    struct pit_channel *channel = &pit->channels[channel_id];
+    channel->counting = 1;
+    channel->start = pit->cpu->cycles;
+
+    if (channel_id == 0)
+        sched_at(pit->cpu, &pit->event, channel->start + pit_period(channel) * PIT_CYCLES_PER_TICK);
+}
+
+static void pit_write_control(struct pit *pit, uint8_t byte) {
+    uint8_t channel_id = byte >> 6;
+    // Read-back only exists on the 8254
+    if (channel_id == 3) return;
+
+    struct pit_channel *channel = &pit->channels[channel_id];
+    uint8_t access = (byte >> 4) & 3;
+
+    if (access == PIT_ACCESS_LATCH) {
+        if (!channel->latched) {
+            channel->latch = pit_count(pit, channel_id);
+            channel->latched = 1;
+        }
+        return;
+    }
+
+    channel->access = access;
+    // Modes 6 and 7 are aliases of 2 and 3
+    channel->mode = (byte >> 1) & 7;
+    if (channel->mode > 5) channel->mode -= 4;
+    channel->write_high = 0;
+    channel->read_high = 0;
+    channel->latched = 0;
+
+    // The count stops until a new one is written
+    channel->counting = 0;
+    if (channel_id == 0) sched_cancel(pit->cpu, &pit->event);
+}
+
+static void pit_write_counter(struct pit *pit, uint8_t channel_id, uint8_t byte) {
+    struct pit_channel *channel = &pit->channels[channel_id];
+
+    switch (channel->access) {
+        case PIT_ACCESS_LOW:
+            channel->reload = byte;
+            break;
+        case PIT_ACCESS_HIGH:
+            channel->reload = byte << 8;
+            break;
+        default:
+            if (!channel->write_high) {
+                channel->reload = (channel->reload & 0xff00) | byte;
+                channel->write_high = 1;
+                return;
+            }
+            channel->reload = (channel->reload & 0x00ff) | (byte << 8);
+            channel->write_high = 0;
+            break;
+    }
+    pit_load(pit, channel_id);
+}
+
+static uint8_t pit_read(void *ctx, uint16_t port) {
+    struct pit *pit = ctx;
+    uint8_t channel_id = port - PIT_PORT_BASE;
+    if (channel_id == 3) return 0xff;
+
+    struct pit_channel *channel = &pit->channels[channel_id];
+    uint16_t value = channel->latched ? channel->latch : pit_count(pit, channel_id);
+
+    switch (channel->access) {
+        case PIT_ACCESS_LOW:
+            channel->latched = 0;
+            return value & 0xff;
+        case PIT_ACCESS_HIGH:
+            channel->latched = 0;
+            return value >> 8;
+        default:
+            channel->read_high ^= 1;
+            if (channel->read_high) return value & 0xff;
+            channel->latched = 0;
+            return value >> 8;
+    }
+}
+
+static void pit_write(void *ctx, uint16_t port, uint8_t byte) {
+    struct pit *pit = ctx;
+    if (port == PIT_PORT_CONTROL) pit_write_control(pit, byte);
+    else pit_write_counter(pit, port - PIT_PORT_BASE, byte);
+}
+
+// Channel 0 starts out the way the BIOS programs it, mode 3 with a count of 65536 for 18.2Hz
+struct pit *pit_create(struct cpu *cpu, struct pic *pic) {
+    if (!cpu->io || !cpu->sched) return NULL;
+    struct pit *pit = calloc(1, sizeof(struct pit));
+    if (!pit) return NULL;
+
+    pit->cpu = cpu;
+    pit->pic = pic;
+    sched_event_init(&pit->event, pit_fire, pit);
+    for (int i = 0; i < 3; i++) pit->channels[i].access = PIT_ACCESS_BOTH;
+
+    struct io_device device = {.read = pit_read, .write = pit_write, .ctx = pit};
+    if (io_attach(cpu, PIT_PORT_BASE, 4, &device) < 0) {
+        free(pit);
+        return NULL;
+    }
+
+    pit->channels[0].mode = 3;
+    pit_load(pit, 0);
+    return pit;
+}
+
+void pit_destroy(struct pit *pit) {
+    if (!pit) return;
+    sched_cancel(pit->cpu, &pit->event);
+    io_detach(pit->cpu, PIT_PORT_BASE, 4);
+    free(pit);
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include <devices/video.h>
+#include <cpu/memory.h>
+#include <cpu/io.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define VIDEO_ALL_ROWS ((1u << VIDEO_ROWS) - 1)
+
+// Where each adapter sits and how its beam moves, in CPU cycles per scan line and lines per frame
+struct video_timing {
+    uint32_t base;
+    uint32_t size;
+    uint16_t port;
+    uint16_t line_cycles;
+    uint16_t active_cycles;
+    uint16_t lines;
+    uint16_t active_lines;
+};
+
+static const struct video_timing video_timings[2] = {
+        [VIDEO_CGA] = {0xb8000, 0x4000, 0x3d0, 304, 213, 262, 200},
+        [VIDEO_MDA] = {0xb0000, 0x1000, 0x3b0, 259, 211, 370, 350},
+};
+
+static inline uint32_t video_frame_cycles(const struct video *video) {
+    const struct video_timing *timing = &video_timings[video->type];
+    return timing->line_cycles * timing->lines;
+}
+
+// Marks the rows covering bytes first..last counted from the top left cell
+static inline void video_mark(struct video *video, int64_t first, int64_t last) {
+    if (last < 0 || first >= VIDEO_ROWS * VIDEO_ROW_BYTES) return;
+    if (first < 0) first = 0;
+    if (last >= VIDEO_ROWS * VIDEO_ROW_BYTES) last = VIDEO_ROWS * VIDEO_ROW_BYTES - 1;
+
+    uint32_t rows = (2u << (last / VIDEO_ROW_BYTES)) - (1u << (first / VIDEO_ROW_BYTES));
+    video->dirty |= rows;
+}
+
+// Guest stores land here through the page notify trap, reads never leave the RAM fast path.
+// The screen wraps from the end of video memory back to its start, so a store can hit two spans.
+static void video_write(void *ctx, uint32_t addr, uint32_t size) {
+    struct video *video = ctx;
+    if (size >= video->size) {
+        video->dirty = VIDEO_ALL_ROWS;
+        return;
+    }
+
+    uint32_t first = (addr - video->base + video->size - video->start * 2) % video->size;
+    video_mark(video, first, (int64_t) first + size - 1);
+    if (first + size > video->size) video_mark(video, 0, (int64_t) first + size - 1 - video->size);
+}
+
+// Hands every dirty row to the sink, unchanged rows cost nothing
+void video_render(struct video *video) {
+    uint32_t dirty = video->dirty;
+    if (!dirty || !video->sink.row) return;
+    video->dirty = 0;
+
+    uint8_t *memory = video->cpu->memory.backing + video->base;
+    uint8_t wrapped[VIDEO_ROW_BYTES];
+    while (dirty) {
+        uint8_t row = __builtin_ctz(dirty);
+        dirty &= dirty - 1;
+        uint32_t offset = (video->start * 2 + row * VIDEO_ROW_BYTES) % video->size;
+        const uint8_t *cells = memory + offset;
+
+        // A row running off the end of video memory continues at its start, the sink wants it in one piece
+        if (offset + VIDEO_ROW_BYTES > video->size) {
+            uint32_t head = video->size - offset;
+            memcpy(wrapped, memory + offset, head);
+            memcpy(wrapped + head, memory, VIDEO_ROW_BYTES - head);
+            cells = wrapped;
+        }
+        video->sink.row(video->sink.ctx, row, cells, VIDEO_COLUMNS);
+    }
+    if (video->sink.flush) video->sink.flush(video->sink.ctx);
+}
+
+static void video_frame(struct cpu *cpu, void *ctx) {
+    struct video *video = ctx;
+    video_render(video);
+    sched_at(cpu, &video->frame, video->frame.deadline + video_frame_cycles(video));
+}
+
+// Status bit 0 is set outside the visible part of a line, bit 3 during vertical retrace
+static uint8_t video_status(struct video *video) {
+    const struct video_timing *timing = &video_timings[video->type];
+    uint32_t position = video->cpu->cycles % video_frame_cycles(video);
+    uint32_t line = position / timing->line_cycles;
+    uint32_t dot = position % timing->line_cycles;
+
+    uint8_t status = 0xf0;
+    if (line >= timing->active_lines) status |= 0x09;
+    else if (dot >= timing->active_cycles) status |= 0x01;
+    return status;
+}
+
+static uint8_t video_port_read(void *ctx, uint16_t port) {
+    struct video *video = ctx;
+    switch (port - video->port) {
+        case 0x5: return video->crtc_index >= 14 && video->crtc_index < 18 ? video->crtc[video->crtc_index] : 0xff;
+        case 0xa: return video_status(video);
+        default: return 0xff;
+    }
+}
+
+static void video_port_write(void *ctx, uint16_t port, uint8_t byte) {
+    struct video *video = ctx;
+    switch (port - video->port) {
+        case 0x4:
+            video->crtc_index = byte;
+            return;
+        case 0x5:
+            if (video->crtc_index >= sizeof(video->crtc)) return;
+            video->crtc[video->crtc_index] = byte;
+            // Moving the start address scrolls the whole screen
+            if (video->crtc_index == 12 || video->crtc_index == 13) {
+                video->start = (video->crtc[12] << 8 | video->crtc[13]) & ((video->size >> 1) - 1);
+                video->dirty = VIDEO_ALL_ROWS;
+            }
+            return;
+        default:
+            return;
+    }
+}
+
+struct video *video_create(struct cpu *cpu, uint8_t type, const struct video_sink *sink) {
+    if (!cpu->io || type > VIDEO_MDA) return NULL;
+    struct video *video = calloc(1, sizeof(struct video));
+    if (!video) return NULL;
+
+    const struct video_timing *timing = &video_timings[type];
+    video->cpu = cpu;
+    video->type = type;
+    video->base = timing->base;
+    video->size = timing->size;
+    video->port = timing->port;
+    if (sink) video->sink = *sink;
+
+    struct io_device device = {.read = video_port_read, .write = video_port_write, .ctx = video};
+    if (io_attach(cpu, video->port + 4, 7, &device) < 0) {
+        free(video);
+        return NULL;
+    }
+
+    // Blank screen in light grey on black, the way the BIOS leaves it
+    memory_map_ram(cpu, video->base, video->size);
+    for (uint32_t i = 0; i < video->size; i += 2) {
+        cpu->memory.backing[video->base + i] = ' ';
+        cpu->memory.backing[video->base + i + 1] = 0x07;
+    }
+    video->dirty = VIDEO_ALL_ROWS;
+
+    struct memory_notify notify = {video_write, video};
+    memory_set_notify(cpu, video->base, video->size, &notify);
+
+    sched_event_init(&video->frame, video_frame, video);
+    if (cpu->sched) sched_at(cpu, &video->frame, cpu->cycles + video_frame_cycles(video));
+    return video;
+}
+
+void video_destroy(struct video *video) {
+    if (!video) return;
+    if (video->cpu->sched) sched_cancel(video->cpu, &video->frame);
+    memory_set_notify(video->cpu, video->base, video->size, NULL);
+    io_detach(video->cpu, video->port + 4, 7);
+    free(video);
+}
+
+// Code page 437 only lines up with ASCII in the printable range
+static inline char video_ascii(uint8_t ch) {
+    if (ch > 0x20 && ch < 0x7f) return ch;
+    return ch == 0 || ch == 0x20 || ch == 0xff ? ' ' : '.';
+}
+
+static void video_terminal_row(void *ctx, uint8_t row, const uint8_t *cells, uint8_t columns) {
+    FILE *out = ctx;
+    fprintf(out, "\x1b[%u;1H", row + 1);
+    for (uint8_t i = 0; i < columns; i++) fputc(video_ascii(cells[i * 2]), out);
+}
+
+static void video_terminal_flush(void *ctx) {
+    fflush(ctx);
+}
+
+// Repaints changed rows in place with cursor positioning escapes
+void video_sink_terminal(struct video_sink *sink, FILE *out) {
+    sink->row = video_terminal_row;
+    sink->flush = video_terminal_flush;
+    sink->ctx = out;
+}
+
+struct video_text {
+    char screen[VIDEO_ROWS][VIDEO_COLUMNS];
+    char path[];
+};
+
+static void video_text_row(void *ctx, uint8_t row, const uint8_t *cells, uint8_t columns) {
+    struct video_text *text = ctx;
+    for (uint8_t i = 0; i < columns; i++) text->screen[row][i] = video_ascii(cells[i * 2]);
+}
+
+// The file is rewritten as a whole, but only when a render changed something
+static void video_text_flush(void *ctx) {
+    struct video_text *text = ctx;
+    FILE *out = fopen(text->path, "w");
+    if (!out) return;
+
+    for (int row = 0; row < VIDEO_ROWS; row++) {
+        int length = VIDEO_COLUMNS;
+        while (length && text->screen[row][length - 1] == ' ') length--;
+        fprintf(out, "%.*s\n", length, text->screen[row]);
+    }
+    fclose(out);
+}
+
+// Keeps a plain text copy of the screen in path
+int video_sink_text(struct video_sink *sink, const char *path) {
+    struct video_text *text = malloc(sizeof(struct video_text) + strlen(path) + 1);
+    if (!text) return -1;
+
+    memset(text->screen, ' ', sizeof(text->screen));
+    strcpy(text->path, path);
+    sink->row = video_text_row;
+    sink->flush = video_text_flush;
+    sink->ctx = text;
+    return 0;
+}
+
+void video_sink_text_free(struct video_sink *sink) {
+    free(sink->ctx);
+    sink->ctx = NULL;
+}
\ No newline at end of file
@@ -5,27 +5,122 @@
 
 #include <cpu/cpu.h>
 #include <cpu/opcodes.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/jit.h>
+#include <cpu/trace.h>
+#include <cpu/profile.h>
+#include <cpu/flags.h>
+#include <cpu/io.h>
+#include <cpu/sched.h>
+#include <cpu/gdb.h>
+#include <devices/pic.h>
+#include <devices/pit.h>
+#include <devices/video.h>
+#include <devices/hle.h>
+#include <loader/loader.h>
 
-int main(void) {
-    printf("Hello World!\n");
+// Default instruction budget for a program run from the command line
+#define ENTRY_BUDGET 1000000000ull
 
-    struct cpu cpu = {0};
+// Programs are loaded just above the DOS data area and get conventional memory up to 640KB
+#define ENTRY_LOAD_SEGMENT 0x0100
+#define ENTRY_MEMORY_TOP 0xa000
+
+// Instructions run between checks for the program having exited
+#define ENTRY_SLICE 1000000
+
+static void entry_usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n instructions] [-g unix:path|tcp:port [-w]] [program.com|program.exe [args...]]\n", name);
+}
 
-    // 640KB of goodness
-    cpu.memory = malloc(640 * 1024);
-    cpu.memory_size = 640 * 1024;
+/*
+    Runs a DOS program against the BIOS and DOS emulation with a PC's worth of timer, interrupt
+    controller and CGA text screen. Returns the program's exit code, or 1 if it never exited
+    within the budget. With a debugger address a debugger can attach at any point and from then
+    on the program runs whenever the debugger lets it, with wait set the program holds at its
+    first instruction until one does.
+ */
+static int entry_program(struct cpu *cpu, const char *path, const char *args, uint64_t budget, const char *debugger, int wait) {
+    io_create(cpu);
+    sched_create(cpu);
+    cpu_set_timing(cpu, CPU_TIMING_FAST);
+    cpu->idle = CPU_IDLE_SKIP;
 
-    cpu.reg.ip32 = 0;
-    cpu.reg.ip = 0;
-    cpu.reg.cs = 0;
+    struct pic *pic = pic_create(cpu);
+    struct pit *pit = pit_create(cpu, pic);
+    struct video *video = video_create(cpu, VIDEO_CGA, NULL);
+    struct hle *hle = hle_create(cpu, ".");
+    if (!pic || !pit || !video || !hle) {
+        fprintf(stderr, "%s: failed to set up the machine\n", path);
+        return 1;
+    }
+    hle_attach_video(hle, video);
+    hle->console_in = stdin;
+    hle->console_out = stdout;
 
-    cpu.reg.ss = 0;
-    cpu.reg.sp = 0x900;
+    struct loader_image image;
+    if (loader_load(cpu, path, args, ENTRY_LOAD_SEGMENT, ENTRY_MEMORY_TOP, &image) < 0) {
+        fprintf(stderr, "%s: not a loadable .COM or .EXE\n", path);
+        return 1;
+    }
+    hle->memory_last = image.psp;
+    hle->memory_next = image.end;
+    hle->memory_top = ENTRY_MEMORY_TOP;
+    loader_start(cpu, &image);
+    flags_set(cpu, flags_get(cpu) | CPU_FLAGS_INTERRUPTS);
 
-    opcode_set_reg16_val(cpu.reg.ax, 0xAAFF);
-    opcode_set_reg16_val(cpu.reg.bx, 0xBBBB);
+    struct gdb *gdb = NULL;
+    if (debugger && !(gdb = gdb_create(cpu, debugger))) {
+        fprintf(stderr, "%s: can't listen for a debugger\n", debugger);
+        return 1;
+    }
+    while (gdb && wait && gdb->client < 0) {
+        gdb_wait(gdb, -1);
+        gdb_poll(gdb);
+    }
 
-    printf("AX: 0x%x BX: 0x%x CX: 0x%x\n", opcode_reg8_to_reg16(cpu.reg.ax), opcode_reg8_to_reg16(cpu.reg.bx), opcode_reg8_to_reg16(cpu.reg.cx));
+    uint64_t end = cpu->cycles + budget;
+    for (;;) {
+        if (cpu->cycles >= end || (cpu->state & CPU_HALTED)) break;
+        if (gdb && !gdb_poll(gdb)) {
+            gdb_wait(gdb, 100);
+            continue;
+        }
+        cpu_run(cpu, end - cpu->cycles < ENTRY_SLICE ? end - cpu->cycles : ENTRY_SLICE);
+    }
+
+    int status = 1;
+    if (hle->exited) status = hle->exit_code;
+    else if (cpu->state & CPU_HALTED) fprintf(stderr, "%s: halted at %04x:%04x\n", path, cpu->reg.cs, cpu->reg.ip);
+    else fprintf(stderr, "%s: still running after %llu instructions\n", path, (unsigned long long) budget);
+    if (gdb) {
+        gdb_exit(gdb, status);
+        gdb_destroy(gdb);
+    }
+
+    hle_destroy(hle);
+    video_destroy(video);
+    pit_destroy(pit);
+    pic_destroy(pic);
+    sched_destroy(cpu);
+    io_destroy(cpu);
+    return status;
+}
+
+// With no program on the command line the built-in sample still runs, traced
+static void entry_demo(struct cpu *cpu) {
+    cpu->reg.ip32 = 0;
+    cpu->reg.ip = 0;
+    cpu->reg.cs = 0;
+
+    cpu->reg.ss = 0;
+    cpu->reg.sp = 0x900;
+
+    cpu->reg.ax = 0xAAFF;
+    cpu->reg.bx = 0xBBBB;
+
+    printf("AX: 0x%x BX: 0x%x CX: 0x%x\n", cpu->reg.ax, cpu->reg.bx, cpu->reg.cx);
 
     /*
         xor ax, bx
@@ -42,11 +137,86 @@ int main(void) {
     */
     char code[] = "\x31\xd8\x31\xdb\x50\x59\x21\xd8\x40\x43\x49\x01\xc8\x29\xd8\x39\xc0\xf4";
 
-    memcpy(cpu.memory, code, sizeof(code) - 1);
+    memory_load(cpu, 0, code, sizeof(code) - 1);
 
-    cpu_run(&cpu, sizeof(code) - 1);
+    cpu_run(cpu, 1000);
 
-    printf("AX: 0x%x BX: 0x%x CX: 0x%x FLAGS 0x%x\n", opcode_reg8_to_reg16(cpu.reg.ax), opcode_reg8_to_reg16(cpu.reg.bx), opcode_reg8_to_reg16(cpu.reg.cx), cpu.reg.flags);
+    printf("AX: 0x%x BX: 0x%x CX: 0x%x FLAGS 0x%x\n", cpu->reg.ax, cpu->reg.bx, cpu->reg.cx, flags_get(cpu));
 
     printf("%ld opcodes implemented so far\n", opcode_how_many_implemented());
 }
+
+int main(int argc, char **argv) {
+    uint64_t budget = ENTRY_BUDGET;
+    const char *debugger = NULL;
+    int wait = 0;
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (!strcmp(argv[arg], "-w")) {
+            wait = 1;
+            continue;
+        }
+        // An option missing its value falls through to the usage check below
+        if (arg + 1 == argc) break;
+        if (!strcmp(argv[arg], "-g")) {
+            debugger = argv[++arg];
+            continue;
+        }
+        char *end;
+        budget = strtoull(argv[arg + 1], &end, 0);
+        if (strcmp(argv[arg++], "-n") || *end || !budget) {
+            entry_usage(argv[0]);
+            return 2;
+        }
+    }
+    if ((arg < argc && argv[arg][0] == '-') || (wait && !debugger)) {
+        entry_usage(argv[0]);
+        return 2;
+    }
+
+    // Everything after the program name becomes its command tail
+    const char *program = arg < argc ? argv[arg++] : NULL;
+    char args[LOADER_COMMAND_TAIL + 1] = "";
+    for (size_t length = 0; arg < argc; arg++) {
+        int written = snprintf(args + length, sizeof(args) - length, "%s%s", length ? " " : "", argv[arg]);
+        if (written < 0 || (length += written) >= sizeof(args)) break;
+    }
+
+    if (!program) printf("Hello World!\n");
+
+    struct cpu cpu = {0};
+
+    // 640KB of goodness, the rest of the 1MB space stays unmapped until a device claims it
+    memory_create(&cpu);
+    memory_map_ram(&cpu, 0, 640 * 1024);
+
+    block_cache_create(&cpu);
+#ifdef CPU_JIT
+    jit_create(&cpu);
+#endif
+
+    // TRACE_MODE=off|text|binary, a binary trace is dumped to trace.bin when the CPU halts.
+    // Programs run untraced unless asked, the sample is traced as text.
+    const char *trace_mode = getenv("TRACE_MODE");
+    uint8_t trace_level = program ? TRACE_OFF : TRACE_TEXT;
+    if (trace_mode && !strcmp(trace_mode, "off")) trace_level = TRACE_OFF;
+    if (trace_mode && !strcmp(trace_mode, "text")) trace_level = TRACE_TEXT;
+    if (trace_mode && !strcmp(trace_mode, "binary")) trace_level = TRACE_BINARY;
+    trace_create(&cpu, trace_level, 4096, "trace.bin");
+
+#ifdef CPU_PROFILE
+    profile_create(&cpu);
+#endif
+
+    int status = 0;
+    if (program) status = entry_program(&cpu, program, args, budget, debugger, wait);
+    else entry_demo(&cpu);
+
+#ifdef CPU_PROFILE
+    profile_report(&cpu, stderr, 20);
+    profile_destroy(&cpu);
+#endif
+
+    return status;
+}
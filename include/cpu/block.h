@@ -0,0 +1,88 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+#include <cpu/opcodes.h>
+
+#define BLOCK_CACHE_SIZE 1024
+#define BLOCK_MAX_UOPS 32
+
+#define BLOCK_UOP_PLAIN 0
+#define BLOCK_UOP_SYNC 1
+#define BLOCK_UOP_END 2
+
+// One pre-decoded instruction
+struct block_uop {
+    opcode_fn function;
+    uint8_t kind;
+    uint8_t opcode;
+    uint8_t length;
+    uint8_t op[2];
+    // Clocks for this uop, for every uop up to and including it, and extra when a branch is taken
+    uint16_t cost;
+    uint16_t total;
+    uint8_t taken;
+};
+
+#ifdef CPU_JIT
+// rel32 jump at a translated block's exit that can be patched to chain straight into a successor
+struct block_chain {
+    uint8_t *site;
+    uint32_t target;
+    // Translation the jump goes into once linked, and the next jump linked into the same one
+    struct block *to;
+    struct block_chain *next;
+};
+#endif
+
+// Straight-line run of instructions ending at a branch
+struct block {
+    uint32_t addr;
+    uint32_t end;
+    uint8_t count;
+    uint8_t valid;
+    // Compares and branches back to itself, so it can only stop looping once an interrupt changes memory
+    uint8_t idle;
+    // Starts on a breakpoint, so the run loop has to look at it before every run
+    uint8_t breakpoint;
+    uint16_t cost;
+    struct block_uop uops[BLOCK_MAX_UOPS + 1];
+#ifdef CPU_JIT
+    uint32_t hits;
+    uint8_t *code;
+    uint8_t *code_body;
+    struct block_chain chain[2];
+    // Chain jumps of other translations linked into this one, unpatched when it is dropped
+    struct block_chain *incoming;
+#endif
+};
+
+struct block_cache {
+    struct block blocks[BLOCK_CACHE_SIZE];
+    // Number of cached blocks overlapping each 4KB page, used to catch self-modifying code
+    uint16_t code_pages[MEMORY_PAGES];
+    // One bit per byte a cached block was decoded from, so data sharing a page with code leaves it
+    // alone. Bits only go once nothing on their page is cached any more.
+    uint8_t code_bytes[MEMORY_SIZE / 8];
+    // Longest block decoded so far, no block starting further back than that can reach a write
+    uint32_t longest;
+};
+
+int block_cache_create(struct cpu *cpu);
+void block_cache_destroy(struct cpu *cpu);
+void block_cache_flush(struct cpu *cpu);
+void block_invalidate(struct cpu *cpu, uint32_t addr, uint32_t size);
+uint64_t block_run(struct cpu *cpu, uint64_t cycles);
+#ifdef CPU_THREADED
+uint64_t block_run_threaded(struct cpu *cpu, uint64_t cycles);
+#endif
+
+static inline void block_notify_write(struct cpu *cpu, uintptr_t addr, uint32_t size) {
+    struct block_cache *cache = cpu->blocks;
+    if (cache && cache->code_pages[(addr >> MEMORY_PAGE_SHIFT) % MEMORY_PAGES]) block_invalidate(cpu, addr, size);
+}
+
+#endif
\ No newline at end of file
@@ -4,21 +4,55 @@
 #include <stdint.h>
 #include <stddef.h>
 
-struct cpu_registers {
-    uint8_t ax[2];
-    uint8_t bx[2];
-    uint8_t cx[2];
-    uint8_t dx[2];
+// Register numbers as they appear in ModR/M and opcode encodings
+#define CPU_REG_AX 0
+#define CPU_REG_CX 1
+#define CPU_REG_DX 2
+#define CPU_REG_BX 3
+#define CPU_REG_SP 4
+#define CPU_REG_BP 5
+#define CPU_REG_SI 6
+#define CPU_REG_DI 7
+
+#define CPU_SREG_ES 0
+#define CPU_SREG_CS 1
+#define CPU_SREG_SS 2
+#define CPU_SREG_DS 3
 
-    uint16_t sp;
-    uint16_t bp;
-    uint16_t si;
-    uint16_t di;
+// AL..BH are encoded 0-7 as the low then high halves of AX..BX
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CPU_REG8(reg) (((reg) & 3) << 1 | !((reg) >> 2))
+#else
+#define CPU_REG8(reg) (((reg) & 3) << 1 | (reg) >> 2)
+#endif
 
-    uint16_t cs;
-    uint16_t ss;
-    uint16_t ds;
-    uint16_t es;
+// The general registers double as an array in encoding order, word operands index straight into
+// gpr while byte operands go through CPU_REG8 to find their half in gpr8
+struct cpu_registers {
+    union {
+        uint16_t gpr[8];
+        uint8_t gpr8[16];
+        struct {
+            uint16_t ax;
+            uint16_t cx;
+            uint16_t dx;
+            uint16_t bx;
+            uint16_t sp;
+            uint16_t bp;
+            uint16_t si;
+            uint16_t di;
+        };
+    };
+
+    union {
+        uint16_t sreg[4];
+        struct {
+            uint16_t es;
+            uint16_t cs;
+            uint16_t ss;
+            uint16_t ds;
+        };
+    };
 
     uint16_t ip;
     uint32_t ip32;
@@ -27,6 +61,23 @@ struct cpu_registers {
 };
 
 #define CPU_HALTED (1 << 0)
+// Something the run loop has to look at changed mid-block, such as INTR going up with IF set
+#define CPU_YIELD (1 << 1)
+// HLT with IF set, nothing runs until an interrupt is taken
+#define CPU_WAITING (1 << 2)
+// A breakpoint or watchpoint was hit, cpu_run returns and leaves this set until the next run
+#define CPU_BREAK (1 << 3)
+// STI, MOV SS or POP SS just ran, no interrupt is taken until the instruction after it has too
+#define CPU_SHADOW (1 << 4)
+#define CPU_STOP (CPU_HALTED | CPU_YIELD | CPU_WAITING | CPU_BREAK | CPU_SHADOW)
+
+// Skip over polling loops that only an interrupt can end, and give the host thread up while doing so
+#define CPU_IDLE_SKIP (1 << 0)
+#define CPU_IDLE_YIELD (1 << 1)
+
+// Accurate timing charges every instruction its 8086 clocks, fast-forward charges one per instruction
+#define CPU_TIMING_ACCURATE 0
+#define CPU_TIMING_FAST 1
 
 #define CPU_FLAGS_CARRY (1 << 0)
 #define CPU_FLAGS_PARITY (1 << 2)
@@ -39,15 +90,143 @@ struct cpu_registers {
 #define CPU_FLAGS_DIRECTION (1 << 10)
 #define CPU_FLAGS_DEBUG_BREAK (1 << 8)
 
-struct cpu {
+#define CPU_FLAGS_ARITH (CPU_FLAGS_CARRY | CPU_FLAGS_PARITY | CPU_FLAGS_ACARRY | CPU_FLAGS_ZERO | CPU_FLAGS_SIGN | CPU_FLAGS_OVERFLOW)
+
+// Last flag-producing operation, turned into real flags only when something reads them
+struct cpu_lazy_flags {
+    uint8_t op;
+    uint8_t width;
+    uint8_t carry;
+    uint16_t a;
+    uint16_t b;
+    uint32_t res;
+};
+
+#define MEMORY_SIZE 0x100000
+#define MEMORY_MASK (MEMORY_SIZE - 1)
+#define MEMORY_PAGE_SHIFT 12
+#define MEMORY_PAGE_SIZE (1 << MEMORY_PAGE_SHIFT)
+#define MEMORY_PAGES (MEMORY_SIZE >> MEMORY_PAGE_SHIFT)
+
+struct memory_mmio {
+    uint8_t (*read)(void *ctx, uint32_t addr);
+    void (*write)(void *ctx, uint32_t addr, uint8_t byte);
+    void *ctx;
+};
+
+// Told about every write into a RAM page after it landed, for devices that watch memory they don't own
+struct memory_notify {
+    void (*write)(void *ctx, uint32_t addr, uint32_t size);
+    void *ctx;
+};
+
+// 1MB physical address space in 4KB pages, NULL map entries send the access down the slow path.
+// The word maps are only set when the following page shares the same backing, so a word that
+// straddles two pages (or wraps at 1MB through the mirror) is still one map lookup and one host
+// access, with the 20-bit mask and the NULL check in front of it.
+struct memory {
+    uint8_t *backing;
+    size_t reserved;
+    uint8_t mirrored;
+    uint8_t *read_map[MEMORY_PAGES];
+    uint8_t *write_map[MEMORY_PAGES];
+    uint8_t *read_word_map[MEMORY_PAGES];
+    uint8_t *write_word_map[MEMORY_PAGES];
+    uint8_t type[MEMORY_PAGES];
+    uint8_t traps[MEMORY_PAGES];
+    // Set while an instruction's own bytes are read through the slow path, a read watchpoint skips those
+    uint8_t fetching;
+    struct memory_mmio mmio[MEMORY_PAGES];
+    struct memory_notify notify[MEMORY_PAGES];
+
+    // RAM pages written since the last snapshot or restore, in the order they were first hit
+    const struct snapshot *dirty_base;
+    uint16_t dirty_pages[MEMORY_PAGES];
+    size_t dirty_count;
+};
+
+struct snapshot {
+    struct cpu_registers reg;
+    struct cpu_lazy_flags lazy;
+    uint8_t state;
+    uint64_t cycles;
     uint8_t *memory;
-    size_t memory_size;
+};
+
+struct block_cache;
+struct jit;
+struct trace;
+struct profile;
+struct io;
+struct sched;
+struct debug;
+struct cpu;
+
+// Interrupt controller on the INTR line, acknowledge returns the vector of the request it accepts
+struct cpu_intc {
+    uint8_t (*acknowledge)(void *ctx);
+    void *ctx;
+};
+
+// Host code standing in for an interrupt vector. IP already points past INT when it runs, and a
+// return of 0 sends the interrupt on to the guest's vector after all.
+struct cpu_hle {
+    int (*handler)(struct cpu *cpu, uint8_t vector, void *ctx);
+    void *ctx;
+};
+
+struct cpu {
+    struct memory memory;
+
+    struct block_cache *blocks;
+    struct jit *jit;
+    struct trace *trace;
+    struct profile *profile;
+    struct io *io;
+    struct sched *sched;
+    struct debug *debug;
+    struct cpu_intc intc;
+    struct cpu_hle hle[256];
 
     struct cpu_registers reg;
+    struct cpu_lazy_flags lazy;
+
+    // Segment register a prefix put in place of the default one, sreg + 1, 0 when there is none.
+    // Only set while the prefixed instruction runs.
+    uint8_t segment_override;
 
     uint8_t state;
+    // Level of the INTR pin, only acted on between instructions and with IF set
+    uint8_t intr;
+
+    uint64_t cycles;
+    // Where the stretch cpu_run is executing ends, a long REP stops there so an interrupt can get in
+    uint64_t deadline;
+    uint8_t timing;
+
+    uint8_t idle;
+    // Cycles jumped over in HLT and in skipped polling loops rather than executed
+    uint64_t idle_cycles;
 };
 
-int cpu_run(struct cpu *cpu, size_t steps);
+int cpu_run(struct cpu *cpu, uint64_t cycles);
+void cpu_set_timing(struct cpu *cpu, uint8_t timing);
+void cpu_interrupt(struct cpu *cpu, uint8_t vector);
+void cpu_set_intr(struct cpu *cpu, uint8_t level);
+void cpu_idle(struct cpu *cpu, uint64_t until);
+
+// Base of the segment a data access goes through, sreg unless a prefix overrides it
+static inline uint16_t cpu_segment(const struct cpu *cpu, uint8_t sreg) {
+    return cpu->reg.sreg[cpu->segment_override ? cpu->segment_override - 1 : sreg];
+}
+
+static inline int cpu_hle(struct cpu *cpu, uint8_t vector) {
+    const struct cpu_hle *hle = &cpu->hle[vector];
+    return hle->handler && hle->handler(cpu, vector, hle->ctx);
+}
+
+int cpu_snapshot(struct cpu *cpu, struct snapshot *snapshot);
+void cpu_restore(struct cpu *cpu, const struct snapshot *snapshot);
+void cpu_snapshot_free(struct snapshot *snapshot);
 
 #endif
\ No newline at end of file
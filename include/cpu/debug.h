@@ -0,0 +1,76 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+#define DEBUG_MAX_BREAKPOINTS 64
+#define DEBUG_MAX_WATCHPOINTS 16
+
+#define DEBUG_WATCH_READ (1 << 0)
+#define DEBUG_WATCH_WRITE (1 << 1)
+
+// Why the last run stopped with CPU_BREAK
+#define DEBUG_STOP_NONE 0
+#define DEBUG_STOP_BREAKPOINT 1
+#define DEBUG_STOP_WATCHPOINT 2
+
+// No breakpoint to step over
+#define DEBUG_NO_RESUME UINT32_MAX
+
+// Either a physical address or, when segmented is set, one exact CS:IP
+struct debug_breakpoint {
+    uint32_t addr;
+    uint16_t cs;
+    uint16_t ip;
+    uint8_t segmented;
+};
+
+struct debug_watchpoint {
+    uint32_t addr;
+    uint32_t size;
+    uint8_t access;
+};
+
+/*
+    Breakpoints and watchpoints arm bits on the pages they sit in rather than being looked up
+    on every access, and the CPU keeps running blocks (and translations) while they are set.
+    Blocks end in front of a breakpoint, so every breakpoint starts a block and the run loops
+    check it there, and a block starting on one is never translated or chained into. Only
+    reads and writes to a page holding a watchpoint leave the memory fast path to get compared
+    against the list, instruction fetches among them are told apart by memory.fetching.
+ */
+struct debug {
+    struct debug_breakpoint breakpoints[DEBUG_MAX_BREAKPOINTS];
+    size_t breakpoint_count;
+    struct debug_watchpoint watchpoints[DEBUG_MAX_WATCHPOINTS];
+    size_t watchpoint_count;
+
+    // A run that starts here runs the instruction instead of stopping on its breakpoint again
+    uint32_t resume;
+
+    uint8_t reason;
+    // What the watchpoint that stopped the CPU was set to catch, not which access set it off
+    uint8_t access;
+    uint32_t addr;
+};
+
+int debug_create(struct cpu *cpu);
+void debug_destroy(struct cpu *cpu);
+int debug_add_breakpoint(struct cpu *cpu, uint32_t addr);
+int debug_add_breakpoint_at(struct cpu *cpu, uint16_t cs, uint16_t ip);
+int debug_remove_breakpoint(struct cpu *cpu, uint32_t addr);
+int debug_add_watchpoint(struct cpu *cpu, uint32_t addr, uint32_t size, uint8_t access);
+int debug_remove_watchpoint(struct cpu *cpu, uint32_t addr, uint32_t size, uint8_t access);
+int debug_has_breakpoint(struct cpu *cpu, uint32_t addr);
+int debug_check_breakpoint(struct cpu *cpu);
+void debug_watch_hit(struct cpu *cpu, uint32_t addr, uint8_t write);
+
+// Called by the run loops wherever a block starts, stops the CPU on a breakpoint at CS:IP
+static inline int debug_break(struct cpu *cpu) {
+    return cpu->debug && debug_check_breakpoint(cpu);
+}
+
+#endif
\ No newline at end of file
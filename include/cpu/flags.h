@@ -0,0 +1,33 @@
+#ifndef FLAGS_H
+#define FLAGS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+#define FLAGS_OP_NONE 0
+#define FLAGS_OP_ADD 1
+#define FLAGS_OP_SUB 2
+#define FLAGS_OP_INC 3
+#define FLAGS_OP_DEC 4
+#define FLAGS_OP_LOGIC 5
+
+// ADC/SBB record as ADD/SUB with the carry already folded into res
+static inline void flags_set_lazy(struct cpu *cpu, uint8_t op, uint8_t width, uint16_t a, uint16_t b, uint32_t res) {
+    cpu->lazy.op = op;
+    cpu->lazy.width = width;
+    cpu->lazy.a = a;
+    cpu->lazy.b = b;
+    cpu->lazy.res = res;
+}
+
+static inline void flags_set(struct cpu *cpu, uint16_t flags) {
+    cpu->reg.flags = flags;
+    cpu->lazy.op = FLAGS_OP_NONE;
+}
+
+uint16_t flags_get(struct cpu *cpu);
+uint8_t flags_get_carry(struct cpu *cpu);
+
+#endif
\ No newline at end of file
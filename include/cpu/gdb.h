@@ -0,0 +1,51 @@
+#ifndef GDB_H
+#define GDB_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+#define GDB_PACKET_SIZE 0x1000
+#define GDB_OUTPUT_SIZE (2 * GDB_PACKET_SIZE)
+// How long a client may leave a full output buffer undrained before it's disconnected, in ms
+#define GDB_SEND_TIMEOUT 5000
+
+// Registers in the order GDB's i386 target numbers them, each sent as 32 bits
+#define GDB_REGISTERS 16
+#define GDB_REG_EIP 8
+#define GDB_REG_EFLAGS 9
+
+/*
+    GDB remote serial protocol stub on a Unix socket or a loopback TCP port. Nothing runs on
+    its own: the host calls gdb_poll between cpu_run slices, which accepts a client, reads
+    whatever packets have arrived and reports stops, all without blocking. While no client is
+    connected a poll is one accept that fails with EAGAIN, and a CPU without a stub pays nothing.
+
+    EIP is presented as the linear address CS * 16 + IP so GDB's PC, memory, disassembly and
+    breakpoints all agree, writing it moves IP within the current CS.
+ */
+struct gdb {
+    struct cpu *cpu;
+    int listener;
+    int client;
+    char *path;
+
+    char input[GDB_PACKET_SIZE + 4];
+    size_t input_length;
+    char output[GDB_OUTPUT_SIZE];
+    size_t output_length;
+
+    uint8_t running;
+    uint8_t no_ack;
+    // The debug state was created for the client and goes away with it
+    uint8_t owns_debug;
+};
+
+struct gdb *gdb_create(struct cpu *cpu, const char *address);
+void gdb_destroy(struct gdb *gdb);
+int gdb_poll(struct gdb *gdb);
+void gdb_wait(struct gdb *gdb, int timeout);
+void gdb_exit(struct gdb *gdb, int status);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef IO_H
+#define IO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+#define IO_PORTS 0x10000
+#define IO_MAX_DEVICES 255
+#define IO_QUEUE_SIZE 64
+
+// Writes to the device may be queued and handed over in one flush call
+#define IO_DEFERRED (1 << 0)
+// A queued write is replaced by a later one to the same port and width, for latch style registers
+#define IO_COALESCE (1 << 1)
+
+struct io_write {
+    uint16_t port;
+    uint16_t value;
+    uint8_t width;
+};
+
+// Word callbacks are optional, without them a word access is two byte accesses to port and port + 1
+struct io_device {
+    uint8_t (*read)(void *ctx, uint16_t port);
+    void (*write)(void *ctx, uint16_t port, uint8_t byte);
+    uint16_t (*read_word)(void *ctx, uint16_t port);
+    void (*write_word)(void *ctx, uint16_t port, uint16_t word);
+    void (*flush)(void *ctx, const struct io_write *writes, size_t count);
+    void *ctx;
+    uint8_t flags;
+};
+
+// Each port holds a device slot, 0 means nothing answers and reads float high
+struct io {
+    uint8_t port_device[IO_PORTS];
+    struct io_device devices[IO_MAX_DEVICES + 1];
+    size_t device_count;
+
+    uint8_t queued_device;
+    struct io_write queue[IO_QUEUE_SIZE];
+    size_t queue_count;
+};
+
+int io_create(struct cpu *cpu);
+void io_destroy(struct cpu *cpu);
+int io_attach(struct cpu *cpu, uint16_t base, uint32_t count, const struct io_device *device);
+void io_detach(struct cpu *cpu, uint16_t base, uint32_t count);
+void io_flush(struct cpu *cpu);
+
+uint8_t io_read_byte_slow(struct cpu *cpu, uint8_t slot, uint16_t port);
+uint16_t io_read_word_slow(struct cpu *cpu, uint16_t port);
+void io_write_byte_slow(struct cpu *cpu, uint8_t slot, uint16_t port, uint8_t byte);
+void io_write_word_slow(struct cpu *cpu, uint16_t port, uint16_t word);
+
+static inline uint8_t io_read_byte(struct cpu *cpu, uint16_t port) {
+    if (!cpu->io) return 0xff;
+    uint8_t slot = cpu->io->port_device[port];
+    if (!slot) return 0xff;
+    return io_read_byte_slow(cpu, slot, port);
+}
+
+static inline uint16_t io_read_word(struct cpu *cpu, uint16_t port) {
+    if (!cpu->io) return 0xffff;
+    return io_read_word_slow(cpu, port);
+}
+
+static inline void io_write_byte(struct cpu *cpu, uint16_t port, uint8_t byte) {
+    if (!cpu->io) return;
+    uint8_t slot = cpu->io->port_device[port];
+    if (slot) io_write_byte_slow(cpu, slot, port, byte);
+}
+
+static inline void io_write_word(struct cpu *cpu, uint16_t port, uint16_t word) {
+    if (cpu->io) io_write_word_slow(cpu, port, word);
+}
+
+#endif
\ No newline at end of file
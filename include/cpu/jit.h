@@ -0,0 +1,38 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+#include <cpu/block.h>
+
+#define JIT_CODE_SIZE (4 * 1024 * 1024)
+#define JIT_HOT_THRESHOLD 64
+#define JIT_MAX_BLOCK_CODE 4096
+
+// State shared with translated code, reached through r12
+struct jit_exec {
+    int64_t budget;
+    // A translation went away while native code was running, it has to get back out
+    uint8_t dropped;
+};
+
+// The code cache is one memfd mapped twice: translations are written and patched through
+// write and run from code, so no page is ever writable and executable at the same time
+struct jit {
+    uint8_t *code;
+    uint8_t *write;
+    size_t used;
+    struct jit_exec exec;
+    // Times the run loop called into translated code, chained blocks don't come back out
+    uint64_t entries;
+};
+
+int jit_create(struct cpu *cpu);
+void jit_destroy(struct cpu *cpu);
+void jit_flush(struct cpu *cpu);
+void jit_drop(struct cpu *cpu, struct block *block);
+uint64_t jit_run_block(struct cpu *cpu, struct block *block, uint64_t cycles);
+
+#endif
\ No newline at end of file
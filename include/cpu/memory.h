@@ -3,10 +3,88 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
-uint8_t memory_read_byte(struct cpu *cpu, uintptr_t addr);
-uint16_t memory_read_word(struct cpu *cpu, uintptr_t addr);
-void memory_write_byte(struct cpu *cpu, uintptr_t addr, uint8_t byte);
-void memory_write_word(struct cpu *cpu, uintptr_t addr, uint16_t word);
+#include <cpu/cpu.h>
+
+#define MEMORY_UNMAPPED 0
+#define MEMORY_RAM 1
+#define MEMORY_ROM 2
+#define MEMORY_MMIO 3
+
+// Reasons a RAM page has its write fast path taken away
+#define MEMORY_TRAP_CODE (1 << 0)
+#define MEMORY_TRAP_DIRTY (1 << 1)
+#define MEMORY_TRAP_NOTIFY (1 << 2)
+#define MEMORY_TRAP_WATCH_WRITE (1 << 5)
+#define MEMORY_TRAPS_WRITE (MEMORY_TRAP_CODE | MEMORY_TRAP_DIRTY | MEMORY_TRAP_NOTIFY | MEMORY_TRAP_WATCH_WRITE)
+
+// Reads of a page with a read watchpoint leave the fast path too, a breakpoint only marks the page
+#define MEMORY_TRAP_BREAK (1 << 3)
+#define MEMORY_TRAP_WATCH_READ (1 << 4)
+
+int memory_create(struct cpu *cpu);
+void memory_destroy(struct cpu *cpu);
+void memory_map_ram(struct cpu *cpu, uint32_t base, uint32_t size);
+void memory_map_rom(struct cpu *cpu, uint32_t base, uint32_t size);
+void memory_map_mmio(struct cpu *cpu, uint32_t base, uint32_t size, const struct memory_mmio *mmio);
+void memory_load(struct cpu *cpu, uint32_t addr, const void *data, size_t size);
+void memory_set_trap(struct cpu *cpu, uint32_t page, uint8_t trap);
+void memory_clear_trap(struct cpu *cpu, uint32_t page, uint8_t trap);
+void memory_track_dirty(struct cpu *cpu, const struct snapshot *base);
+void memory_set_notify(struct cpu *cpu, uint32_t base, uint32_t size, const struct memory_notify *notify);
+void memory_notify_write(struct cpu *cpu, uint32_t addr, uint32_t size);
+uint8_t *memory_span(struct cpu *cpu, uint32_t addr, uint32_t size, int write);
+
+uint8_t memory_read_byte_slow(struct cpu *cpu, uint32_t addr);
+uint16_t memory_read_word_slow(struct cpu *cpu, uint32_t addr);
+void memory_write_byte_slow(struct cpu *cpu, uint32_t addr, uint8_t byte);
+void memory_write_word_slow(struct cpu *cpu, uint32_t addr, uint16_t word);
+
+static inline uint8_t memory_read_byte(struct cpu *cpu, uintptr_t addr) {
+    addr &= MEMORY_MASK;
+    uint8_t *page = cpu->memory.read_map[addr >> MEMORY_PAGE_SHIFT];
+    if (page) return page[addr & (MEMORY_PAGE_SIZE - 1)];
+    return memory_read_byte_slow(cpu, addr);
+}
+
+// Reads a byte of an instruction, opcode, ModR/M, displacement or immediate, rather than data
+static inline uint8_t memory_fetch_byte(struct cpu *cpu, uintptr_t addr) {
+    addr &= MEMORY_MASK;
+    uint8_t *page = cpu->memory.read_map[addr >> MEMORY_PAGE_SHIFT];
+    if (page) return page[addr & (MEMORY_PAGE_SIZE - 1)];
+
+    cpu->memory.fetching = 1;
+    uint8_t byte = memory_read_byte_slow(cpu, addr);
+    cpu->memory.fetching = 0;
+    return byte;
+}
+
+static inline uint16_t memory_read_word(struct cpu *cpu, uintptr_t addr) {
+    addr &= MEMORY_MASK;
+    uint8_t *page = cpu->memory.read_word_map[addr >> MEMORY_PAGE_SHIFT];
+    if (page) {
+        uint16_t word;
+        memcpy(&word, page + (addr & (MEMORY_PAGE_SIZE - 1)), sizeof(word));
+        return word;
+    }
+    return memory_read_word_slow(cpu, addr);
+}
+
+static inline void memory_write_byte(struct cpu *cpu, uintptr_t addr, uint8_t byte) {
+    addr &= MEMORY_MASK;
+    uint8_t *page = cpu->memory.write_map[addr >> MEMORY_PAGE_SHIFT];
+    if (page) page[addr & (MEMORY_PAGE_SIZE - 1)] = byte;
+    else memory_write_byte_slow(cpu, addr, byte);
+}
+
+static inline void memory_write_word(struct cpu *cpu, uintptr_t addr, uint16_t word) {
+    addr &= MEMORY_MASK;
+    uint8_t *page = cpu->memory.write_word_map[addr >> MEMORY_PAGE_SHIFT];
+    if (page)
+        memcpy(page + (addr & (MEMORY_PAGE_SIZE - 1)), &word, sizeof(word));
+    else
+        memory_write_word_slow(cpu, addr, word);
+}
 
 #endif
\ No newline at end of file
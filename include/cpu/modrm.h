@@ -0,0 +1,72 @@
+#ifndef MODRM_H
+#define MODRM_H
+
+#include <stdint.h>
+
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+
+#define MODRM_NONE 0xff
+
+// Everything the mod and r/m fields of a ModR/M byte say about an operand, looked up once per byte
+struct modrm_desc {
+    uint8_t memory;
+    uint8_t base;
+    uint8_t index;
+    uint8_t disp;
+    uint8_t segment;
+    uint8_t cycles;
+};
+
+// r/m resolved to either a register number or a physical address, good for a read and a write
+struct modrm_operand {
+    uint8_t memory;
+    uint8_t reg;
+    uint32_t addr;
+};
+
+extern const struct modrm_desc modrm_table[256];
+
+// Offset part of a memory operand. The displacement sits right after the ModR/M byte, ip still points at the opcode
+static inline uint16_t modrm_offset(struct cpu *cpu, uint8_t modrm) {
+    const struct modrm_desc *desc = &modrm_table[modrm];
+    uint16_t offset = 0;
+    if (desc->base != MODRM_NONE) offset += cpu->reg.gpr[desc->base];
+    if (desc->index != MODRM_NONE) offset += cpu->reg.gpr[desc->index];
+
+    uint32_t at = cpu->reg.cs * 16 + (uint16_t) (cpu->reg.ip + 2);
+    if (desc->disp == 1) offset += (int8_t) memory_fetch_byte(cpu, at);
+    else if (desc->disp == 2) offset += memory_fetch_byte(cpu, at) | (memory_fetch_byte(cpu, at + 1) << 8);
+    return offset;
+}
+
+static inline struct modrm_operand modrm_decode(struct cpu *cpu, uint8_t modrm) {
+    const struct modrm_desc *desc = &modrm_table[modrm];
+    struct modrm_operand operand = {desc->memory, modrm & 7, 0};
+    if (!desc->memory) return operand;
+
+    operand.addr = (cpu_segment(cpu, desc->segment) * 16 + modrm_offset(cpu, modrm)) & MEMORY_MASK;
+    return operand;
+}
+
+static inline uint8_t modrm_read8(struct cpu *cpu, const struct modrm_operand *operand) {
+    if (operand->memory) return memory_read_byte(cpu, operand->addr);
+    return cpu->reg.gpr8[CPU_REG8(operand->reg)];
+}
+
+static inline uint16_t modrm_read16(struct cpu *cpu, const struct modrm_operand *operand) {
+    if (operand->memory) return memory_read_word(cpu, operand->addr);
+    return cpu->reg.gpr[operand->reg];
+}
+
+static inline void modrm_write8(struct cpu *cpu, const struct modrm_operand *operand, uint8_t val) {
+    if (operand->memory) memory_write_byte(cpu, operand->addr, val);
+    else cpu->reg.gpr8[CPU_REG8(operand->reg)] = val;
+}
+
+static inline void modrm_write16(struct cpu *cpu, const struct modrm_operand *operand, uint16_t val) {
+    if (operand->memory) memory_write_word(cpu, operand->addr, val);
+    else cpu->reg.gpr[operand->reg] = val;
+}
+
+#endif
\ No newline at end of file
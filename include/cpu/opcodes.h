@@ -5,17 +5,88 @@
 #include <stddef.h>
 
 #include <cpu/cpu.h>
+#include <cpu/modrm.h>
+
+// Every handler takes the same two operand bytes so dispatch never has to switch on arity
+typedef void (*opcode_fn)(struct cpu *cpu, uint8_t op0, uint8_t op1);
 
 struct opcode {
     char name[32];
     size_t operand_length;
-    void *function;
+    opcode_fn function;
+    uint8_t flags;
+    // 8086 clocks for the register form, and for the memory form before the effective address cost
+    uint8_t cycles;
+    uint8_t cycles_mem;
+    // What a code generator may emit in place of calling function, OPCODE_NATIVE_NONE for nothing
+    uint8_t native;
 };
 
-#define opcode_reg8_to_reg16(a) (a[1] << 8 | a[0] & 0xff)
-#define opcode_set_reg16_val(a, b) a[1] = (uint16_t) b >> 8; a[0] = (uint16_t) b & 0xff;
+#define OPCODE_MODRM (1 << 0)
+// Ends a block: moves IP, or may let a pending interrupt in (STI, POPF, OUT to the PIC)
+#define OPCODE_BRANCH (1 << 1)
+// Looks at IP: reads operand bytes past op0 and op1, or can raise a fault that pushes it
+#define OPCODE_IP (1 << 2)
+
+/*
+    Native classes. The operand width is bit 0 of a ModR/M opcode and bit 1 says the register is
+    the destination, as the 8086 encodes them. Immediate forms get the width from operand_length.
+ */
+#define OPCODE_NATIVE_NONE 0
+// ALU operation in opcode bits 3-5 between r/m and a register, or AL/AX and an immediate
+#define OPCODE_NATIVE_ALU 1
+#define OPCODE_NATIVE_ALU_ACC 2
+// Group 1, the operation is in the ModR/M reg field and the immediate follows it
+#define OPCODE_NATIVE_ALU_IMM 3
+#define OPCODE_NATIVE_MOV 4
+// Register in the low three opcode bits
+#define OPCODE_NATIVE_MOV_IMM 5
+#define OPCODE_NATIVE_INCDEC 6
+// Condition in the low four opcode bits, numbered the same way as the host's
+#define OPCODE_NATIVE_JCC 7
+
+// How many prefixes in a row are looked through when sizing an instruction, so a run of them ends somewhere
+#define OPCODE_MAX_PREFIXES 15
+
+extern const struct opcode opcodes[256];
+
+// Bytes on top of operand_length: the ModR/M displacement, and the immediate of a group 3 TEST
+static inline size_t opcode_extra_length(uint8_t opcode_byte, uint8_t modrm) {
+    if (!(opcodes[opcode_byte].flags & OPCODE_MODRM)) return 0;
+    size_t length = modrm_table[modrm].disp;
+    if ((opcode_byte & 0xfe) == 0xf6 && ((modrm >> 3) & 7) < 2) length += (opcode_byte & 1) + 1;
+    return length;
+}
+
+static inline uint32_t opcode_cycles(uint8_t opcode_byte, uint8_t modrm) {
+    const struct opcode *opcode = &opcodes[opcode_byte];
+    if (!(opcode->flags & OPCODE_MODRM) || (modrm >> 6) == 0b11) return opcode->cycles;
+    return opcode->cycles_mem + modrm_table[modrm].cycles;
+}
+
+// ES:, CS:, SS: and DS:
+static inline int opcode_is_segment_prefix(uint8_t opcode_byte) {
+    return (opcode_byte & 0xe7) == 0x26;
+}
+
+// MOVS, CMPS, STOS, LODS and SCAS, the instructions REP repeats
+static inline int opcode_is_string(uint8_t opcode_byte) {
+    return opcode_byte >= 0xa4 && opcode_byte <= 0xaf && (opcode_byte & 0xfe) != 0xa8;
+}
+
+// What a conditional branch costs on top of opcode_cycles when it is taken
+static inline uint32_t opcode_taken_cycles(uint8_t opcode_byte) {
+    if (opcode_byte >= 0x70 && opcode_byte <= 0x7f) return 12;
+    if (opcode_byte >= 0xe0 && opcode_byte <= 0xe3) return opcode_byte == 0xe0 ? 14 : 12;
+    if (opcode_byte == 0xce) return 49;
+    return 0;
+}
+
 
 void opcode_execute(struct cpu *cpu);
+void opcode_call(struct cpu *cpu, uint8_t opcode_byte, uint8_t op0, uint8_t op1);
+size_t opcode_length(struct cpu *cpu, uintptr_t addr);
+uint8_t opcode_flags(struct cpu *cpu, uintptr_t addr);
 
 size_t opcode_how_many_implemented(void);
 
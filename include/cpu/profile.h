@@ -0,0 +1,51 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <cpu/cpu.h>
+#include <cpu/opcodes.h>
+
+// Open addressed CS:IP table, blocks that don't fit within PROFILE_PROBES slots are only counted as dropped
+#define PROFILE_BLOCKS 4096
+#define PROFILE_PROBES 8
+
+struct profile_block {
+    uint16_t cs;
+    uint16_t ip;
+    uint32_t hits;
+};
+
+struct profile {
+    uint64_t opcodes[256];
+    // mod * 8 + rm, mod 3 being the register forms
+    uint64_t modrm[32];
+    struct profile_block blocks[PROFILE_BLOCKS];
+    uint64_t dropped;
+};
+
+int profile_create(struct cpu *cpu);
+void profile_destroy(struct cpu *cpu);
+void profile_reset(struct cpu *cpu);
+void profile_block_hit(struct cpu *cpu, uint16_t cs, uint16_t ip);
+void profile_report(struct cpu *cpu, FILE *out, size_t top);
+
+#ifdef CPU_PROFILE
+static inline void profile_instruction(struct cpu *cpu, uint8_t opcode_byte, uint8_t op0) {
+    struct profile *profile = cpu->profile;
+    if (!profile) return;
+    profile->opcodes[opcode_byte]++;
+    if (opcodes[opcode_byte].flags & OPCODE_MODRM) profile->modrm[(op0 >> 6) * 8 + (op0 & 7)]++;
+}
+
+static inline void profile_block(struct cpu *cpu) {
+    if (cpu->profile) profile_block_hit(cpu, cpu->reg.cs, cpu->reg.ip);
+}
+#else
+#define profile_instruction(cpu, opcode_byte, op0) ((void) 0)
+#define profile_block(cpu) ((void) 0)
+#endif
+
+#endif
\ No newline at end of file
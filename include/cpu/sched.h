@@ -0,0 +1,40 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+#define SCHED_MAX_EVENTS 64
+#define SCHED_NEVER UINT64_MAX
+
+typedef void (*sched_fn)(struct cpu *cpu, void *ctx);
+
+// Owned by the device that schedules it, slot is its heap position plus one and 0 while idle
+struct sched_event {
+    uint64_t deadline;
+    sched_fn fire;
+    void *ctx;
+    size_t slot;
+};
+
+// Binary min-heap on the cycle counter, the run loop only ever looks at the root
+struct sched {
+    struct sched_event *heap[SCHED_MAX_EVENTS];
+    size_t count;
+};
+
+int sched_create(struct cpu *cpu);
+void sched_destroy(struct cpu *cpu);
+void sched_event_init(struct sched_event *event, sched_fn fire, void *ctx);
+int sched_at(struct cpu *cpu, struct sched_event *event, uint64_t deadline);
+void sched_cancel(struct cpu *cpu, struct sched_event *event);
+void sched_dispatch(struct cpu *cpu);
+
+static inline uint64_t sched_next(struct cpu *cpu) {
+    struct sched *sched = cpu->sched;
+    return sched && sched->count ? sched->heap[0]->deadline : SCHED_NEVER;
+}
+
+#endif
\ No newline at end of file
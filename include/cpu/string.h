@@ -0,0 +1,15 @@
+#ifndef STRING_H
+#define STRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+    Search kernels behind REP CMPS/SCAS. Both walk count elements of width bytes forward and
+    return the index of the first one whose comparison came out equal (until_equal, REPNE)
+    or not equal (REPE), or count if there is none.
+ */
+size_t string_compare(const uint8_t *a, const uint8_t *b, size_t count, uint8_t width, int until_equal);
+size_t string_scan(const uint8_t *a, uint16_t value, size_t count, uint8_t width, int until_equal);
+
+#endif
\ No newline at end of file
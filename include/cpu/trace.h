@@ -0,0 +1,82 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <cpu/cpu.h>
+
+#define TRACE_OFF 0
+#define TRACE_TEXT 1
+#define TRACE_BINARY 2
+
+// Highest level compiled in, the runtime level in struct trace can only go lower
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL TRACE_TEXT
+#endif
+
+#define TRACE_MAGIC "8086TRC"
+#define TRACE_VERSION 1
+
+struct trace_record {
+    uint16_t cs;
+    uint16_t ip;
+    uint8_t opcode;
+    uint8_t reserved;
+    uint16_t flags;
+    uint16_t ax;
+    uint16_t bx;
+    uint16_t cx;
+    uint16_t dx;
+    uint16_t sp;
+    uint16_t bp;
+    uint16_t si;
+    uint16_t di;
+    uint16_t ds;
+    uint16_t es;
+    uint16_t ss;
+};
+
+struct trace_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+};
+
+struct trace {
+    uint8_t level;
+    const char *path;
+    struct trace_record *ring;
+    size_t size;
+    size_t head;
+    size_t count;
+};
+
+int trace_create(struct cpu *cpu, uint8_t level, size_t records, const char *path);
+void trace_destroy(struct cpu *cpu);
+void trace_record(struct cpu *cpu, uint16_t ip, uint8_t opcode_byte);
+void trace_text(struct cpu *cpu, uint16_t ip, uint8_t opcode_byte);
+int trace_dump(struct cpu *cpu, FILE *out);
+void trace_halt(struct cpu *cpu);
+
+#if TRACE_LEVEL == TRACE_OFF
+#define trace_instruction(cpu, ip, opcode_byte) ((void) 0)
+#define trace_print(cpu, ...) ((void) 0)
+#else
+static inline void trace_instruction(struct cpu *cpu, uint16_t ip, uint8_t opcode_byte) {
+    if (!cpu->trace) return;
+#if TRACE_LEVEL >= TRACE_BINARY
+    if (cpu->trace->level == TRACE_BINARY) {
+        trace_record(cpu, ip, opcode_byte);
+        return;
+    }
+#endif
+    if (cpu->trace->level == TRACE_TEXT) trace_text(cpu, ip, opcode_byte);
+}
+
+#define trace_print(cpu, ...) do { if ((cpu)->trace && (cpu)->trace->level == TRACE_TEXT) printf(__VA_ARGS__); } while (0)
+#endif
+
+#endif
\ No newline at end of file
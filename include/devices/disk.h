@@ -0,0 +1,40 @@
+#ifndef DISK_H
+#define DISK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cpu/cpu.h>
+#include <devices/hle.h>
+
+#define DISK_SECTOR_SIZE 512
+
+// What happens to sector writes: refused, kept in a private copy-on-write mapping, or put back in the file
+#define DISK_READONLY 0
+#define DISK_OVERLAY 1
+#define DISK_WRITEBACK 2
+
+/*
+    A raw image mapped whole into the host address space. Sectors move between the mapping
+    and guest RAM with one memcpy per transfer, the kernel pages the image in on demand and,
+    for a write-back image, out again whenever it likes or on disk_sync.
+ */
+struct disk {
+    uint8_t *data;
+    size_t size;
+    uint8_t mode;
+
+    uint16_t cylinders;
+    uint8_t heads;
+    uint8_t sectors;
+    uint32_t total;
+};
+
+struct disk *disk_open(const char *path, uint8_t mode);
+void disk_close(struct disk *disk);
+int disk_set_geometry(struct disk *disk, uint16_t cylinders, uint8_t heads, uint8_t sectors);
+int disk_sync(struct disk *disk);
+int disk_transfer(void *ctx, struct cpu *cpu, uint32_t lba, uint32_t count, uint32_t addr, int write);
+void disk_hle(struct disk *disk, struct hle_disk *hle);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef HLE_H
+#define HLE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <cpu/cpu.h>
+#include <cpu/flags.h>
+#include <devices/video.h>
+
+#define HLE_KEYS 16
+#define HLE_FILES 20
+#define HLE_DISKS 4
+
+// DOS handle backed by the console rather than a host descriptor
+#define HLE_FILE_CONSOLE -2
+
+// Vectors the BIOS and DOS emulation answer, each can be handed back to guest code on its own
+#define HLE_VECTOR_TIMER 0x08
+#define HLE_VECTOR_VIDEO 0x10
+#define HLE_VECTOR_DISK 0x13
+#define HLE_VECTOR_KEYBOARD 0x16
+#define HLE_VECTOR_TIME 0x1a
+#define HLE_VECTOR_TERMINATE 0x20
+#define HLE_VECTOR_DOS 0x21
+
+// Where the default vectors point, an IRET in the BIOS ROM segment
+#define HLE_ROM_SEGMENT 0xf000
+#define HLE_ROM_IRET 0xff53
+// Vectors handled natively point at their own 4-byte stub here, INT n followed by an IRET
+#define HLE_ROM_STUBS 0xf800
+
+// BIOS data area fields
+#define HLE_BDA_EQUIPMENT 0x410
+#define HLE_BDA_MEMORY 0x413
+#define HLE_BDA_VIDEO_MODE 0x449
+#define HLE_BDA_COLUMNS 0x44a
+#define HLE_BDA_CURSOR 0x450
+#define HLE_BDA_CRTC_PORT 0x463
+#define HLE_BDA_TICKS 0x46c
+#define HLE_BDA_MIDNIGHT 0x470
+
+// Timer ticks in a day at 18.2Hz
+#define HLE_TICKS_PER_DAY 0x1800b0
+
+// INT 13h status codes
+#define HLE_DISK_OK 0x00
+#define HLE_DISK_BAD_COMMAND 0x01
+#define HLE_DISK_WRITE_PROTECTED 0x03
+#define HLE_DISK_NOT_FOUND 0x04
+#define HLE_DISK_TIMEOUT 0x80
+
+// Moves count sectors from lba to or from guest memory at addr, 0 on success or a BIOS status code
+struct hle_disk {
+    int (*transfer)(void *ctx, struct cpu *cpu, uint32_t lba, uint32_t count, uint32_t addr, int write);
+    void *ctx;
+    uint16_t cylinders;
+    uint8_t heads;
+    uint8_t sectors;
+    uint32_t total;
+};
+
+struct hle {
+    struct cpu *cpu;
+    struct video *video;
+    uint32_t video_base;
+
+    // DOS console, both optional and unset until the host hands over streams
+    FILE *console_in;
+    FILE *console_out;
+
+    uint16_t keys[HLE_KEYS];
+    uint8_t key_head;
+    uint8_t key_count;
+    // INT 16h is parked in CPU_WAITING until a key comes in
+    uint8_t key_wait;
+
+    struct hle_disk disks[HLE_DISKS];
+    uint8_t disk_status;
+
+    // Host descriptors behind DOS handles, -1 when free, 0-4 are the standard devices
+    int files[HLE_FILES];
+    int root;
+    uint16_t dta_segment;
+    uint16_t dta_offset;
+
+    // Paragraphs handed out by the DOS allocator, memory_top is the first one past conventional memory
+    uint16_t memory_next;
+    uint16_t memory_last;
+    uint16_t memory_top;
+
+    uint8_t exited;
+    uint8_t exit_code;
+};
+
+struct hle *hle_create(struct cpu *cpu, const char *root);
+void hle_destroy(struct hle *hle);
+void hle_enable(struct hle *hle, uint8_t vector, int enable);
+void hle_attach_video(struct hle *hle, struct video *video);
+int hle_attach_disk(struct hle *hle, uint8_t drive, const struct hle_disk *disk);
+void hle_push_key(struct hle *hle, uint16_t key);
+
+int hle_bios(struct cpu *cpu, uint8_t vector, void *ctx);
+int hle_dos(struct cpu *cpu, uint8_t vector, void *ctx);
+void hle_teletype(struct hle *hle, uint8_t ch);
+int hle_pop_key(struct hle *hle, uint16_t *key, int remove);
+
+// AL..BH in encoding order, the way the BIOS and DOS calling conventions name them
+#define HLE_AL 0
+#define HLE_CL 1
+#define HLE_DL 2
+#define HLE_BL 3
+#define HLE_AH 4
+#define HLE_CH 5
+#define HLE_DH 6
+#define HLE_BH 7
+
+static inline uint8_t hle_reg8(struct cpu *cpu, uint8_t reg) {
+    return cpu->reg.gpr8[CPU_REG8(reg)];
+}
+
+static inline void hle_set_reg8(struct cpu *cpu, uint8_t reg, uint8_t val) {
+    cpu->reg.gpr8[CPU_REG8(reg)] = val;
+}
+
+static inline void hle_set_flag(struct cpu *cpu, uint16_t flag, int set) {
+    uint16_t flags = flags_get(cpu);
+    flags_set(cpu, set ? flags | flag : flags & ~flag);
+}
+
+// Carry is how both the BIOS and DOS report failure, with the error code in AH or AX
+static inline void hle_carry(struct cpu *cpu, int set) {
+    hle_set_flag(cpu, CPU_FLAGS_CARRY, set);
+}
+
+static inline uint32_t hle_linear(uint16_t segment, uint16_t offset) {
+    return ((uint32_t) segment * 16 + offset) & MEMORY_MASK;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef PIC_H
+#define PIC_H
+
+#include <stdint.h>
+
+#include <cpu/cpu.h>
+
+#define PIC_PORT_COMMAND 0x20
+#define PIC_PORT_DATA 0x21
+
+// Single 8259A in 8086 mode, edge triggered with fixed priority, IRQ 0 highest
+struct pic {
+    struct cpu *cpu;
+    uint8_t irr;
+    uint8_t isr;
+    uint8_t imr;
+    uint8_t vector_base;
+
+    // Initialization words still expected after ICW1, and what ICW1 said about them
+    uint8_t init_step;
+    uint8_t need_icw3;
+    uint8_t need_icw4;
+    uint8_t auto_eoi;
+    uint8_t read_isr;
+};
+
+struct pic *pic_create(struct cpu *cpu);
+void pic_destroy(struct pic *pic);
+void pic_raise(struct pic *pic, uint8_t irq);
+void pic_lower(struct pic *pic, uint8_t irq);
+
+#endif
\ No newline at end of file
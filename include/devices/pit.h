@@ -0,0 +1,50 @@
+#ifndef PIT_H
+#define PIT_H
+
+#include <stdint.h>
+
+#include <cpu/cpu.h>
+#include <cpu/sched.h>
+#include <devices/pic.h>
+
+#define PIT_PORT_BASE 0x40
+#define PIT_PORT_CONTROL 0x43
+
+// The 1.193182MHz input clock is the 4.77MHz CPU clock divided by 4
+#define PIT_CYCLES_PER_TICK 4
+
+#define PIT_ACCESS_LATCH 0
+#define PIT_ACCESS_LOW 1
+#define PIT_ACCESS_HIGH 2
+#define PIT_ACCESS_BOTH 3
+
+/*
+    Counters are never stepped. A channel remembers the cycle its count was loaded and works
+    out the current value from cpu->cycles when it is read, and channel 0 puts one scheduler
+    event on the terminal count instead.
+ */
+struct pit_channel {
+    uint16_t reload;
+    uint8_t mode;
+    uint8_t access;
+    uint8_t counting;
+    uint64_t start;
+
+    uint8_t write_high;
+    uint8_t read_high;
+    uint8_t latched;
+    uint16_t latch;
+};
+
+struct pit {
+    struct cpu *cpu;
+    struct pic *pic;
+    struct pit_channel channels[3];
+    struct sched_event event;
+};
+
+struct pit *pit_create(struct cpu *cpu, struct pic *pic);
+void pit_destroy(struct pit *pit);
+uint16_t pit_count(struct pit *pit, uint8_t channel);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef VIDEO_H
+#define VIDEO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <cpu/cpu.h>
+#include <cpu/sched.h>
+
+#define VIDEO_CGA 0
+#define VIDEO_MDA 1
+
+#define VIDEO_COLUMNS 80
+#define VIDEO_ROWS 25
+#define VIDEO_ROW_BYTES (VIDEO_COLUMNS * 2)
+
+// cells holds character and attribute byte pairs straight out of guest memory
+struct video_sink {
+    void (*row)(void *ctx, uint8_t row, const uint8_t *cells, uint8_t columns);
+    // Optional, called once after a render that handed over at least one row
+    void (*flush)(void *ctx);
+    void *ctx;
+};
+
+// Text mode adapter, rows the guest wrote to since the last render are set in dirty
+struct video {
+    struct cpu *cpu;
+    uint8_t type;
+    uint32_t base;
+    uint32_t size;
+    uint16_t port;
+
+    uint8_t crtc_index;
+    uint8_t crtc[18];
+    // Character offset of the top left cell, CRTC registers 12 and 13
+    uint16_t start;
+
+    uint32_t dirty;
+    struct video_sink sink;
+    struct sched_event frame;
+};
+
+struct video *video_create(struct cpu *cpu, uint8_t type, const struct video_sink *sink);
+void video_destroy(struct video *video);
+void video_render(struct video *video);
+uint16_t video_cursor(struct video *video);
+
+void video_sink_terminal(struct video_sink *sink, FILE *out);
+int video_sink_text(struct video_sink *sink, const char *path);
+void video_sink_text_free(struct video_sink *sink);
+
+#endif
\ No newline at end of file
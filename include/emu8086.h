@@ -0,0 +1,84 @@
+#ifndef EMU8086_H
+#define EMU8086_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Public interface of libemu8086. Everything an embedding host needs goes through an opaque
+    struct emu8086, one per guest machine, so any number of them can run side by side in one
+    process. The library keeps no global state and never writes to stdout or stderr.
+ */
+
+#define EMU8086_API_VERSION 1
+
+#if defined(__GNUC__)
+#define EMU8086_API __attribute__((visibility("default")))
+#else
+#define EMU8086_API
+#endif
+
+// Options for emu8086_create
+#define EMU8086_BLOCK_CACHE (1 << 0)
+#define EMU8086_JIT (1 << 1)
+// One cycle per instruction, so budgets count instructions
+#define EMU8086_TIMING_FAST (1 << 2)
+
+// Why emu8086_run or emu8086_step returned
+#define EMU8086_BUDGET 0
+#define EMU8086_HALTED 1
+#define EMU8086_WAITING 2
+
+// General registers in encoding order, then the segment registers in theirs
+#define EMU8086_REG_AX 0
+#define EMU8086_REG_CX 1
+#define EMU8086_REG_DX 2
+#define EMU8086_REG_BX 3
+#define EMU8086_REG_SP 4
+#define EMU8086_REG_BP 5
+#define EMU8086_REG_SI 6
+#define EMU8086_REG_DI 7
+#define EMU8086_REG_ES 8
+#define EMU8086_REG_CS 9
+#define EMU8086_REG_SS 10
+#define EMU8086_REG_DS 11
+#define EMU8086_REG_IP 12
+#define EMU8086_REG_FLAGS 13
+
+struct emu8086;
+
+// A device behind a range of I/O ports, word accesses are split into two byte accesses
+struct emu8086_port {
+    uint8_t (*read)(void *ctx, uint16_t port);
+    void (*write)(void *ctx, uint16_t port, uint8_t byte);
+    void *ctx;
+};
+
+// A device behind a range of physical memory, addr is the full 20 bit address
+struct emu8086_mmio {
+    uint8_t (*read)(void *ctx, uint32_t addr);
+    void (*write)(void *ctx, uint32_t addr, uint8_t byte);
+    void *ctx;
+};
+
+EMU8086_API struct emu8086 *emu8086_create(uint32_t ram_size, uint32_t options);
+EMU8086_API void emu8086_destroy(struct emu8086 *emu);
+
+EMU8086_API int emu8086_load(struct emu8086 *emu, uint32_t addr, const void *data, size_t size);
+EMU8086_API int emu8086_read(struct emu8086 *emu, uint32_t addr, void *data, size_t size);
+EMU8086_API int emu8086_map_rom(struct emu8086 *emu, uint32_t base, uint32_t size);
+
+EMU8086_API int emu8086_step(struct emu8086 *emu);
+EMU8086_API int emu8086_run(struct emu8086 *emu, uint64_t budget);
+EMU8086_API int emu8086_interrupt(struct emu8086 *emu, uint8_t vector);
+EMU8086_API void emu8086_reset(struct emu8086 *emu);
+EMU8086_API uint64_t emu8086_cycles(const struct emu8086 *emu);
+
+EMU8086_API uint16_t emu8086_get_reg(const struct emu8086 *emu, int reg);
+EMU8086_API void emu8086_set_reg(struct emu8086 *emu, int reg, uint16_t value);
+
+EMU8086_API int emu8086_attach_ports(struct emu8086 *emu, uint16_t base, uint32_t count, const struct emu8086_port *port);
+EMU8086_API void emu8086_detach_ports(struct emu8086 *emu, uint16_t base, uint32_t count);
+EMU8086_API int emu8086_attach_mmio(struct emu8086 *emu, uint32_t base, uint32_t size, const struct emu8086_mmio *mmio);
+
+#endif
\ No newline at end of file
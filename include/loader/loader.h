@@ -0,0 +1,32 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdint.h>
+
+#include <cpu/cpu.h>
+
+// Images bigger than this are mapped rather than read, smaller ones aren't worth the mmap
+#define LOADER_MMAP_THRESHOLD (64 * 1024)
+
+// The environment block sits right below the PSP
+#define LOADER_ENVIRONMENT_PARAGRAPHS 0x10
+
+#define LOADER_COMMAND_TAIL 126
+
+// Where a loaded program landed and where it wants to start, all in segments and offsets
+struct loader_image {
+    uint16_t environment;
+    uint16_t psp;
+    uint16_t cs;
+    uint16_t ip;
+    uint16_t ss;
+    uint16_t sp;
+
+    // First paragraph past the memory the program was given
+    uint16_t end;
+};
+
+int loader_load(struct cpu *cpu, const char *path, const char *args, uint16_t segment, uint16_t top, struct loader_image *image);
+void loader_start(struct cpu *cpu, const struct loader_image *image);
+
+#endif
\ No newline at end of file
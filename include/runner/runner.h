@@ -0,0 +1,32 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpu/cpu.h>
+
+// Conventional memory every job gets, the image is loaded at cs:ip
+#define RUNNER_RAM_SIZE (640 * 1024)
+
+struct runner_job {
+    const uint8_t *image;
+    size_t image_size;
+    uint16_t cs;
+    uint16_t ip;
+    uint16_t ss;
+    uint16_t sp;
+    size_t steps;
+};
+
+struct runner_result {
+    uint8_t halted;
+    uint16_t flags;
+    struct cpu_registers reg;
+};
+
+int runner_run(const struct runner_job *jobs, struct runner_result *results, size_t count, size_t threads);
+int runner_run_debug(const struct runner_job *jobs, struct runner_result *results, size_t count, size_t threads,
+                     const char *debugger);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <emu8086.h>
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/jit.h>
+#include <cpu/io.h>
+#include <cpu/flags.h>
+#include <cpu/opcodes.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// The handle is the CPU itself, the public header just never shows its layout
+struct emu8086 {
+    struct cpu cpu;
+};
+
+static inline int emu8086_range(uint32_t addr, size_t size) {
+    return addr <= MEMORY_SIZE && size <= MEMORY_SIZE - addr;
+}
+
+static inline int emu8086_pages(uint32_t base, uint32_t size) {
+    return emu8086_range(base, size) && size && !((base | size) & (MEMORY_PAGE_SIZE - 1));
+}
+
+static inline int emu8086_status(const struct cpu *cpu) {
+    if (cpu->state & CPU_HALTED) return EMU8086_HALTED;
+    if (cpu->state & CPU_WAITING) return EMU8086_WAITING;
+    return EMU8086_BUDGET;
+}
+
+// RAM from address 0 up to ram_size, rounded up to whole pages, with nothing mapped above it
+struct emu8086 *emu8086_create(uint32_t ram_size, uint32_t options) {
+    if (!ram_size || ram_size > MEMORY_SIZE) return NULL;
+
+    struct emu8086 *emu = calloc(1, sizeof(struct emu8086));
+    if (!emu) return NULL;
+    struct cpu *cpu = &emu->cpu;
+
+    if (memory_create(cpu) < 0 || io_create(cpu) < 0) goto fail;
+    if ((options & (EMU8086_BLOCK_CACHE | EMU8086_JIT)) && block_cache_create(cpu) < 0) goto fail;
+#ifdef CPU_JIT
+    if ((options & EMU8086_JIT) && jit_create(cpu) < 0) goto fail;
+#endif
+
+    memory_map_ram(cpu, 0, (ram_size + MEMORY_PAGE_SIZE - 1) & ~(MEMORY_PAGE_SIZE - 1));
+    cpu->timing = (options & EMU8086_TIMING_FAST) ? CPU_TIMING_FAST : CPU_TIMING_ACCURATE;
+    cpu->idle = CPU_IDLE_SKIP;
+    return emu;
+
+fail:
+    emu8086_destroy(emu);
+    return NULL;
+}
+
+void emu8086_destroy(struct emu8086 *emu) {
+    if (!emu) return;
+    struct cpu *cpu = &emu->cpu;
+#ifdef CPU_JIT
+    if (cpu->jit) jit_destroy(cpu);
+#endif
+    if (cpu->blocks) block_cache_destroy(cpu);
+    io_destroy(cpu);
+    memory_destroy(cpu);
+    free(emu);
+}
+
+int emu8086_load(struct emu8086 *emu, uint32_t addr, const void *data, size_t size) {
+    if (!emu8086_range(addr, size)) return -1;
+    memory_load(&emu->cpu, addr, data, size);
+    return 0;
+}
+
+// Reads what the guest would see, unmapped addresses read as 0xff
+int emu8086_read(struct emu8086 *emu, uint32_t addr, void *data, size_t size) {
+    if (!emu8086_range(addr, size)) return -1;
+
+    const uint8_t *span = size ? memory_span(&emu->cpu, addr, size, 0) : NULL;
+    if (span) {
+        memcpy(data, span, size);
+        return 0;
+    }
+    for (size_t i = 0; i < size; i++) ((uint8_t *) data)[i] = memory_read_byte(&emu->cpu, addr + i);
+    return 0;
+}
+
+// ROM is filled with emu8086_load like RAM, only guest writes to it are dropped
+int emu8086_map_rom(struct emu8086 *emu, uint32_t base, uint32_t size) {
+    if (!emu8086_pages(base, size)) return -1;
+    memory_map_rom(&emu->cpu, base, size);
+    return 0;
+}
+
+// One instruction, whatever the block cache or JIT would otherwise batch together
+int emu8086_step(struct emu8086 *emu) {
+    struct cpu *cpu = &emu->cpu;
+    if (!(cpu->state & (CPU_HALTED | CPU_WAITING))) opcode_execute(cpu);
+    cpu->state &= ~CPU_YIELD;
+    io_flush(cpu);
+    return emu8086_status(cpu);
+}
+
+// Runs for budget cycles, or instructions with EMU8086_TIMING_FAST, or until the CPU halts or waits in HLT
+int emu8086_run(struct emu8086 *emu, uint64_t budget) {
+    struct cpu *cpu = &emu->cpu;
+    if (!(cpu->state & CPU_WAITING)) cpu_run(cpu, budget);
+    return emu8086_status(cpu);
+}
+
+// Takes the interrupt now, the way an acknowledged IRQ would be, if IF lets it through
+int emu8086_interrupt(struct emu8086 *emu, uint8_t vector) {
+    struct cpu *cpu = &emu->cpu;
+    if (!(flags_get(cpu) & CPU_FLAGS_INTERRUPTS)) return -1;
+    cpu->state &= ~CPU_WAITING;
+    cpu_interrupt(cpu, vector);
+    return 0;
+}
+
+// Power-on state: FFFF:0000, flags and registers clear, memory left as it is
+void emu8086_reset(struct emu8086 *emu) {
+    struct cpu *cpu = &emu->cpu;
+    memset(&cpu->reg, 0, sizeof(cpu->reg));
+    flags_set(cpu, 0);
+    cpu->reg.cs = 0xffff;
+    cpu->reg.ip32 = 0xffff0;
+    cpu->state = 0;
+}
+
+uint64_t emu8086_cycles(const struct emu8086 *emu) {
+    return emu->cpu.cycles;
+}
+
+uint16_t emu8086_get_reg(const struct emu8086 *emu, int reg) {
+    struct cpu *cpu = (struct cpu *) &emu->cpu;
+    if (reg >= EMU8086_REG_AX && reg <= EMU8086_REG_DI) return cpu->reg.gpr[reg];
+    if (reg >= EMU8086_REG_ES && reg <= EMU8086_REG_DS) return cpu->reg.sreg[reg - EMU8086_REG_ES];
+    if (reg == EMU8086_REG_IP) return cpu->reg.ip;
+    if (reg == EMU8086_REG_FLAGS) return flags_get(cpu);
+    return 0;
+}
+
+// CS and IP keep the linear fetch address in step
+void emu8086_set_reg(struct emu8086 *emu, int reg, uint16_t value) {
+    struct cpu *cpu = &emu->cpu;
+    if (reg >= EMU8086_REG_AX && reg <= EMU8086_REG_DI) cpu->reg.gpr[reg] = value;
+    else if (reg >= EMU8086_REG_ES && reg <= EMU8086_REG_DS) cpu->reg.sreg[reg - EMU8086_REG_ES] = value;
+    else if (reg == EMU8086_REG_IP) cpu->reg.ip = value;
+    else if (reg == EMU8086_REG_FLAGS) flags_set(cpu, value);
+    cpu->reg.ip32 = (cpu->reg.cs * 16 + cpu->reg.ip) & MEMORY_MASK;
+}
+
+int emu8086_attach_ports(struct emu8086 *emu, uint16_t base, uint32_t count, const struct emu8086_port *port) {
+    struct io_device device = {.read = port->read, .write = port->write, .ctx = port->ctx};
+    return io_attach(&emu->cpu, base, count, &device) < 0 ? -1 : 0;
+}
+
+void emu8086_detach_ports(struct emu8086 *emu, uint16_t base, uint32_t count) {
+    io_detach(&emu->cpu, base, count);
+}
+
+int emu8086_attach_mmio(struct emu8086 *emu, uint32_t base, uint32_t size, const struct emu8086_mmio *mmio) {
+    if (!emu8086_pages(base, size)) return -1;
+    struct memory_mmio device = {.read = mmio->read, .write = mmio->write, .ctx = mmio->ctx};
+    memory_map_mmio(&emu->cpu, base, size, &device);
+    return 0;
+}
\ No newline at end of file
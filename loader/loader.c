@@ -0,0 +1,198 @@
+#include <loader/loader.h>
+#include <cpu/memory.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOADER_MZ_HEADER 0x1c
+#define LOADER_COM_MAX (0x10000 - 0x100 - 2)
+
+static inline uint16_t loader_word(const uint8_t *data, size_t offset) {
+    return data[offset] | data[offset + 1] << 8;
+}
+
+// Whole file in host memory: mapped when it is big, read when it is small
+static const uint8_t *loader_open(const char *path, size_t *size, int *mapped) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    uint8_t *data = NULL;
+    if (fstat(fd, &st) < 0 || !st.st_size || st.st_size > MEMORY_SIZE) goto done;
+    *size = st.st_size;
+    *mapped = *size > LOADER_MMAP_THRESHOLD;
+
+    if (*mapped) {
+        data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) data = NULL;
+        goto done;
+    }
+
+    data = malloc(*size);
+    if (data && read(fd, data, *size) != (ssize_t) *size) {
+        free(data);
+        data = NULL;
+    }
+
+done:
+    close(fd);
+    return data;
+}
+
+static void loader_close(const uint8_t *data, size_t size, int mapped) {
+    if (mapped) munmap((void *) data, size);
+    else free((void *) data);
+}
+
+// Environment with no variables, just the program name DOS 3+ appends after the double NUL
+static void loader_environment(struct cpu *cpu, uint16_t segment, const char *path) {
+    const char *name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+
+    uint8_t block[LOADER_ENVIRONMENT_PARAGRAPHS * 16] = {0, 0, 1, 0, 'C', ':', '\\'};
+    size_t length = strlen(name);
+    if (length > sizeof(block) - 8) length = sizeof(block) - 8;
+    for (size_t i = 0; i < length; i++) block[7 + i] = name[i] >= 'a' && name[i] <= 'z' ? name[i] - 32 : name[i];
+    memory_load(cpu, segment * 16, block, sizeof(block));
+}
+
+static void loader_psp(struct cpu *cpu, const struct loader_image *image, uint16_t top, const char *args) {
+    uint8_t psp[256] = {0};
+
+    // INT 20h at offset 0 so a near RET off the initial stack terminates
+    psp[0x00] = 0xcd;
+    psp[0x01] = 0x20;
+    psp[0x02] = top & 0xff;
+    psp[0x03] = top >> 8;
+    psp[0x2c] = image->environment & 0xff;
+    psp[0x2d] = image->environment >> 8;
+
+    // INT 21h / RETF, the far-call entry into DOS
+    psp[0x50] = 0xcd;
+    psp[0x51] = 0x21;
+    psp[0x52] = 0xcb;
+    memset(psp + 0x5d, ' ', 11);
+    memset(psp + 0x6d, ' ', 11);
+
+    size_t length = 0;
+    if (args && *args) {
+        psp[0x81] = ' ';
+        length = 1 + strlen(args);
+        if (length > LOADER_COMMAND_TAIL) length = LOADER_COMMAND_TAIL;
+        memcpy(psp + 0x82, args, length - 1);
+    }
+    psp[0x80] = length;
+    psp[0x81 + length] = '\r';
+
+    memory_load(cpu, image->psp * 16, psp, sizeof(psp));
+}
+
+// A .COM file is one segment image at PSP:0100 and gets every paragraph up to top
+static int loader_com(struct cpu *cpu, const uint8_t *data, size_t size, uint16_t top, struct loader_image *image) {
+    if (size > LOADER_COM_MAX || (uint32_t) image->psp + 0x1000 > top) return -1;
+
+    memory_load(cpu, image->psp * 16 + 0x100, data, size);
+    image->cs = image->ss = image->psp;
+    image->ip = 0x100;
+    image->sp = 0xfffe;
+    image->end = top;
+
+    // Return address 0 points at the INT 20h in the PSP
+    memory_write_word(cpu, image->psp * 16 + 0xfffe, 0);
+    return 0;
+}
+
+/*
+    Segment fixups add the load segment to every word the relocation table points at. They run
+    as one pass over the table against a host pointer to the loaded image, falling back to the
+    memory accessors only if the program's memory isn't plain RAM.
+ */
+static void loader_relocate(struct cpu *cpu, const uint8_t *table, uint16_t count, uint16_t load, uint32_t span) {
+    uint8_t *base = memory_span(cpu, load * 16, span, 1);
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t addr = (loader_word(table, i * 4 + 2) * 16 + loader_word(table, i * 4)) & 0xfffff;
+        if (base && addr + 2 <= span) {
+            uint16_t word;
+            memcpy(&word, base + addr, 2);
+            word += load;
+            memcpy(base + addr, &word, 2);
+        } else {
+            uint32_t linear = (load * 16 + addr) & MEMORY_MASK;
+            memory_write_word(cpu, linear, memory_read_word(cpu, linear) + load);
+        }
+    }
+}
+
+// An MZ .EXE is loaded one paragraph past the PSP and given memory between its min and max allocation
+static int loader_mz(struct cpu *cpu, const uint8_t *data, size_t size, uint16_t top, struct loader_image *image) {
+    if (size < LOADER_MZ_HEADER) return -1;
+
+    uint16_t last = loader_word(data, 0x02);
+    uint16_t pages = loader_word(data, 0x04);
+    uint16_t relocations = loader_word(data, 0x06);
+    uint32_t header = loader_word(data, 0x08) * 16;
+    uint16_t min_alloc = loader_word(data, 0x0a);
+    uint16_t max_alloc = loader_word(data, 0x0c);
+    uint32_t table = loader_word(data, 0x18);
+
+    uint32_t length = pages * 512 - (last ? 512 - last : 0);
+    if (length > size) length = size;
+    if (header > length || table + relocations * 4 > size) return -1;
+    length -= header;
+
+    uint16_t load = image->psp + 0x10;
+    uint32_t paragraphs = (length + 15) / 16;
+    if (load + paragraphs + min_alloc > top) return -1;
+
+    memory_load(cpu, load * 16, data + header, length);
+    loader_relocate(cpu, data + table, relocations, load, (top - load) * 16);
+
+    image->ss = load + loader_word(data, 0x0e);
+    image->sp = loader_word(data, 0x10);
+    image->ip = loader_word(data, 0x14);
+    image->cs = load + loader_word(data, 0x16);
+    image->end = load + paragraphs + max_alloc > top ? top : load + paragraphs + max_alloc;
+    return 0;
+}
+
+/*
+    Loads the program at path the way DOS EXEC would: environment at segment, PSP right after it
+    and the image behind the PSP. top is the first paragraph the program can't use. The file is
+    taken as an MZ executable when it starts with the signature, as a .COM image otherwise.
+ */
+int loader_load(struct cpu *cpu, const char *path, const char *args, uint16_t segment, uint16_t top, struct loader_image *image) {
+    size_t size;
+    int mapped;
+    const uint8_t *data = loader_open(path, &size, &mapped);
+    if (!data) return -1;
+
+    *image = (struct loader_image) {0};
+    image->environment = segment;
+    image->psp = segment + LOADER_ENVIRONMENT_PARAGRAPHS;
+
+    int mz = size >= 2 && ((data[0] == 'M' && data[1] == 'Z') || (data[0] == 'Z' && data[1] == 'M'));
+    int result = image->psp + 0x10 > top ? -1 : mz ? loader_mz(cpu, data, size, top, image) : loader_com(cpu, data, size, top, image);
+    loader_close(data, size, mapped);
+    if (result < 0) return -1;
+
+    loader_environment(cpu, image->environment, path);
+    loader_psp(cpu, image, top, args);
+    return 0;
+}
+
+// DS and ES point at the PSP on entry, as DOS leaves them
+void loader_start(struct cpu *cpu, const struct loader_image *image) {
+    cpu->reg.cs = image->cs;
+    cpu->reg.ip = image->ip;
+    cpu->reg.ip32 = (image->cs * 16 + image->ip) & MEMORY_MASK;
+    cpu->reg.ss = image->ss;
+    cpu->reg.sp = image->sp;
+    cpu->reg.ds = cpu->reg.es = image->psp;
+    cpu->reg.ax = cpu->reg.bx = cpu->reg.cx = cpu->reg.dx = 0;
+    cpu->reg.si = cpu->reg.di = cpu->reg.bp = 0;
+}
\ No newline at end of file
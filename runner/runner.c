@@ -0,0 +1,223 @@
+#include <runner/runner.h>
+
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/jit.h>
+#include <cpu/flags.h>
+#include <cpu/gdb.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Every worker owns a [next, end) range of job indices packed into one 64-bit word.
+    The owner pops from the front and thieves take the back half, both with a single
+    CAS, so nothing on the hot path ever takes a lock.
+ */
+#define RUNNER_RANGE(next, end) ((uint64_t) (end) << 32 | (uint32_t) (next))
+#define RUNNER_NEXT(range) ((uint32_t) (range))
+#define RUNNER_END(range) ((uint32_t) ((range) >> 32))
+
+// Instructions a debugged worker runs between polls of its stub
+#define RUNNER_SLICE 100000
+
+struct runner_worker {
+    _Atomic uint64_t range;
+    pthread_t thread;
+    size_t id;
+    struct runner *runner;
+    struct cpu *cpu;
+    struct gdb *gdb;
+    struct snapshot clean;
+} __attribute__((aligned(64)));
+
+struct runner {
+    const struct runner_job *jobs;
+    struct runner_result *results;
+    struct runner_worker *workers;
+    size_t threads;
+    const char *debugger;
+};
+
+static int runner_pop(struct runner_worker *worker, size_t *job) {
+    uint64_t range = atomic_load(&worker->range);
+    while (RUNNER_NEXT(range) < RUNNER_END(range)) {
+        uint64_t taken = RUNNER_RANGE(RUNNER_NEXT(range) + 1, RUNNER_END(range));
+        if (atomic_compare_exchange_weak(&worker->range, &range, taken)) {
+            *job = RUNNER_NEXT(range);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Moves the back half of a victim's range into our (empty) range
+static int runner_steal(struct runner_worker *worker) {
+    struct runner *runner = worker->runner;
+
+    for (size_t i = 1; i < runner->threads; i++) {
+        struct runner_worker *victim = &runner->workers[(worker->id + i) % runner->threads];
+        uint64_t range = atomic_load(&victim->range);
+
+        while (RUNNER_NEXT(range) < RUNNER_END(range)) {
+            uint32_t left = RUNNER_END(range) - RUNNER_NEXT(range);
+            uint32_t split = RUNNER_END(range) - (left + 1) / 2;
+            if (atomic_compare_exchange_weak(&victim->range, &range, RUNNER_RANGE(RUNNER_NEXT(range), split))) {
+                atomic_store(&worker->range, RUNNER_RANGE(split, RUNNER_END(range)));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+    Runs a job in slices so the worker's stub gets polled. A debugger can attach at any time,
+    and one that is attached when the job halts gets to look at it before the next job
+    replaces it.
+ */
+static int runner_run_debugged(struct runner_worker *worker, uint64_t steps) {
+    struct cpu *cpu = worker->cpu;
+    struct gdb *gdb = worker->gdb;
+    uint64_t end = cpu->cycles + steps;
+
+    while (cpu->cycles < end && !(cpu->state & CPU_HALTED)) {
+        if (!gdb_poll(gdb)) {
+            gdb_wait(gdb, 100);
+            continue;
+        }
+        cpu_run(cpu, end - cpu->cycles < RUNNER_SLICE ? end - cpu->cycles : RUNNER_SLICE);
+    }
+    while (!gdb_poll(gdb)) gdb_wait(gdb, 100);
+    return (cpu->state & CPU_HALTED) != 0;
+}
+
+static void runner_execute(struct runner_worker *worker, const struct runner_job *job, struct runner_result *result) {
+    struct cpu *cpu = worker->cpu;
+
+    // Only the pages the previous job touched get put back
+    cpu_restore(cpu, &worker->clean);
+
+    cpu->reg.cs = job->cs;
+    cpu->reg.ip = job->ip;
+    cpu->reg.ip32 = (job->cs * 16 + job->ip) & MEMORY_MASK;
+    cpu->reg.ss = job->ss;
+    cpu->reg.sp = job->sp;
+    memory_load(cpu, cpu->reg.ip32, job->image, job->image_size);
+
+    result->halted = worker->gdb ? runner_run_debugged(worker, job->steps) : cpu_run(cpu, job->steps);
+    result->flags = flags_get(cpu);
+    result->reg = cpu->reg;
+}
+
+static void *runner_worker_main(void *arg) {
+    struct runner_worker *worker = arg;
+    struct runner *runner = worker->runner;
+    size_t job;
+
+    do {
+        while (runner_pop(worker, &job))
+            runner_execute(worker, &runner->jobs[job], &runner->results[job]);
+    } while (runner_steal(worker));
+
+    return NULL;
+}
+
+static struct cpu *runner_create_cpu(void) {
+    struct cpu *cpu = calloc(1, sizeof(struct cpu));
+    if (!cpu) return NULL;
+
+    if (memory_create(cpu) < 0 || block_cache_create(cpu) < 0) {
+        memory_destroy(cpu);
+        free(cpu);
+        return NULL;
+    }
+    memory_map_ram(cpu, 0, RUNNER_RAM_SIZE);
+
+    // Batch jobs are bounded by instruction count, nobody is watching the clock
+    cpu->timing = CPU_TIMING_FAST;
+    // Workers share the host, a guest spinning on a flag shouldn't hold a core while it waits
+    cpu->idle = CPU_IDLE_SKIP | CPU_IDLE_YIELD;
+#ifdef CPU_JIT
+    jit_create(cpu);
+#endif
+    return cpu;
+}
+
+// Worker n listens at unix:path.n, or on the TCP port plus n
+static struct gdb *runner_create_gdb(struct cpu *cpu, const char *address, size_t id) {
+    char worker[256];
+
+    if (!strncmp(address, "unix:", 5)) {
+        snprintf(worker, sizeof(worker), "%s.%zu", address, id);
+    } else {
+        const char *port = strncmp(address, "tcp:", 4) ? address : address + 4;
+        char *end;
+        unsigned long number = strtoul(port, &end, 10);
+        if (*end || !number) return NULL;
+        snprintf(worker, sizeof(worker), "tcp:%lu", number + id);
+    }
+    return gdb_create(cpu, worker);
+}
+
+static void runner_destroy_cpu(struct cpu *cpu) {
+    if (!cpu) return;
+#ifdef CPU_JIT
+    jit_destroy(cpu);
+#endif
+    block_cache_destroy(cpu);
+    memory_destroy(cpu);
+    free(cpu);
+}
+
+// Runs every job, results[i] belongs to jobs[i]. Returns 0 once all of them finished.
+int runner_run(const struct runner_job *jobs, struct runner_result *results, size_t count, size_t threads) {
+    return runner_run_debug(jobs, results, count, threads, NULL);
+}
+
+// As runner_run, with a GDB stub per worker listening on an address derived from debugger
+int runner_run_debug(const struct runner_job *jobs, struct runner_result *results, size_t count, size_t threads,
+                     const char *debugger) {
+    if (threads == 0) threads = 1;
+    if (threads > count && count) threads = count;
+
+    struct runner runner = {jobs, results, NULL, threads, debugger};
+    runner.workers = calloc(threads, sizeof(struct runner_worker));
+    if (!runner.workers) return -1;
+
+    int ret = 0;
+    size_t started = 0;
+
+    for (size_t i = 0; i < threads; i++) {
+        struct runner_worker *worker = &runner.workers[i];
+        worker->id = i;
+        worker->runner = &runner;
+        atomic_init(&worker->range, RUNNER_RANGE(count * i / threads, count * (i + 1) / threads));
+        worker->cpu = runner_create_cpu();
+        if (!worker->cpu || cpu_snapshot(worker->cpu, &worker->clean) < 0) ret = -1;
+        else if (debugger && !(worker->gdb = runner_create_gdb(worker->cpu, debugger, i))) ret = -1;
+    }
+
+    // A thread that fails to start leaves its range to be stolen by the others
+    for (size_t i = 0; i < threads && !ret; i++) {
+        if (pthread_create(&runner.workers[i].thread, NULL, runner_worker_main, &runner.workers[i])) break;
+        started++;
+    }
+    if (!ret && !started) runner_worker_main(&runner.workers[0]);
+
+    for (size_t i = 0; i < started; i++)
+        pthread_join(runner.workers[i].thread, NULL);
+
+    for (size_t i = 0; i < threads; i++) {
+        if (runner.workers[i].gdb) gdb_exit(runner.workers[i].gdb, ret);
+        gdb_destroy(runner.workers[i].gdb);
+        runner_destroy_cpu(runner.workers[i].cpu);
+        cpu_snapshot_free(&runner.workers[i].clean);
+    }
+    free(runner.workers);
+    return ret;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cpu/cpu.h>
+#include <cpu/memory.h>
+#include <cpu/block.h>
+#include <cpu/jit.h>
+#include <cpu/flags.h>
+
+#include "check.h"
+
+#define CHECK_MEMORY (640 * 1024)
+#define CHECK_SEGMENT 0x1000
+// Every snippet halts long before this, running into it means it never got to its HLT
+#define CHECK_BUDGET 10000000
+
+#if defined(CPU_JIT)
+#define CHECK_BUILD "jit"
+#elif defined(CPU_THREADED)
+#define CHECK_BUILD "threaded"
+#else
+#define CHECK_BUILD "plain"
+#endif
+
+static const char *const check_timing_names[] = {"accurate", "fast"};
+
+// Stands in for an interrupt controller with a single request, INTR drops once it is accepted
+struct check_intc {
+    struct cpu *cpu;
+    uint8_t vector;
+};
+
+static uint8_t check_acknowledge(void *ctx) {
+    struct check_intc *intc = ctx;
+    cpu_set_intr(intc->cpu, 0);
+    return intc->vector;
+}
+
+static void check_setup(struct cpu *cpu, const char *code, size_t length, uint8_t timing) {
+    cpu_set_timing(cpu, timing);
+    block_cache_flush(cpu);
+    memset(cpu->memory.backing, 0, CHECK_MEMORY);
+    memset(&cpu->reg, 0, sizeof(cpu->reg));
+    memset(&cpu->lazy, 0, sizeof(cpu->lazy));
+    cpu->state = 0;
+    cpu->cycles = 0;
+    cpu->intr = 0;
+    cpu->intc.acknowledge = NULL;
+
+    memory_load(cpu, CHECK_SEGMENT * 16 + 0x100, code, length);
+    for (size_t i = 0; i < 4; i++) cpu->reg.sreg[i] = CHECK_SEGMENT;
+    cpu->reg.sp = 0xfffe;
+    cpu->reg.ip = 0x100;
+    cpu->reg.ip32 = CHECK_SEGMENT * 16 + 0x100;
+}
+
+static int check_fail(const char *name, uint8_t timing, const char *what) {
+    printf("FAIL %s (%s, %s timing): %s\n", name, CHECK_BUILD, check_timing_names[timing], what);
+    return 1;
+}
+
+/*
+    Runs the snippet through this build's block cache (and JIT) and through the reference, which
+    has neither and steps opcode_execute, then holds both up against the snippet's expectations.
+    Returns the number of things that went wrong.
+ */
+static int check_run(struct cpu *cpu, struct cpu *reference, const struct check_snippet *snippet, uint8_t timing) {
+    struct check_intc intcs[] = {{cpu, snippet->vector}, {reference, snippet->vector}};
+    for (size_t i = 0; i < 2; i++) {
+        check_setup(intcs[i].cpu, snippet->code, snippet->length, timing);
+        if (!snippet->vector) continue;
+        intcs[i].cpu->intc.acknowledge = check_acknowledge;
+        intcs[i].cpu->intc.ctx = &intcs[i];
+        cpu_set_intr(intcs[i].cpu, 1);
+    }
+    int halted = cpu_run(cpu, CHECK_BUDGET);
+    int reference_halted = cpu_run(reference, CHECK_BUDGET);
+
+    if (!halted || !reference_halted) return check_fail(snippet->name, timing, "never reached its HLT");
+
+    char what[128];
+    for (size_t i = 0; i < 8; i++) {
+        if (cpu->reg.gpr[i] == snippet->regs[i]) continue;
+        snprintf(what, sizeof(what), "register %zu is 0x%04x, expected 0x%04x", i, cpu->reg.gpr[i], snippet->regs[i]);
+        return check_fail(snippet->name, timing, what);
+    }
+    if ((flags_get(cpu) & CPU_FLAGS_ARITH) != snippet->flags) {
+        snprintf(what, sizeof(what), "flags are 0x%04x, expected 0x%04x", flags_get(cpu) & CPU_FLAGS_ARITH, snippet->flags);
+        return check_fail(snippet->name, timing, what);
+    }
+
+    if (memcmp(&cpu->reg.gpr, &reference->reg.gpr, sizeof(cpu->reg.gpr)) || memcmp(&cpu->reg.sreg, &reference->reg.sreg, sizeof(cpu->reg.sreg)) ||
+        cpu->reg.ip32 != reference->reg.ip32 || flags_get(cpu) != flags_get(reference))
+        return check_fail(snippet->name, timing, "registers differ from the interpreter's");
+    if (cpu->cycles != reference->cycles) return check_fail(snippet->name, timing, "cycles differ from the interpreter's");
+    if (memcmp(cpu->memory.backing, reference->memory.backing, CHECK_MEMORY))
+        return check_fail(snippet->name, timing, "memory differs from the interpreter's");
+    return 0;
+}
+
+/*
+    Runs a vector's instruction, followed by a HLT, and compares the registers it changes and the
+    flags the 8086 defines for it. The reference has to end up with exactly the same state.
+ */
+static int check_vector_run(struct cpu *cpu, struct cpu *reference, const struct check_vector *vector) {
+    char code[16], what[128];
+    memcpy(code, vector->code, vector->length);
+    code[vector->length] = (char) 0xf4;
+
+    struct cpu *cpus[] = {cpu, reference};
+    for (size_t i = 0; i < 2; i++) {
+        check_setup(cpus[i], code, vector->length + 1, CPU_TIMING_ACCURATE);
+        memcpy(cpus[i]->reg.gpr, vector->in, sizeof(vector->in));
+        flags_set(cpus[i], vector->in_flags);
+        if (!cpu_run(cpus[i], CHECK_BUDGET)) return check_fail(vector->name, CPU_TIMING_ACCURATE, "never reached its HLT");
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        if (cpu->reg.gpr[i] == vector->out[i]) continue;
+        snprintf(what, sizeof(what), "register %zu is 0x%04x from 0x%04x 0x%04x 0x%04x 0x%04x flags 0x%04x, expected 0x%04x", i,
+                 cpu->reg.gpr[i], vector->in[0], vector->in[1], vector->in[2], vector->in[3], vector->in_flags, vector->out[i]);
+        return check_fail(vector->name, CPU_TIMING_ACCURATE, what);
+    }
+    if ((flags_get(cpu) & vector->defined) != vector->out_flags) {
+        snprintf(what, sizeof(what), "flags are 0x%04x from 0x%04x 0x%04x 0x%04x 0x%04x flags 0x%04x, expected 0x%04x", flags_get(cpu) & vector->defined,
+                 vector->in[0], vector->in[1], vector->in[2], vector->in[3], vector->in_flags, vector->out_flags);
+        return check_fail(vector->name, CPU_TIMING_ACCURATE, what);
+    }
+    if (memcmp(&cpu->reg.gpr, &reference->reg.gpr, sizeof(cpu->reg.gpr)) || cpu->reg.ip32 != reference->reg.ip32 ||
+        flags_get(cpu) != flags_get(reference) || cpu->cycles != reference->cycles)
+        return check_fail(vector->name, CPU_TIMING_ACCURATE, "state differs from the interpreter's");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *only = argc > 1 ? argv[1] : NULL;
+
+    // The reference has no block cache, so it runs every instruction through opcode_execute
+    static struct cpu cpu, reference;
+    struct cpu *cpus[] = {&cpu, &reference};
+    for (size_t i = 0; i < 2; i++) {
+        if (memory_create(cpus[i]) < 0) {
+            fprintf(stderr, "[!] Can't set up the check CPU\n");
+            return 1;
+        }
+        memory_map_ram(cpus[i], 0, CHECK_MEMORY);
+    }
+    if (block_cache_create(&cpu) < 0) {
+        fprintf(stderr, "[!] Can't set up the block cache\n");
+        return 1;
+    }
+#ifdef CPU_JIT
+    if (jit_create(&cpu) < 0) {
+        fprintf(stderr, "[!] Can't set up the JIT\n");
+        return 1;
+    }
+#endif
+
+    size_t run = 0, failed = 0;
+    for (size_t i = 0; i < check_snippet_count; i++) {
+        if (only && strcmp(only, check_snippets[i].name)) continue;
+        for (uint8_t timing = CPU_TIMING_ACCURATE; timing <= CPU_TIMING_FAST; timing++) {
+            failed += check_run(&cpu, &reference, &check_snippets[i], timing);
+            run++;
+        }
+    }
+    for (size_t i = 0; i < check_vector_count; i++) {
+        if (only && strcmp(only, check_vectors[i].name)) continue;
+        failed += check_vector_run(&cpu, &reference, &check_vectors[i]);
+        run++;
+    }
+    printf("%s: %zu of %zu runs passed\n", CHECK_BUILD, run - failed, run);
+
+#ifdef CPU_JIT
+    jit_destroy(&cpu);
+#endif
+    block_cache_destroy(&cpu);
+    for (size_t i = 0; i < 2; i++) memory_destroy(cpus[i]);
+    return failed != 0;
+}
\ No newline at end of file
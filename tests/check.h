@@ -0,0 +1,45 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+    A snippet is a small .COM style program. The harness loads it at 1000:0100 with CS, DS, ES
+    and SS all 1000h, SP=FFFE, every other register and FLAGS zero, and runs it until it stops
+    on its HLT. The general registers (in encoding order) and the arithmetic flags it ends with
+    have to match, and so does everything a plain interpreter ends up with. A snippet with a
+    vector starts with INTR up for it, the request is taken as soon as the snippet sets IF.
+ */
+struct check_snippet {
+    const char *name;
+    const char *code;
+    size_t length;
+    uint16_t regs[8];
+    uint16_t flags;
+    uint8_t vector;
+};
+
+/*
+    A vector is one instruction run from the given AX, CX, DX, BX and FLAGS, everything else set up
+    as for a snippet. Only the flags in defined are compared, the 8086 leaves the rest undefined.
+ */
+struct check_vector {
+    const char *name;
+    const char *code;
+    size_t length;
+    uint16_t in[4];
+    uint16_t in_flags;
+    uint16_t out[4];
+    uint16_t out_flags;
+    uint16_t defined;
+};
+
+#define CHECK_CODE(s) s, sizeof(s) - 1
+
+extern const struct check_snippet check_snippets[];
+extern const size_t check_snippet_count;
+extern const struct check_vector check_vectors[];
+extern const size_t check_vector_count;
+
+#endif
\ No newline at end of file
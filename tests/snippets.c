@@ -0,0 +1,236 @@
+#include <cpu/cpu.h>
+
+#include "check.h"
+
+// Expected registers are AX CX DX BX SP BP SI DI. Loops go round often enough for the JIT to translate them.
+const struct check_snippet check_snippets[] = {
+        /*
+            mov ax, 0x7fff
+            add ax, 1
+            mov bx, ax
+            mov cx, 5
+            sub cx, 7
+            mov dx, 0x00f0
+            and dx, 0x0f0f
+            hlt
+        */
+        {"alu_flags", CHECK_CODE("\xb8\xff\x7f\x83\xc0\x01\x89\xc3\xb9\x05\x00\x83\xe9\x07\xba\xf0\x00\x81\xe2\x0f\x0f\xf4"),
+         {0x8000, 0xfffe, 0x0000, 0x8000, 0xfffe, 0, 0, 0}, CPU_FLAGS_ZERO | CPU_FLAGS_PARITY},
+        /*
+            xor ax, ax
+            xor bx, bx
+            mov cx, 300
+            1: add ax, cx
+            adc bx, 0
+            loop 1b
+            cmp ax, bx
+            hlt
+        */
+        {"loop_sum", CHECK_CODE("\x31\xc0\x31\xdb\xb9\x2c\x01\x01\xc8\x83\xd3\x00\xe2\xf9\x39\xd8\xf4"),
+         {0xb05e, 0, 0, 0, 0xfffe, 0, 0, 0}, CPU_FLAGS_SIGN},
+        // INC and DEC keep whatever carry was there before them
+        /*
+            mov cx, 200
+            xor ax, ax
+            xor dx, dx
+            1: stc
+            inc ax
+            adc dx, 0
+            dec cx
+            jnz 1b
+            clc
+            dec ax
+            sbb dx, 0
+            hlt
+        */
+        {"lazy_carry", CHECK_CODE("\xb9\xc8\x00\x31\xc0\x31\xd2\xf9\x40\x83\xd2\x00\x49\x75\xf8\xf8\x48\x83\xda\x00\xf4"),
+         {0x00c7, 0, 0x00c8, 0, 0xfffe, 0, 0, 0}, 0},
+        // Patches the immediate of a called block after every call, then an instruction further on in the running block
+        /*
+            xor bx, bx
+            mov cx, 200
+            1: call 2f
+            add bx, ax
+            inc byte ptr [2f + 1]
+            loop 1b
+            mov byte ptr [3f], 0x40
+            xor ax, ax
+            3: nop
+            hlt
+            2: mov al, 1
+            xor ah, ah
+            ret
+        */
+        {"smc_immediate", CHECK_CODE("\x31\xdb\xb9\xc8\x00\xe8\x11\x00\x01\xc3\xfe\x06\x1a\x01\xe2\xf5\xc6\x06\x17\x01\x40\x31\xc0\x90\xf4\xb0\x01\x30\xe4\xc3"),
+         {0x0001, 0, 0, 0x4e84, 0xfffe, 0, 0, 0}, 0},
+        // Stores into variables right next to the loop, which has to survive them
+        /*
+            mov cx, 1000
+            1: inc word ptr [2f]
+            add word ptr [2f + 2], 3
+            loop 1b
+            mov ax, [2f]
+            mov dx, [2f + 2]
+            hlt
+            2: .word 0, 0
+        */
+        {"data_in_code_page", CHECK_CODE("\xb9\xe8\x03\xff\x06\x16\x01\x83\x06\x18\x01\x03\xe2\xf5\xa1\x16\x01\x8b\x16\x18\x01\xf4\x00\x00\x00\x00"),
+         {0x03e8, 0, 0x0bb8, 0, 0xfffe, 0, 0, 0}, CPU_FLAGS_PARITY},
+        /*
+            cld
+            mov si, offset 1f
+            mov di, 0x800
+            mov cx, 5
+            rep movsb
+            mov si, 0x800
+            lodsw
+            mov bx, ax
+            lodsw
+            mov dx, ax
+            lodsb
+            hlt
+            1: .byte 1, 2, 3, 4, 5
+        */
+        {"rep_movs", CHECK_CODE("\xfc\xbe\x17\x01\xbf\x00\x08\xb9\x05\x00\xf3\xa4\xbe\x00\x08\xad\x89\xc3\xad\x89\xc2\xac\xf4\x01\x02\x03\x04\x05"),
+         {0x0405, 0, 0x0403, 0x0201, 0xfffe, 0, 0x0805, 0x0805}, 0},
+        // STOS backwards, REPE CMPS stopping on a mismatch, REPNE SCAS running out and LODS
+        /*
+            std
+            mov di, 0x903
+            mov al, 0x5a
+            mov cx, 4
+            rep stosb
+            cld
+            mov si, 0x900
+            mov di, offset 1f
+            mov cx, 4
+            repe cmpsb
+            mov bx, cx
+            mov di, 0x900
+            mov al, 0x11
+            mov cx, 4
+            repne scasb
+            mov dx, cx
+            mov si, 0x902
+            lodsw
+            mov bp, si
+            hlt
+            1: .byte 0x5a, 0x5a, 0x33, 0x5a
+        */
+        {"string_ops", CHECK_CODE("\xfd\xbf\x03\x09\xb0\x5a\xb9\x04\x00\xf3\xaa\xfc\xbe\x00\x09\xbf\x2c\x01\xb9\x04\x00\xf3\xa6\x89\xcb\xbf\x00\x09\xb0\x11\xb9\x04\x00\xf2\xae\x89\xca\xbe\x02\x09\xad\x89\xf5\xf4\x5a\x5a\x33\x5a"),
+         {0x5a5a, 0, 0, 0x0001, 0xfffe, 0x0904, 0x0904, 0x0904}, CPU_FLAGS_CARRY | CPU_FLAGS_PARITY | CPU_FLAGS_ACARRY | CPU_FLAGS_SIGN},
+        // Register forms of every native translator class next to ones that fall back
+        /*
+            xor ax, ax
+            mov bx, 0x1234
+            xor dx, dx
+            mov cx, 200
+            1: add al, cl
+            adc ah, 0
+            mov dl, al
+            sub dx, bx
+            or bl, 3
+            and bh, 0x7f
+            xor bx, cx
+            cmp al, 0x80
+            jb 2f
+            inc dx
+            2: cmp dx, bx
+            jg 3f
+            dec dx
+            3: sub bx, -3
+            mov si, dx
+            loop 1b
+            hlt
+        */
+        {"native_mix", CHECK_CODE("\x31\xc0\xbb\x34\x12\x31\xd2\xb9\xc8\x00\x00\xc8\x80\xd4\x00\x88\xc2\x29\xda\x80\xcb\x03\x80\xe7\x7f\x31\xcb\x3c\x80\x72\x01\x42\x39\xda\x7f\x01\x4a\x83\xeb\xfd\x89\xd6\xe2\xde\xf4"),
+         {0x4e84, 0, 0x77fd, 0x148d, 0xfffe, 0, 0x77fd, 0}, CPU_FLAGS_CARRY | CPU_FLAGS_PARITY | CPU_FLAGS_ACARRY},
+        // Segment prefixes and REP in the middle of a hot block, decoded together with what they prefix
+        /*
+            mov ax, 0x2000
+            mov es, ax
+            mov cx, 100
+            mov bx, 0x800
+            1: mov es:[bx], cl
+            add al, es:[bx]
+            add cs:[bx+2], ax
+            mov di, 0x900
+            push cx
+            mov cx, 3
+            rep stosb
+            pop cx
+            .byte 0x3e
+            inc word ptr [bx+4]
+            loop 1b
+            mov dx, es:[bx]
+            mov si, [bx+2]
+            mov di, [bx+4]
+            hlt
+        */
+        {"prefixed", CHECK_CODE("\xb8\x00\x20\x8e\xc0\xb9\x64\x00\xbb\x00\x08\x26\x88\x0f\x26\x02\x07\x2e\x01\x47\x02\xbf\x00\x09\x51\xb9\x03\x00\xf3\xaa\x59\x3e\xff\x47\x04\xe2\xe6\x26\x8b\x17\x8b\x77\x02\x8b\x7f\x04\xf4"),
+         {0x20ba, 0, 0x0001, 0x0800, 0xfffe, 0, 0xb1ae, 0x0064}, 0},
+        // MOV CS and POP CS carry on from the same IP in the new segment
+        /*
+            mov ax, 0x1001
+            mov cs, ax
+            mov bx, 1
+            hlt
+            .org 0x0d
+            mov si, 3
+            hlt
+            .org 0x15
+            mov cx, 2
+            mov dx, 0x1000
+            push dx
+            pop cs
+        */
+        {"cs_write", CHECK_CODE("\xb8\x01\x10\x8e\xc8\xbb\x01\x00\xf4\x00\x00\x00\x00\xbe\x03\x00\xf4\x00\x00\x00\x00\xb9\x02\x00\xba\x00\x10\x52\x0f"),
+         {0x1001, 0x0002, 0x1000, 0, 0xfffe, 0, 0x0003, 0}, 0},
+        // STI, MOV SS and POP SS each let one more instruction through before a pending interrupt
+        /*
+            xor ax, ax
+            mov es, ax
+            mov bx, 0x80
+            mov word ptr es:[bx], offset handler + 0x100
+            mov es:[bx+2], cs
+            sti
+            mov bx, sp
+            hlt
+            handler:
+            mov cx, bx
+            hlt
+        */
+        {"sti_shadow", CHECK_CODE("\x31\xc0\x8e\xc0\xbb\x80\x00\x26\xc7\x07\x14\x01\x26\x8c\x4f\x02\xfb\x89\xe3\xf4\x89\xd9\xf4"),
+         {0, 0xfffe, 0, 0xfffe, 0xfff8, 0, 0, 0}, 0x44, 0x20},
+        /*
+            (vector 20h pointed at handler as above)
+            mov dx, 0x2000
+            sti
+            mov ss, dx
+            mov sp, 0x8000
+            mov bx, sp
+            hlt
+            handler:
+            mov cx, sp
+            hlt
+        */
+        {"mov_ss_shadow", CHECK_CODE("\x31\xc0\x8e\xc0\xbb\x80\x00\x26\xc7\x07\x1c\x01\x26\x8c\x4f\x02\xba\x00\x20\xfb\x8e\xd2\xbc\x00\x80\x89\xe3\xf4\x89\xe1\xf4"),
+         {0, 0x7ffa, 0x2000, 0x0080, 0x7ffa, 0, 0, 0}, 0x44, 0x20},
+        /*
+            (vector 20h pointed at handler as above)
+            mov dx, 0x2000
+            push dx
+            sti
+            pop ss
+            mov sp, 0x8000
+            mov bx, sp
+            hlt
+            handler:
+            mov cx, sp
+            hlt
+        */
+        {"pop_ss_shadow", CHECK_CODE("\x31\xc0\x8e\xc0\xbb\x80\x00\x26\xc7\x07\x1c\x01\x26\x8c\x4f\x02\xba\x00\x20\x52\xfb\x17\xbc\x00\x80\x89\xe3\xf4\x89\xe1\xf4"),
+         {0, 0x7ffa, 0x2000, 0x0080, 0x7ffa, 0, 0, 0}, 0x44, 0x20},
+};
+
+const size_t check_snippet_count = sizeof(check_snippets) / sizeof(check_snippets[0]);
\ No newline at end of file
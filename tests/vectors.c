@@ -0,0 +1,1025 @@
+#include <cpu/cpu.h>
+
+#include "check.h"
+
+/*
+    Results and flags come from running each instruction on an x86 host with the same inputs.
+    Inputs stay clear of the few places a later x86 differs from the 8086: shift counts below the
+    operand width, no AAA/AAS adjust that would carry into or borrow from AH, no divide errors.
+ */
+const struct check_vector check_vectors[] = {
+        // Arithmetic and logic in the r/m,reg, reg,r/m, accumulator and group 1 forms
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0890, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa01}, 0x0055, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5581, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5510, 0x0000, 0x0000, 0xaa01}, 0x0010, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5546, 0x0000, 0x0000, 0xaa34}, 0x0000, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x00\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa80}, 0x0845, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8000, 0x0000, 0x0000, 0x0001}, 0x0894, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0001}, 0x0055, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8001, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0100, 0x0000, 0x0000, 0x0001}, 0x0014, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x68ac, 0x0000, 0x0000, 0x5678}, 0x0004, 0x08d5},
+        {"add ax, bx", CHECK_CODE("\x01\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8000}, 0x0845, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x02\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0046, 0x0000, 0x0000, 0x0034}, 0x0000, 0x08d5},
+        {"add bh, cl", CHECK_CODE("\x02\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x4600}, 0x0000, 0x08d5},
+        {"add dx, cx", CHECK_CODE("\x03\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x4646, 0x0000}, 0x0000, 0x08d5},
+        {"add al, 0x34", CHECK_CODE("\x04\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0046, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"add ax, 0x3434", CHECK_CODE("\x05\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x4646, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"add ch, 0x34", CHECK_CODE("\x80\xc5\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x4600, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"add dx, 0x3434", CHECK_CODE("\x81\xc2\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x4646, 0x0000}, 0x0000, 0x08d5},
+        {"add bx, -2", CHECK_CODE("\x83\xc3\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1210}, 0x0011, 0x08d5},
+        {"add al, bl", CHECK_CODE("\x02\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x007f}, 0x0084, 0x08d5},
+        {"add bh, cl", CHECK_CODE("\x02\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0xff00}, 0x0084, 0x08d5},
+        {"add dx, cx", CHECK_CODE("\x03\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0xffff, 0x0000}, 0x0084, 0x08d5},
+        {"add al, 0x7f", CHECK_CODE("\x04\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08d5},
+        {"add ax, 0x7f7f", CHECK_CODE("\x05\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08d5},
+        {"add ch, 0x7f", CHECK_CODE("\x80\xc5\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0xff00, 0x0000, 0x0000}, 0x0084, 0x08d5},
+        {"add dx, 0x7f7f", CHECK_CODE("\x81\xc2\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0xffff, 0x0000}, 0x0084, 0x08d5},
+        {"add bx, -2", CHECK_CODE("\x83\xc3\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x807e}, 0x0085, 0x08d5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5581, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5536, 0x0000, 0x0000, 0xaa34}, 0x0004, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x08\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0080, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0004, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0001}, 0x0084, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8001, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0004, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x567c, 0x0000, 0x0000, 0x5678}, 0x0000, 0x08c5},
+        {"or ax, bx", CHECK_CODE("\x09\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x8000, 0x0000, 0x0000, 0x8000}, 0x0084, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x0a\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0036, 0x0000, 0x0000, 0x0034}, 0x0004, 0x08c5},
+        {"or bh, cl", CHECK_CODE("\x0a\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x3600}, 0x0004, 0x08c5},
+        {"or dx, cx", CHECK_CODE("\x0b\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x3636, 0x0000}, 0x0004, 0x08c5},
+        {"or al, 0x34", CHECK_CODE("\x0c\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0036, 0x0000, 0x0000, 0x0000}, 0x0004, 0x08c5},
+        {"or ax, 0x3434", CHECK_CODE("\x0d\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x3636, 0x0000, 0x0000, 0x0000}, 0x0004, 0x08c5},
+        {"or ch, 0x34", CHECK_CODE("\x80\xcd\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x3600, 0x0000, 0x0000}, 0x0004, 0x08c5},
+        {"or dx, 0x3434", CHECK_CODE("\x81\xca\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x3636, 0x0000}, 0x0004, 0x08c5},
+        {"or bx, -2", CHECK_CODE("\x83\xcb\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0xfffe}, 0x0080, 0x08c5},
+        {"or al, bl", CHECK_CODE("\x0a\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x007f}, 0x0084, 0x08c5},
+        {"or bh, cl", CHECK_CODE("\x0a\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0xff00}, 0x0084, 0x08c5},
+        {"or dx, cx", CHECK_CODE("\x0b\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0xffff, 0x0000}, 0x0084, 0x08c5},
+        {"or al, 0x7f", CHECK_CODE("\x0c\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"or ax, 0x7f7f", CHECK_CODE("\x0d\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"or ch, 0x7f", CHECK_CODE("\x80\xcd\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0xff00, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"or dx, 0x7f7f", CHECK_CODE("\x81\xca\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0xffff, 0x0000}, 0x0084, 0x08c5},
+        {"or bx, -2", CHECK_CODE("\x83\xcb\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0xfffe}, 0x0080, 0x08c5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0000, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0890, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x5500, 0x0000, 0x0000, 0xaa01}, 0x0055, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x5581, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x5510, 0x0000, 0x0000, 0xaa01}, 0x0010, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0000, {0x5546, 0x0000, 0x0000, 0xaa34}, 0x0000, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0000, {0x5500, 0x0000, 0x0000, 0xaa80}, 0x0845, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0000, {0x8000, 0x0000, 0x0000, 0x0001}, 0x0894, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0001}, 0x0055, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0000, {0x8001, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0000, {0x0100, 0x0000, 0x0000, 0x0001}, 0x0014, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0000, {0x68ac, 0x0000, 0x0000, 0x5678}, 0x0004, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x8000}, 0x0845, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa00}, 0x0000, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5581, 0x0000, 0x0000, 0xaa01}, 0x0894, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa01}, 0x0011, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5582, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5511, 0x0000, 0x0000, 0xaa01}, 0x0014, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5547, 0x0000, 0x0000, 0xaa34}, 0x0004, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x10\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa80}, 0x0801, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8001, 0x0000, 0x0000, 0x0001}, 0x0890, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0001}, 0x0011, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8002, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0101, 0x0000, 0x0000, 0x0001}, 0x0010, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x68ad, 0x0000, 0x0000, 0x5678}, 0x0000, 0x08d5},
+        {"adc ax, bx", CHECK_CODE("\x11\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x8000}, 0x0801, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x12\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0047, 0x0000, 0x0000, 0x0034}, 0x0004, 0x08d5},
+        {"adc bh, cl", CHECK_CODE("\x12\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x4700}, 0x0004, 0x08d5},
+        {"adc dx, cx", CHECK_CODE("\x13\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x4647, 0x0000}, 0x0004, 0x08d5},
+        {"adc al, 0x34", CHECK_CODE("\x14\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0047, 0x0000, 0x0000, 0x0000}, 0x0004, 0x08d5},
+        {"adc ax, 0x3434", CHECK_CODE("\x15\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x4647, 0x0000, 0x0000, 0x0000}, 0x0004, 0x08d5},
+        {"adc ch, 0x34", CHECK_CODE("\x80\xd5\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x4700, 0x0000, 0x0000}, 0x0004, 0x08d5},
+        {"adc dx, 0x3434", CHECK_CODE("\x81\xd2\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x4647, 0x0000}, 0x0004, 0x08d5},
+        {"adc bx, -2", CHECK_CODE("\x83\xd3\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1211}, 0x0015, 0x08d5},
+        {"adc al, bl", CHECK_CODE("\x12\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0000, 0x0000, 0x0000, 0x007f}, 0x0055, 0x08d5},
+        {"adc bh, cl", CHECK_CODE("\x12\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc dx, cx", CHECK_CODE("\x13\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc al, 0x7f", CHECK_CODE("\x14\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc ax, 0x7f7f", CHECK_CODE("\x15\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc ch, 0x7f", CHECK_CODE("\x80\xd5\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc dx, 0x7f7f", CHECK_CODE("\x81\xd2\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"adc bx, -2", CHECK_CODE("\x83\xd3\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x807f}, 0x0081, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0000, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x557e, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x55fe, 0x0000, 0x0000, 0xaa01}, 0x0080, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0810, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0000, {0x550e, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0000, {0x55de, 0x0000, 0x0000, 0xaa34}, 0x0095, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0000, {0x5500, 0x0000, 0x0000, 0xaa80}, 0x0044, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0000, {0x7ffe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0000, {0xfffe, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0000, {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0814, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0000, {0x00fe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0000, {0xbbbc, 0x0000, 0x0000, 0x5678}, 0x0091, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x8000}, 0x0044, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x55ff, 0x0000, 0x0000, 0xaa00}, 0x0095, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557d, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x55fd, 0x0000, 0x0000, 0xaa01}, 0x0080, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557e, 0x0000, 0x0000, 0xaa01}, 0x0814, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x550d, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x55dd, 0x0000, 0x0000, 0xaa34}, 0x0095, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x18\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x55ff, 0x0000, 0x0000, 0xaa80}, 0x0095, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7ffd, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0xfffd, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7ffe, 0x0000, 0x0000, 0x0001}, 0x0810, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x00fd, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0xbbbb, 0x0000, 0x0000, 0x5678}, 0x0095, 0x08d5},
+        {"sbb ax, bx", CHECK_CODE("\x19\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0xffff, 0x0000, 0x0000, 0x8000}, 0x0095, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x1a\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x00dd, 0x0000, 0x0000, 0x0034}, 0x0095, 0x08d5},
+        {"sbb bh, cl", CHECK_CODE("\x1a\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0xdd00}, 0x0095, 0x08d5},
+        {"sbb dx, cx", CHECK_CODE("\x1b\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0xdddd, 0x0000}, 0x0095, 0x08d5},
+        {"sbb al, 0x34", CHECK_CODE("\x1c\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00dd, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sbb ax, 0x3434", CHECK_CODE("\x1d\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0xdddd, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sbb ch, 0x34", CHECK_CODE("\x80\xdd\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0xdd00, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sbb dx, 0x3434", CHECK_CODE("\x81\xda\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0xdddd, 0x0000}, 0x0095, 0x08d5},
+        {"sbb bx, -2", CHECK_CODE("\x83\xdb\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1213}, 0x0011, 0x08d5},
+        {"sbb al, bl", CHECK_CODE("\x1a\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0000, 0x0000, 0x0000, 0x007f}, 0x0854, 0x08d5},
+        {"sbb bh, cl", CHECK_CODE("\x1a\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0x0000}, 0x0854, 0x08d5},
+        {"sbb dx, cx", CHECK_CODE("\x1b\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0x0100, 0x0000}, 0x0814, 0x08d5},
+        {"sbb al, 0x7f", CHECK_CODE("\x1c\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0854, 0x08d5},
+        {"sbb ax, 0x7f7f", CHECK_CODE("\x1d\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0100, 0x0000, 0x0000, 0x0000}, 0x0814, 0x08d5},
+        {"sbb ch, 0x7f", CHECK_CODE("\x80\xdd\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0854, 0x08d5},
+        {"sbb dx, 0x7f7f", CHECK_CODE("\x81\xda\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0100, 0x0000}, 0x0814, 0x08d5},
+        {"sbb bx, -2", CHECK_CODE("\x83\xdb\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8081}, 0x0095, 0x08d5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa01}, 0x0044, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5501, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5510, 0x0000, 0x0000, 0xaa34}, 0x0000, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x20\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0080, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0001}, 0x0044, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x1230, 0x0000, 0x0000, 0x5678}, 0x0004, 0x08c5},
+        {"and ax, bx", CHECK_CODE("\x21\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x8000, 0x0000, 0x0000, 0x8000}, 0x0084, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x22\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0010, 0x0000, 0x0000, 0x0034}, 0x0000, 0x08c5},
+        {"and bh, cl", CHECK_CODE("\x22\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x1000}, 0x0000, 0x08c5},
+        {"and dx, cx", CHECK_CODE("\x23\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x1010, 0x0000}, 0x0000, 0x08c5},
+        {"and al, 0x34", CHECK_CODE("\x24\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0010, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"and ax, 0x3434", CHECK_CODE("\x25\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1010, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"and ch, 0x34", CHECK_CODE("\x80\xe5\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x1000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"and dx, 0x3434", CHECK_CODE("\x81\xe2\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x1010, 0x0000}, 0x0000, 0x08c5},
+        {"and bx, -2", CHECK_CODE("\x83\xe3\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1212}, 0x0004, 0x08c5},
+        {"and al, bl", CHECK_CODE("\x22\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0000, 0x0000, 0x0000, 0x007f}, 0x0044, 0x08c5},
+        {"and bh, cl", CHECK_CODE("\x22\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and dx, cx", CHECK_CODE("\x23\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and al, 0x7f", CHECK_CODE("\x24\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and ax, 0x7f7f", CHECK_CODE("\x25\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and ch, 0x7f", CHECK_CODE("\x80\xe5\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and dx, 0x7f7f", CHECK_CODE("\x81\xe2\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"and bx, -2", CHECK_CODE("\x83\xe3\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8080}, 0x0080, 0x08c5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557e, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x55fe, 0x0000, 0x0000, 0xaa01}, 0x0080, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0810, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x550e, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x55de, 0x0000, 0x0000, 0xaa34}, 0x0095, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x28\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa80}, 0x0044, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7ffe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0xfffe, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0814, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x00fe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0xbbbc, 0x0000, 0x0000, 0x5678}, 0x0091, 0x08d5},
+        {"sub ax, bx", CHECK_CODE("\x29\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8000}, 0x0044, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x2a\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x00de, 0x0000, 0x0000, 0x0034}, 0x0095, 0x08d5},
+        {"sub bh, cl", CHECK_CODE("\x2a\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0xde00}, 0x0095, 0x08d5},
+        {"sub dx, cx", CHECK_CODE("\x2b\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0xddde, 0x0000}, 0x0095, 0x08d5},
+        {"sub al, 0x34", CHECK_CODE("\x2c\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00de, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sub ax, 0x3434", CHECK_CODE("\x2d\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0xddde, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sub ch, 0x34", CHECK_CODE("\x80\xed\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0xde00, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"sub dx, 0x3434", CHECK_CODE("\x81\xea\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0xddde, 0x0000}, 0x0095, 0x08d5},
+        {"sub bx, -2", CHECK_CODE("\x83\xeb\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1214}, 0x0015, 0x08d5},
+        {"sub al, bl", CHECK_CODE("\x2a\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0001, 0x0000, 0x0000, 0x007f}, 0x0810, 0x08d5},
+        {"sub bh, cl", CHECK_CODE("\x2a\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0x0100}, 0x0810, 0x08d5},
+        {"sub dx, cx", CHECK_CODE("\x2b\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0x0101, 0x0000}, 0x0810, 0x08d5},
+        {"sub al, 0x7f", CHECK_CODE("\x2c\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"sub ax, 0x7f7f", CHECK_CODE("\x2d\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0101, 0x0000, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"sub ch, 0x7f", CHECK_CODE("\x80\xed\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"sub dx, 0x7f7f", CHECK_CODE("\x81\xea\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0101, 0x0000}, 0x0810, 0x08d5},
+        {"sub bx, -2", CHECK_CODE("\x83\xeb\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8082}, 0x0095, 0x08d5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557e, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x55fe, 0x0000, 0x0000, 0xaa01}, 0x0080, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5581, 0x0000, 0x0000, 0xaa01}, 0x0084, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x550e, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5526, 0x0000, 0x0000, 0xaa34}, 0x0000, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x30\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa80}, 0x0044, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7ffe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0xfffe, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8001, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x00fe, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x444c, 0x0000, 0x0000, 0x5678}, 0x0000, 0x08c5},
+        {"xor ax, bx", CHECK_CODE("\x31\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8000}, 0x0044, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x32\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0026, 0x0000, 0x0000, 0x0034}, 0x0000, 0x08c5},
+        {"xor bh, cl", CHECK_CODE("\x32\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x2600}, 0x0000, 0x08c5},
+        {"xor dx, cx", CHECK_CODE("\x33\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x2626, 0x0000}, 0x0000, 0x08c5},
+        {"xor al, 0x34", CHECK_CODE("\x34\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0026, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"xor ax, 0x3434", CHECK_CODE("\x35\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x2626, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"xor ch, 0x34", CHECK_CODE("\x80\xf5\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x2600, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"xor dx, 0x3434", CHECK_CODE("\x81\xf2\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x2626, 0x0000}, 0x0000, 0x08c5},
+        {"xor bx, -2", CHECK_CODE("\x83\xf3\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0xedec}, 0x0080, 0x08c5},
+        {"xor al, bl", CHECK_CODE("\x32\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x007f}, 0x0084, 0x08c5},
+        {"xor bh, cl", CHECK_CODE("\x32\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0xff00}, 0x0084, 0x08c5},
+        {"xor dx, cx", CHECK_CODE("\x33\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0xffff, 0x0000}, 0x0084, 0x08c5},
+        {"xor al, 0x7f", CHECK_CODE("\x34\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"xor ax, 0x7f7f", CHECK_CODE("\x35\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"xor ch, 0x7f", CHECK_CODE("\x80\xf5\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0xff00, 0x0000, 0x0000}, 0x0084, 0x08c5},
+        {"xor dx, 0x7f7f", CHECK_CODE("\x81\xf2\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0xffff, 0x0000}, 0x0084, 0x08c5},
+        {"xor bx, -2", CHECK_CODE("\x83\xf3\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x7f7e}, 0x0004, 0x08c5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0001, {0x5500, 0x0000, 0x0000, 0xaa00}, 0x0044, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x557f, 0x0000, 0x0000, 0xaa01}, 0x0004, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x55ff, 0x0000, 0x0000, 0xaa01}, 0x0080, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x5580, 0x0000, 0x0000, 0xaa01}, 0x0810, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0001, {0x550f, 0x0000, 0x0000, 0xaa01}, 0x0000, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0001, {0x5512, 0x0000, 0x0000, 0xaa34}, 0x0095, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x38\xd8"), {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0001, {0x5580, 0x0000, 0x0000, 0xaa80}, 0x0044, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x7fff, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0xffff, 0x0000, 0x0000, 0x0001}, 0x0001, {0xffff, 0x0000, 0x0000, 0x0001}, 0x0080, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x8000, 0x0000, 0x0000, 0x0001}, 0x0001, {0x8000, 0x0000, 0x0000, 0x0001}, 0x0814, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0001, {0x00ff, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0001, {0x1234, 0x0000, 0x0000, 0x5678}, 0x0091, 0x08d5},
+        {"cmp ax, bx", CHECK_CODE("\x39\xd8"), {0x8000, 0x0000, 0x0000, 0x8000}, 0x0001, {0x8000, 0x0000, 0x0000, 0x8000}, 0x0044, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x3a\xc3"), {0x0012, 0x0000, 0x0000, 0x0034}, 0x0001, {0x0012, 0x0000, 0x0000, 0x0034}, 0x0095, 0x08d5},
+        {"cmp bh, cl", CHECK_CODE("\x3a\xf9"), {0x0000, 0x0034, 0x0000, 0x1200}, 0x0001, {0x0000, 0x0034, 0x0000, 0x1200}, 0x0095, 0x08d5},
+        {"cmp dx, cx", CHECK_CODE("\x3b\xd1"), {0x0000, 0x3434, 0x1212, 0x0000}, 0x0001, {0x0000, 0x3434, 0x1212, 0x0000}, 0x0095, 0x08d5},
+        {"cmp al, 0x34", CHECK_CODE("\x3c\x34"), {0x0012, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0012, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"cmp ax, 0x3434", CHECK_CODE("\x3d\x34\x34"), {0x1212, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1212, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"cmp ch, 0x34", CHECK_CODE("\x80\xfd\x34"), {0x0000, 0x1200, 0x0000, 0x0000}, 0x0001, {0x0000, 0x1200, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"cmp dx, 0x3434", CHECK_CODE("\x81\xfa\x34\x34"), {0x0000, 0x0000, 0x1212, 0x0000}, 0x0001, {0x0000, 0x0000, 0x1212, 0x0000}, 0x0095, 0x08d5},
+        {"cmp bx, -2", CHECK_CODE("\x83\xfb\xfe"), {0x0000, 0x0000, 0x0000, 0x1212}, 0x0001, {0x0000, 0x0000, 0x0000, 0x1212}, 0x0015, 0x08d5},
+        {"cmp al, bl", CHECK_CODE("\x3a\xc3"), {0x0080, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0080, 0x0000, 0x0000, 0x007f}, 0x0810, 0x08d5},
+        {"cmp bh, cl", CHECK_CODE("\x3a\xf9"), {0x0000, 0x007f, 0x0000, 0x8000}, 0x0001, {0x0000, 0x007f, 0x0000, 0x8000}, 0x0810, 0x08d5},
+        {"cmp dx, cx", CHECK_CODE("\x3b\xd1"), {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0001, {0x0000, 0x7f7f, 0x8080, 0x0000}, 0x0810, 0x08d5},
+        {"cmp al, 0x7f", CHECK_CODE("\x3c\x7f"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"cmp ax, 0x7f7f", CHECK_CODE("\x3d\x7f\x7f"), {0x8080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x8080, 0x0000, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"cmp ch, 0x7f", CHECK_CODE("\x80\xfd\x7f"), {0x0000, 0x8000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x8000, 0x0000, 0x0000}, 0x0810, 0x08d5},
+        {"cmp dx, 0x7f7f", CHECK_CODE("\x81\xfa\x7f\x7f"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0001, {0x0000, 0x0000, 0x8080, 0x0000}, 0x0810, 0x08d5},
+        {"cmp bx, -2", CHECK_CODE("\x83\xfb\xfe"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8080}, 0x0095, 0x08d5},
+
+        // TEST, INC, DEC, NEG and NOT, INC and DEC leave the carry alone
+        {"test al, bl", CHECK_CODE("\x84\xd8"), {0x000f, 0x0000, 0x0000, 0x00f0}, 0x0001, {0x000f, 0x0000, 0x0000, 0x00f0}, 0x0044, 0x08c5},
+        {"test ax, 0x8001", CHECK_CODE("\xa9\x01\x80"), {0x0f0f, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0f0f, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"test dh, 0x81", CHECK_CODE("\xf6\xc6\x81"), {0x0000, 0x0000, 0x0f00, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0f00, 0x0000}, 0x0000, 0x08c5},
+        {"test al, bl", CHECK_CODE("\x84\xd8"), {0x0081, 0x0000, 0x0000, 0x0001}, 0x0001, {0x0081, 0x0000, 0x0000, 0x0001}, 0x0000, 0x08c5},
+        {"test ax, 0x8001", CHECK_CODE("\xa9\x01\x80"), {0x8181, 0x0000, 0x0000, 0x0000}, 0x0001, {0x8181, 0x0000, 0x0000, 0x0000}, 0x0080, 0x08c5},
+        {"test dh, 0x81", CHECK_CODE("\xf6\xc6\x81"), {0x0000, 0x0000, 0x8100, 0x0000}, 0x0001, {0x0000, 0x0000, 0x8100, 0x0000}, 0x0084, 0x08c5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x00ff}, 0x0094, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x00ff}, 0x0095, 0x08d5},
+        {"inc cx", CHECK_CODE("\x41"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0001, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"dec dx", CHECK_CODE("\x4a"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0xffff, 0x0000}, 0x0094, 0x08d5},
+        {"neg al", CHECK_CODE("\xf6\xd8"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"neg bx", CHECK_CODE("\xf7\xdb"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x08d5},
+        {"not cl", CHECK_CODE("\xf6\xd1"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0000, 0x00ff, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"not dx", CHECK_CODE("\xf7\xd2"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0xffff, 0x0000}, 0x0000, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x007f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0890, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x007f}, 0x0000, {0x0000, 0x0000, 0x0000, 0x007e}, 0x0004, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x007f, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0891, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x007f}, 0x0001, {0x0000, 0x0000, 0x0000, 0x007e}, 0x0005, 0x08d5},
+        {"inc cx", CHECK_CODE("\x41"), {0x0000, 0x7fff, 0x0000, 0x0000}, 0x0001, {0x0000, 0x8000, 0x0000, 0x0000}, 0x0895, 0x08d5},
+        {"dec dx", CHECK_CODE("\x4a"), {0x0000, 0x0000, 0x007f, 0x0000}, 0x0000, {0x0000, 0x0000, 0x007e, 0x0000}, 0x0004, 0x08d5},
+        {"neg al", CHECK_CODE("\xf6\xd8"), {0x007f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0081, 0x0000, 0x0000, 0x0000}, 0x0095, 0x08d5},
+        {"neg bx", CHECK_CODE("\xf7\xdb"), {0x0000, 0x0000, 0x0000, 0x7f7f}, 0x0000, {0x0000, 0x0000, 0x0000, 0x8081}, 0x0095, 0x08d5},
+        {"not cl", CHECK_CODE("\xf6\xd1"), {0x0000, 0x007f, 0x0000, 0x0000}, 0x08d5, {0x0000, 0x0080, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"not dx", CHECK_CODE("\xf7\xd2"), {0x0000, 0x0000, 0x7f7f, 0x0000}, 0x0000, {0x0000, 0x0000, 0x8080, 0x0000}, 0x0000, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0081, 0x0000, 0x0000, 0x0000}, 0x0084, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x0080}, 0x0000, {0x0000, 0x0000, 0x0000, 0x007f}, 0x0810, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0081, 0x0000, 0x0000, 0x0000}, 0x0085, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x0080}, 0x0001, {0x0000, 0x0000, 0x0000, 0x007f}, 0x0811, 0x08d5},
+        {"inc cx", CHECK_CODE("\x41"), {0x0000, 0x8080, 0x0000, 0x0000}, 0x0001, {0x0000, 0x8081, 0x0000, 0x0000}, 0x0085, 0x08d5},
+        {"dec dx", CHECK_CODE("\x4a"), {0x0000, 0x0000, 0x8000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x7fff, 0x0000}, 0x0814, 0x08d5},
+        {"neg al", CHECK_CODE("\xf6\xd8"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0881, 0x08d5},
+        {"neg bx", CHECK_CODE("\xf7\xdb"), {0x0000, 0x0000, 0x0000, 0x8080}, 0x0000, {0x0000, 0x0000, 0x0000, 0x7f80}, 0x0001, 0x08d5},
+        {"not cl", CHECK_CODE("\xf6\xd1"), {0x0000, 0x0080, 0x0000, 0x0000}, 0x08d5, {0x0000, 0x007f, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"not dx", CHECK_CODE("\xf7\xd2"), {0x0000, 0x0000, 0x8080, 0x0000}, 0x0000, {0x0000, 0x0000, 0x7f7f, 0x0000}, 0x0000, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0054, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x00ff}, 0x0000, {0x0000, 0x0000, 0x0000, 0x00fe}, 0x0080, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x00ff}, 0x0001, {0x0000, 0x0000, 0x0000, 0x00fe}, 0x0081, 0x08d5},
+        {"inc cx", CHECK_CODE("\x41"), {0x0000, 0xffff, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0055, 0x08d5},
+        {"dec dx", CHECK_CODE("\x4a"), {0x0000, 0x0000, 0x00ff, 0x0000}, 0x0000, {0x0000, 0x0000, 0x00fe, 0x0000}, 0x0000, 0x08d5},
+        {"neg al", CHECK_CODE("\xf6\xd8"), {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0011, 0x08d5},
+        {"neg bx", CHECK_CODE("\xf7\xdb"), {0x0000, 0x0000, 0x0000, 0xffff}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0001}, 0x0011, 0x08d5},
+        {"not cl", CHECK_CODE("\xf6\xd1"), {0x0000, 0x00ff, 0x0000, 0x0000}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"not dx", CHECK_CODE("\xf7\xd2"), {0x0000, 0x0000, 0xffff, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x000f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0010, 0x0000, 0x0000, 0x0000}, 0x0010, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x000f}, 0x0000, {0x0000, 0x0000, 0x0000, 0x000e}, 0x0000, 0x08d5},
+        {"inc al", CHECK_CODE("\xfe\xc0"), {0x000f, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0010, 0x0000, 0x0000, 0x0000}, 0x0011, 0x08d5},
+        {"dec bl", CHECK_CODE("\xfe\xcb"), {0x0000, 0x0000, 0x0000, 0x000f}, 0x0001, {0x0000, 0x0000, 0x0000, 0x000e}, 0x0001, 0x08d5},
+        {"inc cx", CHECK_CODE("\x41"), {0x0000, 0x0f0f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0f10, 0x0000, 0x0000}, 0x0011, 0x08d5},
+        {"dec dx", CHECK_CODE("\x4a"), {0x0000, 0x0000, 0x000f, 0x0000}, 0x0000, {0x0000, 0x0000, 0x000e, 0x0000}, 0x0000, 0x08d5},
+        {"neg al", CHECK_CODE("\xf6\xd8"), {0x000f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x00f1, 0x0000, 0x0000, 0x0000}, 0x0091, 0x08d5},
+        {"neg bx", CHECK_CODE("\xf7\xdb"), {0x0000, 0x0000, 0x0000, 0x0f0f}, 0x0000, {0x0000, 0x0000, 0x0000, 0xf0f1}, 0x0091, 0x08d5},
+        {"not cl", CHECK_CODE("\xf6\xd1"), {0x0000, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0000, 0x00f0, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"not dx", CHECK_CODE("\xf7\xd2"), {0x0000, 0x0000, 0x0f0f, 0x0000}, 0x0000, {0x0000, 0x0000, 0xf0f0, 0x0000}, 0x0000, 0x08d5},
+
+        // Shifts and rotates by 1 and by CL, counts past the operand width included for rotates
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0003, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0303}, 0x08d5, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0006, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x000c, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0003, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x1030, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d4, {0xc040, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x0103, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0003, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x0303}, 0x08d5, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0006, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x000c, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0003, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x1030, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d5, {0xc040, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x0103, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x2808, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x20a0, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x8280, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x2808, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x20a0, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x8280, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0202}, 0x00d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0004, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x0020, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x8000, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol al, 1", CHECK_CODE("\xd0\xc0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0002, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"rol bx, 1", CHECK_CODE("\xd1\xc3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x0202}, 0x00d4, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, 0x08d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0004, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"rol dl, cl", CHECK_CODE("\xd2\xc2"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x0020, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x8000, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rol ax, cl", CHECK_CODE("\xd3\xc0"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x0002, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x00c0, 0x0000, 0x0000, 0x0000}, 0x00d5, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d4, {0x0000, 0x0000, 0x0000, 0xc0c0}, 0x00d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0060, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0030, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0003, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x00c0, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0003, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x0c04, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x0103, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d4, {0xc040, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x00c0, 0x0000, 0x0000, 0x0000}, 0x00d5, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d5, {0x0000, 0x0000, 0x0000, 0xc0c0}, 0x00d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0060, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0030, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0003, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x00c0, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0003, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x0c04, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0103, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d5, {0xc040, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0020, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x2020}, 0x00d4, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0010, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x020a, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x8280, 0x000f, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x20a0, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0020, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x2020}, 0x00d4, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0010, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x020a, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x8280, 0x000f, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x20a0, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x0800, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x8000, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"ror al, 1", CHECK_CODE("\xd0\xc8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"ror bx, 1", CHECK_CODE("\xd1\xcb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, 0x08d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"ror dl, cl", CHECK_CODE("\xd2\xca"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x0800, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0002, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"ror ax, cl", CHECK_CODE("\xd3\xc8"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x8000, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0302}, 0x08d5, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0005, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x000a, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x00a0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0040, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0081, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0050, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x1028, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d4, {0xa020, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x4040, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0003, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x0303}, 0x08d5, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0007, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x000e, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x00e0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x00c0, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0070, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x1038, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d5, {0xe020, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d5, {0xc040, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0010, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0020, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x2804, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x1050, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x20a0, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x8081}, 0x08d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0002, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0005, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0050, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x00a0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0040, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0028, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x2814, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x5050, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d5, {0xa0a0, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0202}, 0x00d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0004, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x0020, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x8000, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x0000, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl al, 1", CHECK_CODE("\xd0\xd0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0003, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"rcl bx, 1", CHECK_CODE("\xd1\xd3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x0203}, 0x00d4, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0006, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x000c, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0080, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl dl, cl", CHECK_CODE("\xd2\xd2"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0060, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x0030, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d5, {0xc000, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x8000, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcl ax, cl", CHECK_CODE("\xd3\xd0"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x40c0}, 0x08d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x00a0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0050, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0005, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0002, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0081, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x000a, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x1404, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x0205, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x0102, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x8081, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x00c0, 0x0000, 0x0000, 0x0000}, 0x00d5, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x08d5, {0x0000, 0x0000, 0x0000, 0xc0c0}, 0x00d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0081, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x00e0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0070, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0007, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0003, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0081, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0081, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x000e, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x1c04, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0207, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x0103, 0x0010, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x8081, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x8081, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0020, 0x0000, 0x0000, 0x0000}, 0x00d4, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x2020}, 0x00d4, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0010, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x020a, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x0500, 0x000f, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x8280, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x4140, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x00a0, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x08d5, {0x0000, 0x0000, 0x0000, 0xa020}, 0x08d4, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0040, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x0050, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0028, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0002, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0081, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0040, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0040, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x0005, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x0a0a, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0502, 0x000f, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x8281, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x4140, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x4140, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0000}, 0x00d5, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d4, {0x0000, 0x0000, 0x0000, 0x0080}, 0x00d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0102, 0x0080, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0103, 0x0040, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0107, 0x0004, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0108, 0x0002, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x0109, 0x0001, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d4, {0x0000, 0x010f, 0x0008, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d4, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d4, {0x1000, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d4, {0x0004, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d4, {0x0002, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d4, {0x0001, 0x0011, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr al, 1", CHECK_CODE("\xd0\xd8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0080, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr bx, 1", CHECK_CODE("\xd1\xdb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x08d5, {0x0000, 0x0000, 0x0000, 0x8080}, 0x08d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0100, 0x0001, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0102, 0x00c0, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0103, 0x0060, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0107, 0x0006, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0108, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0108, 0x0003, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x0109, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x0109, 0x0001, 0x0000}, 0x00d5, 0x00d5},
+        {"rcr dl, cl", CHECK_CODE("\xd2\xda"), {0x0000, 0x010f, 0x0001, 0x0000}, 0x08d5, {0x0000, 0x010f, 0x000c, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0000, 0x0000, 0x0000}, 0x08d5, 0x08d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x08d5, {0x1800, 0x0005, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x08d5, {0x0006, 0x000f, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0010, 0x0000, 0x0000}, 0x08d5, {0x0003, 0x0010, 0x0000, 0x0000}, 0x00d4, 0x00d5},
+        {"rcr ax, cl", CHECK_CODE("\xd3\xd8"), {0x0001, 0x0011, 0x0000, 0x0000}, 0x08d5, {0x0001, 0x0011, 0x0000, 0x0000}, 0x00d5, 0x00d5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0002, 0x0000, 0x0000, 0x0000}, 0x0801, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0302}, 0x0801, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0004, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0080, 0x0000}, 0x0080, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0000, {0x1020, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0000, {0x8000, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0002, 0x0000, 0x0000, 0x0000}, 0x0801, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0302}, 0x0801, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0004, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0080, 0x0000}, 0x0080, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0001, {0x1020, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0001, {0x8000, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0880, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0000, {0x0000, 0x0000, 0x0000, 0x8080}, 0x0880, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0000, {0x2800, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0080, 0x0000, 0x0000, 0x0000}, 0x0880, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0001, {0x0000, 0x0000, 0x0000, 0x8080}, 0x0880, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0001, {0x2800, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0002, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0202}, 0x0000, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0004, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0080, 0x0000}, 0x0080, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0000, {0x0020, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0000, {0x8000, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"shl al, 1", CHECK_CODE("\xd0\xe0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0002, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"shl bx, 1", CHECK_CODE("\xd1\xe3"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0202}, 0x0000, 0x08c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, 0x08d5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0004, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shl dl, cl", CHECK_CODE("\xd2\xe2"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0080, 0x0000}, 0x0080, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0001, {0x0020, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shl ax, cl", CHECK_CODE("\xd3\xe0"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0001, {0x8000, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0040, 0x0000, 0x0000, 0x0000}, 0x0801, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0000, {0x0000, 0x0000, 0x0000, 0x40c0}, 0x0805, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0020, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0001, 0x0000}, 0x0000, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0000, {0x0404, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0001, 0x000f, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0040, 0x0000, 0x0000, 0x0000}, 0x0801, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0001, {0x0000, 0x0000, 0x0000, 0x40c0}, 0x0805, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0020, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0001, 0x0000}, 0x0000, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0001, {0x0404, 0x0005, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0001, 0x000f, 0x0000, 0x0000}, 0x0000, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0020, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0000, {0x0000, 0x0000, 0x0000, 0x2020}, 0x0000, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0000, {0x020a, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0020, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0001, {0x0000, 0x0000, 0x0000, 0x2020}, 0x0000, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0001, {0x020a, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0045, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0080}, 0x0001, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0005, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr al, 1", CHECK_CODE("\xd0\xe8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0045, 0x08c5},
+        {"shr bx, 1", CHECK_CODE("\xd1\xeb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0080}, 0x0001, 0x08c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, 0x08d5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr dl, cl", CHECK_CODE("\xd2\xea"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0005, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"shr ax, cl", CHECK_CODE("\xd3\xe8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x00c0, 0x0000, 0x0000, 0x0000}, 0x0085, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0000, {0x0000, 0x0000, 0x0000, 0xc0c0}, 0x0085, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0000, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0102, 0x00e0, 0x0000}, 0x0080, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0103, 0x00f0, 0x0000}, 0x0084, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0000, {0x0000, 0x0107, 0x00ff, 0x0000}, 0x0084, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0000, {0xfc04, 0x0005, 0x0000, 0x0000}, 0x0080, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0000, {0xffff, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x00c0, 0x0000, 0x0000, 0x0000}, 0x0085, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x8181}, 0x0001, {0x0000, 0x0000, 0x0000, 0xc0c0}, 0x0085, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0081, 0x0000}, 0x0001, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0102, 0x00e0, 0x0000}, 0x0080, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0103, 0x00f0, 0x0000}, 0x0084, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0081, 0x0000}, 0x0001, {0x0000, 0x0107, 0x00ff, 0x0000}, 0x0084, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, {0x8081, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x0005, 0x0000, 0x0000}, 0x0001, {0xfc04, 0x0005, 0x0000, 0x0000}, 0x0080, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x8081, 0x000f, 0x0000, 0x0000}, 0x0001, {0xffff, 0x000f, 0x0000, 0x0000}, 0x0084, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0020, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0000, {0x0000, 0x0000, 0x0000, 0x2020}, 0x0000, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0000, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0000, {0x020a, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0040, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0020, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x4040}, 0x0001, {0x0000, 0x0000, 0x0000, 0x2020}, 0x0000, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0040, 0x0000}, 0x0001, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0010, 0x0000}, 0x0000, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0008, 0x0000}, 0x0000, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0040, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, {0x4140, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x0005, 0x0000, 0x0000}, 0x0001, {0x020a, 0x0005, 0x0000, 0x0000}, 0x0004, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x4140, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0045, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0045, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0080}, 0x0001, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0000, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0000, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0005, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0000, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar al, 1", CHECK_CODE("\xd0\xf8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0045, 0x08c5},
+        {"sar bx, 1", CHECK_CODE("\xd1\xfb"), {0x0000, 0x0000, 0x0000, 0x0101}, 0x0001, {0x0000, 0x0000, 0x0000, 0x0080}, 0x0001, 0x08c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0100, 0x0001, 0x0000}, 0x0001, 0x08d5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0102, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0102, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0103, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0103, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar dl, cl", CHECK_CODE("\xd2\xfa"), {0x0000, 0x0107, 0x0001, 0x0000}, 0x0001, {0x0000, 0x0107, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, {0x0001, 0x0000, 0x0000, 0x0000}, 0x0001, 0x08d5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x0005, 0x0000, 0x0000}, 0x0001, {0x0000, 0x0005, 0x0000, 0x0000}, 0x0044, 0x00c5},
+        {"sar ax, cl", CHECK_CODE("\xd3\xf8"), {0x0001, 0x000f, 0x0000, 0x0000}, 0x0001, {0x0000, 0x000f, 0x0000, 0x0000}, 0x0044, 0x00c5},
+
+        // Multiply and divide, only CF and OF are defined after a multiply and nothing after a divide
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x3310, 0x0000, 0x0000, 0x0010}, 0x0000, {0x0100, 0x0000, 0x0000, 0x0010}, 0x0801, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x3310, 0x0000, 0x0000, 0x0010}, 0x0000, {0x0100, 0x0000, 0x0000, 0x0010}, 0x0801, 0x0801},
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x33ff, 0x0000, 0x0000, 0x00ff}, 0x0000, {0xfe01, 0x0000, 0x0000, 0x00ff}, 0x0801, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x33ff, 0x0000, 0x0000, 0x00ff}, 0x0000, {0x0001, 0x0000, 0x0000, 0x00ff}, 0x0000, 0x0801},
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x3380, 0x0000, 0x0000, 0x0002}, 0x0000, {0x0100, 0x0000, 0x0000, 0x0002}, 0x0801, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x3380, 0x0000, 0x0000, 0x0002}, 0x0000, {0xff00, 0x0000, 0x0000, 0x0002}, 0x0801, 0x0801},
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x337f, 0x0000, 0x0000, 0x0002}, 0x0000, {0x00fe, 0x0000, 0x0000, 0x0002}, 0x0000, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x337f, 0x0000, 0x0000, 0x0002}, 0x0000, {0x00fe, 0x0000, 0x0000, 0x0002}, 0x0801, 0x0801},
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x3340, 0x0000, 0x0000, 0x00fe}, 0x0000, {0x3f80, 0x0000, 0x0000, 0x00fe}, 0x0801, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x3340, 0x0000, 0x0000, 0x00fe}, 0x0000, {0xff80, 0x0000, 0x0000, 0x00fe}, 0x0000, 0x0801},
+        {"mul bl", CHECK_CODE("\xf6\xe3"), {0x3303, 0x0000, 0x0000, 0x0005}, 0x0000, {0x000f, 0x0000, 0x0000, 0x0005}, 0x0000, 0x0801},
+        {"imul bl", CHECK_CODE("\xf6\xeb"), {0x3303, 0x0000, 0x0000, 0x0005}, 0x0000, {0x000f, 0x0000, 0x0000, 0x0005}, 0x0000, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0x1000, 0x0010, 0x5555, 0x0000}, 0x0000, {0x0000, 0x0010, 0x0001, 0x0000}, 0x0801, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0x1000, 0x0010, 0x5555, 0x0000}, 0x0000, {0x0000, 0x0010, 0x0001, 0x0000}, 0x0801, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0xffff, 0xffff, 0x5555, 0x0000}, 0x0000, {0x0001, 0xffff, 0xfffe, 0x0000}, 0x0801, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0xffff, 0xffff, 0x5555, 0x0000}, 0x0000, {0x0001, 0xffff, 0x0000, 0x0000}, 0x0000, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0x8000, 0x0002, 0x5555, 0x0000}, 0x0000, {0x0000, 0x0002, 0x0001, 0x0000}, 0x0801, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0x8000, 0x0002, 0x5555, 0x0000}, 0x0000, {0x0000, 0x0002, 0xffff, 0x0000}, 0x0801, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0x7fff, 0x0002, 0x5555, 0x0000}, 0x0000, {0xfffe, 0x0002, 0x0000, 0x0000}, 0x0000, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0x7fff, 0x0002, 0x5555, 0x0000}, 0x0000, {0xfffe, 0x0002, 0x0000, 0x0000}, 0x0801, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0x4000, 0xfffe, 0x5555, 0x0000}, 0x0000, {0x8000, 0xfffe, 0x3fff, 0x0000}, 0x0801, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0x4000, 0xfffe, 0x5555, 0x0000}, 0x0000, {0x8000, 0xfffe, 0xffff, 0x0000}, 0x0000, 0x0801},
+        {"mul cx", CHECK_CODE("\xf7\xe1"), {0x0003, 0x0005, 0x5555, 0x0000}, 0x0000, {0x000f, 0x0005, 0x0000, 0x0000}, 0x0000, 0x0801},
+        {"imul cx", CHECK_CODE("\xf7\xe9"), {0x0003, 0x0005, 0x5555, 0x0000}, 0x0000, {0x000f, 0x0005, 0x0000, 0x0000}, 0x0000, 0x0801},
+        {"div bl", CHECK_CODE("\xf6\xf3"), {0x1234, 0x0000, 0x0000, 0x0056}, 0x0000, {0x1036, 0x0000, 0x0000, 0x0056}, 0x0000, 0x0000},
+        {"div bl", CHECK_CODE("\xf6\xf3"), {0x00ff, 0x0000, 0x0000, 0x0010}, 0x0000, {0x0f0f, 0x0000, 0x0000, 0x0010}, 0x0000, 0x0000},
+        {"div bl", CHECK_CODE("\xf6\xf3"), {0x0007, 0x0000, 0x0000, 0x0007}, 0x0000, {0x0001, 0x0000, 0x0000, 0x0007}, 0x0000, 0x0000},
+        {"div bl", CHECK_CODE("\xf6\xf3"), {0x0100, 0x0000, 0x0000, 0x0002}, 0x0000, {0x0080, 0x0000, 0x0000, 0x0002}, 0x0000, 0x0000},
+        {"idiv bl", CHECK_CODE("\xf6\xfb"), {0xff00, 0x0000, 0x0000, 0x0010}, 0x0000, {0x00f0, 0x0000, 0x0000, 0x0010}, 0x0000, 0x0000},
+        {"idiv bl", CHECK_CODE("\xf6\xfb"), {0x0064, 0x0000, 0x0000, 0x00f9}, 0x0000, {0x02f2, 0x0000, 0x0000, 0x00f9}, 0x0000, 0x0000},
+        {"idiv bl", CHECK_CODE("\xf6\xfb"), {0xff9c, 0x0000, 0x0000, 0x00f9}, 0x0000, {0xfe0e, 0x0000, 0x0000, 0x00f9}, 0x0000, 0x0000},
+        {"idiv bl", CHECK_CODE("\xf6\xfb"), {0x0007, 0x0000, 0x0000, 0x00fe}, 0x0000, {0x01fd, 0x0000, 0x0000, 0x00fe}, 0x0000, 0x0000},
+        {"div cx", CHECK_CODE("\xf7\xf1"), {0x2345, 0x0100, 0x0001, 0x0000}, 0x0000, {0x0123, 0x0100, 0x0045, 0x0000}, 0x0000, 0x0000},
+        {"div cx", CHECK_CODE("\xf7\xf1"), {0xffff, 0x0010, 0x0000, 0x0000}, 0x0000, {0x0fff, 0x0010, 0x000f, 0x0000}, 0x0000, 0x0000},
+        {"div cx", CHECK_CODE("\xf7\xf1"), {0x5678, 0x9abc, 0x1234, 0x0000}, 0x0000, {0x1e1e, 0x9abc, 0x2c70, 0x0000}, 0x0000, 0x0000},
+        {"idiv cx", CHECK_CODE("\xf7\xf9"), {0xff00, 0x0010, 0xffff, 0x0000}, 0x0000, {0xfff0, 0x0010, 0x0000, 0x0000}, 0x0000, 0x0000},
+        {"idiv cx", CHECK_CODE("\xf7\xf9"), {0x0064, 0xfff9, 0x0000, 0x0000}, 0x0000, {0xfff2, 0xfff9, 0x0002, 0x0000}, 0x0000, 0x0000},
+        {"idiv cx", CHECK_CODE("\xf7\xf9"), {0xff9c, 0xfff9, 0xffff, 0x0000}, 0x0000, {0x000e, 0xfff9, 0xfffe, 0x0000}, 0x0000, 0x0000},
+
+        // Decimal adjust, sign extension and exchange
+        {"daa", CHECK_CODE("\x27"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0044, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0044, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0005, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0085, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1206, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0010, {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1266, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1200, 0x0000, 0x0000, 0x0000}, 0x0011, {0x129a, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1209, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1209, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1269, 0x0000, 0x0000, 0x0000}, 0x0005, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12a9, 0x0000, 0x0000, 0x0000}, 0x0085, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0010, {0x120f, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1203, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0011, {0x126f, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1209, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12a3, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1210, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1204, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1270, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12a4, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1210, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1204, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1270, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120a, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12a4, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1215, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1209, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1275, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12a9, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1215, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1209, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1275, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x120f, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12a9, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1219, 0x0000, 0x0000, 0x0000}, 0x0000, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1219, 0x0000, 0x0000, 0x0000}, 0x0000, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1279, 0x0000, 0x0000, 0x0000}, 0x0001, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12b9, 0x0000, 0x0000, 0x0000}, 0x0081, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0010, {0x121f, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1213, 0x0000, 0x0000, 0x0000}, 0x0010, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0011, {0x127f, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1219, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12b3, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1247, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1247, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12a7, 0x0000, 0x0000, 0x0000}, 0x0081, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12e7, 0x0000, 0x0000, 0x0000}, 0x0085, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0010, {0x124d, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1241, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12ad, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1247, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12e1, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0084, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0084, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12f9, 0x0000, 0x0000, 0x0000}, 0x0085, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1239, 0x0000, 0x0000, 0x0000}, 0x0005, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0010, {0x129f, 0x0000, 0x0000, 0x0000}, 0x0094, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1293, 0x0000, 0x0000, 0x0000}, 0x0094, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1299, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1233, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0055, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1234, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0055, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1234, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0055, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1234, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0055, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x129a, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1234, 0x0000, 0x0000, 0x0000}, 0x0011, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0045, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1240, 0x0000, 0x0000, 0x0000}, 0x0001, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0045, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1240, 0x0000, 0x0000, 0x0000}, 0x0001, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1206, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0010, {0x123a, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1206, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12a0, 0x0000, 0x0000, 0x0000}, 0x0011, {0x123a, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1294, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1294, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1294, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1294, 0x0000, 0x0000, 0x0000}, 0x0091, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1265, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1265, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1265, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1265, 0x0000, 0x0000, 0x0000}, 0x0015, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x12ff, 0x0000, 0x0000, 0x0000}, 0x0011, {0x1299, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1260, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0001, {0x12c0, 0x0000, 0x0000, 0x0000}, 0x0085, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0001, {0x1200, 0x0000, 0x0000, 0x0000}, 0x0045, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0010, {0x1266, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0010, {0x125a, 0x0000, 0x0000, 0x0000}, 0x0014, 0x00d5},
+        {"daa", CHECK_CODE("\x27"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12c6, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"das", CHECK_CODE("\x2f"), {0x1260, 0x0000, 0x0000, 0x0000}, 0x0011, {0x12fa, 0x0000, 0x0000, 0x0000}, 0x0095, 0x00d5},
+        {"aaa", CHECK_CODE("\x37"), {0x0300, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0300, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0300, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0406, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0309, 0x0000, 0x0000, 0x0000}, 0x0010, {0x040f, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x030a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0400, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x030a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0400, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x030f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0405, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x030f, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0405, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x031b, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0401, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x031b, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0401, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0339, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0339, 0x0000, 0x0000, 0x0000}, 0x0010, {0x040f, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x037a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0400, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x037a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0400, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0308, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0308, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aaa", CHECK_CODE("\x37"), {0x0308, 0x0000, 0x0000, 0x0000}, 0x0010, {0x040e, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0306, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0306, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0306, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0200, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0309, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0203, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x030a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0204, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x030a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0204, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x030f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0209, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x030f, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0209, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x031b, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0205, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x031b, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0205, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0339, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0309, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0339, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0203, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x037a, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0204, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x037a, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0204, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0308, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0308, 0x0000, 0x0000, 0x0000}, 0x0000, 0x0011},
+        {"aas", CHECK_CODE("\x3f"), {0x0308, 0x0000, 0x0000, 0x0000}, 0x0010, {0x0202, 0x0000, 0x0000, 0x0000}, 0x0011, 0x0011},
+        {"aam", CHECK_CODE("\xd4\x0a"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x00c4},
+        {"aad", CHECK_CODE("\xd5\x0a"), {0x0000, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0000, 0x0000, 0x0000, 0x0000}, 0x0044, 0x00c4},
+        {"aam", CHECK_CODE("\xd4\x0a"), {0x0063, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0909, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00c4},
+        {"aad", CHECK_CODE("\xd5\x0a"), {0x0063, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0063, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00c4},
+        {"aam", CHECK_CODE("\xd4\x0a"), {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x1905, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00c4},
+        {"aad", CHECK_CODE("\xd5\x0a"), {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0000, {0x00ff, 0x0000, 0x0000, 0x0000}, 0x0084, 0x00c4},
+        {"aam", CHECK_CODE("\xd4\x0a"), {0x0105, 0x0000, 0x0000, 0x0000}, 0x0000, {0x0005, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00c4},
+        {"aad", CHECK_CODE("\xd5\x0a"), {0x0105, 0x0000, 0x0000, 0x0000}, 0x0000, {0x000f, 0x0000, 0x0000, 0x0000}, 0x0004, 0x00c4},
+        {"cbw", CHECK_CODE("\x98"), {0x0080, 0x0000, 0x0000, 0x0000}, 0x0000, {0xff80, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"cwd", CHECK_CODE("\x99"), {0x8080, 0x0000, 0x1234, 0x0000}, 0x0000, {0x8080, 0x0000, 0xffff, 0x0000}, 0x0000, 0x08d5},
+        {"cbw", CHECK_CODE("\x98"), {0x007f, 0x0000, 0x0000, 0x0000}, 0x0000, {0x007f, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"cwd", CHECK_CODE("\x99"), {0x7f7f, 0x0000, 0x1234, 0x0000}, 0x0000, {0x7f7f, 0x0000, 0x0000, 0x0000}, 0x0000, 0x08d5},
+        {"xchg bh, al", CHECK_CODE("\x86\xc7"), {0x1234, 0x0000, 0x0000, 0x5678}, 0x0000, {0x1256, 0x0000, 0x0000, 0x3478}, 0x0000, 0x08d5},
+        {"xchg cl, dh", CHECK_CODE("\x86\xf1"), {0x0000, 0x1234, 0x5678, 0x0000}, 0x0000, {0x0000, 0x1256, 0x3478, 0x0000}, 0x0000, 0x08d5},
+        {"xchg cx, dx", CHECK_CODE("\x87\xd1"), {0x0000, 0x1234, 0x5678, 0x0000}, 0x0000, {0x0000, 0x5678, 0x1234, 0x0000}, 0x0000, 0x08d5},
+};
+
+const size_t check_vector_count = sizeof(check_vectors) / sizeof(check_vectors[0]);
\ No newline at end of file
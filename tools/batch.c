@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cpu/cpu.h>
+#include <cpu/opcodes.h>
+#include <runner/runner.h>
+
+/*
+    Job list, one job per line, numbers in hex:
+        image-path cs ip ss sp steps
+    Blank lines and lines starting with # are skipped.
+
+    With -g every worker gets a GDB stub, worker n on unix:path.n or on the TCP port plus n.
+    Jobs don't wait for a debugger, one that attaches stops whichever job its worker is on.
+ */
+
+static uint8_t *batch_read_file(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t *data = length > 0 ? malloc(length) : NULL;
+    if (data && fread(data, 1, length, file) != (size_t) length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+
+    *size = data ? length : 0;
+    return data;
+}
+
+static int batch_parse(FILE *in, struct runner_job **jobs, size_t *count) {
+    char line[1024], path[768];
+    size_t capacity = 0;
+
+    *jobs = NULL;
+    *count = 0;
+
+    for (size_t number = 1; fgets(line, sizeof(line), in); number++) {
+        unsigned cs, ip, ss, sp;
+        unsigned long long steps;
+        char *start = line + strspn(line, " \t");
+
+        if (*start == '#' || *start == '\n' || *start == 0) continue;
+        if (sscanf(start, "%767s %x %x %x %x %llx", path, &cs, &ip, &ss, &sp, &steps) != 6) {
+            fprintf(stderr, "[!] Malformed job on line %zu\n", number);
+            return -1;
+        }
+
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            *jobs = realloc(*jobs, capacity * sizeof(struct runner_job));
+            if (!*jobs) return -1;
+        }
+
+        struct runner_job *job = &(*jobs)[(*count)++];
+        job->image = batch_read_file(path, &job->image_size);
+        if (!job->image) {
+            fprintf(stderr, "[!] Can't read %s\n", path);
+            return -1;
+        }
+        job->cs = cs;
+        job->ip = ip;
+        job->ss = ss;
+        job->sp = sp;
+        job->steps = steps;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *debugger = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:g:")) != -1) {
+        if (opt == 'j') threads = strtol(optarg, NULL, 0);
+        else if (opt == 'g') debugger = optarg;
+        else {
+            fprintf(stderr, "usage: %s [-j threads] [-g unix:path|tcp:port] jobs.txt\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *in = optind < argc ? fopen(argv[optind], "r") : stdin;
+    if (!in) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    struct runner_job *jobs;
+    size_t count;
+    if (batch_parse(in, &jobs, &count) < 0) return 1;
+    if (in != stdin) fclose(in);
+
+    struct runner_result *results = calloc(count ? count : 1, sizeof(struct runner_result));
+    if (!results || runner_run_debug(jobs, results, count, threads > 0 ? threads : 1, debugger) < 0) {
+        fprintf(stderr, "[!] Failed to start the runner\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        struct runner_result *result = &results[i];
+        printf("%zu %s AX=%04x BX=%04x CX=%04x DX=%04x SP=%04x BP=%04x SI=%04x DI=%04x CS=%04x IP=%04x FLAGS=%04x\n",
+               i, result->halted ? "halted" : "budget",
+               result->reg.ax, result->reg.bx,
+               result->reg.cx, result->reg.dx,
+               result->reg.sp, result->reg.bp, result->reg.si, result->reg.di,
+               result->reg.cs, result->reg.ip, result->flags);
+    }
+
+    for (size_t i = 0; i < count; i++) free((void *) jobs[i].image);
+    free(jobs);
+    free(results);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <cpu/cpu.h>
+#include <cpu/opcodes.h>
+#include <cpu/trace.h>
+
+// Turns a binary ring buffer dump back into readable text
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s trace.bin\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    struct trace_header header;
+    if (fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC))) {
+        fprintf(stderr, "%s: not a trace dump\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+
+    if (header.version != TRACE_VERSION || header.record_size != sizeof(struct trace_record)) {
+        fprintf(stderr, "%s: unsupported trace version %u\n", argv[1], header.version);
+        fclose(in);
+        return 1;
+    }
+
+    struct trace_record record;
+    for (uint64_t i = 0; i < header.count && fread(&record, sizeof(record), 1, in) == 1; i++) {
+        printf("%04x:%04x %02x %-24s AX=%04x BX=%04x CX=%04x DX=%04x SP=%04x BP=%04x SI=%04x DI=%04x DS=%04x ES=%04x SS=%04x FLAGS=%04x\n",
+               record.cs, record.ip, record.opcode, opcodes[record.opcode].name,
+               record.ax, record.bx, record.cx, record.dx, record.sp, record.bp, record.si, record.di,
+               record.ds, record.es, record.ss, record.flags);
+    }
+
+    fclose(in);
+    return 0;
+}
\ No newline at end of file